@@ -0,0 +1,130 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ABSTRACT_SOT_EXTERNAL_INTERFACE_V2_HH
+#define ABSTRACT_SOT_EXTERNAL_INTERFACE_V2_HH
+
+#include <vector>
+#include <map>
+#include <string>
+#include <Eigen/Core>
+#include <sot/core/api.hh>
+#include <sot/core/abstract-sot-external-interface.hh>
+
+namespace dynamicgraph {
+  namespace sot {
+
+    /// Named blocks of values stored in one contiguous array.
+    ///
+    /// The blocks are added at setup, and identified afterwards by the
+    /// integer handle returned by add (or found once by name). Adding a
+    /// block may move the array: the views returned by get must be taken
+    /// after the setup.
+    class SOT_CORE_EXPORT ExchangeBuffer
+    {
+    public:
+      typedef int Handle;
+      typedef Eigen::Map<Eigen::VectorXd> View;
+      typedef Eigen::Map<const Eigen::VectorXd> ConstView;
+
+      ExchangeBuffer() {}
+
+      /// Add a block of size values, initialized to 0. Adding a name twice
+      /// returns the handle of the first block, whose size must match.
+      Handle add(const std::string & name, const std::size_t & size);
+      /// Handle of the block name, or -1.
+      Handle find(const std::string & name) const;
+      void clear();
+
+      std::size_t getNbBlocks() const { return names_.size(); }
+      const std::string & getName(const Handle & h) const { return names_[h]; }
+      std::size_t getSize(const Handle & h) const { return sizes_[h]; }
+
+      View get(const Handle & h)
+      { return View(&values_[offsets_[h]], sizes_[h]); }
+      ConstView get(const Handle & h) const
+      { return ConstView(&values_[offsets_[h]], sizes_[h]); }
+
+      /// All the values, block after block.
+      double * data() { return values_.empty() ? NULL : &values_[0]; }
+      const double * data() const { return values_.empty() ? NULL : &values_[0]; }
+      std::size_t size() const { return values_.size(); }
+
+      /// \name Conversions from and to the map-based interface.
+      /// Entries of the map without a block are ignored.
+      /// \{
+      void fromMap(const std::map<std::string,NamedVector> & in);
+      void toMap(std::map<std::string,NamedVector> & out) const;
+      /// \}
+
+    private:
+      std::vector<std::string> names_;
+      std::vector<std::size_t> offsets_;
+      std::vector<std::size_t> sizes_;
+      std::vector<double> values_;
+    };
+
+    /// External interface exchanging the values through ExchangeBuffer.
+    ///
+    /// The controller declares its sensors and controls once, in
+    /// registerSensorsAndControls. The robot side then looks up the handles
+    /// of the blocks it fills or reads, and exchanges the values at each
+    /// cycle without any string or allocation.
+    ///
+    /// The map-based methods of AbstractSotExternalInterface are
+    /// implemented on top of the buffers, for the robots using them.
+    class SOT_CORE_EXPORT AbstractSotExternalInterfaceV2
+      : public AbstractSotExternalInterface
+    {
+    public:
+
+      AbstractSotExternalInterfaceV2() : registered_(false) {}
+
+      virtual ~AbstractSotExternalInterfaceV2(){}
+
+      /// Add the blocks of the sensors read and of the controls written by
+      /// the controller. Called once, before the first cycle.
+      virtual void registerSensorsAndControls(ExchangeBuffer & sensors,
+                                              ExchangeBuffer & controls)=0;
+
+      virtual void setupSetSensors(const ExchangeBuffer & sensors)=0;
+
+      virtual void nominalSetSensors(const ExchangeBuffer & sensors)=0;
+
+      virtual void cleanupSetSensors(const ExchangeBuffer & sensors)=0;
+
+      virtual void getControl(ExchangeBuffer & controls)=0;
+
+      /// \name Map-based interface.
+      /// The values are copied through buffers registered on first use.
+      /// \{
+      virtual void setupSetSensors(std::map<std::string,SensorValues> &sensorsIn);
+      virtual void nominalSetSensors(std::map<std::string,SensorValues> &sensorsIn);
+      virtual void cleanupSetSensors(std::map<std::string,SensorValues> &sensorsIn);
+      virtual void getControl(std::map<std::string,ControlValues> &controlOut);
+      /// \}
+
+    private:
+      void registerBuffers();
+
+      bool registered_;
+      ExchangeBuffer sensors_;
+      ExchangeBuffer controls_;
+    };
+  }
+}
+
+#endif
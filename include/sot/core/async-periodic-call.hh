@@ -0,0 +1,164 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SOT_ASYNC_PERIODICCALL_HH__
+#define __SOT_ASYNC_PERIODICCALL_HH__
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+/* SOT */
+#include <dynamic-graph/linear-algebra.h>
+#include <dynamic-graph/signal.h>
+#include <dynamic-graph/entity.h>
+#include <sot/core/api.hh>
+#include <sot/core/periodic-call.hh>
+/* BOOST */
+#include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/thread.hpp>
+/* STD */
+#include <string>
+#include <vector>
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+namespace dynamicgraph {
+namespace sot {
+
+/*!
+  \class AsyncPeriodicCall
+  \brief Periodic call evaluated by a background thread.
+
+  At each post, the control thread copies the values of the source signals
+  given to addSnapshot into a snapshot, and hands it over to a background
+  thread. The background thread writes the snapshot into the snapshot
+  signals, then runs the periodic call (see getCalls) at the time of the
+  snapshot. The signals of the periodic call (tracers, monitoring) should
+  only depend on the snapshot signals: the rest of the graph is being
+  evaluated by the control thread at the same time.
+
+  Two snapshots are stored: the one being processed, and the next one.
+  post never blocks: when the next snapshot is still waiting because the
+  background thread is late, or when the background thread is swapping the
+  snapshots, the sample is dropped and counted.
+
+  The background thread is launched by start, outside of the ticks: post
+  does nothing while it is stopped, or when there is nothing to copy nor
+  to call. addSnapshot stops the thread while the snapshots are resized,
+  then starts it again; so do the methods changing the periodic call,
+  which is read by the thread without the lock. The list of sources, the
+  running state and the counters are only accessed under the lock; post
+  only tries the lock, and counts the samples it misses when it fails.
+*/
+class SOT_CORE_EXPORT AsyncPeriodicCall
+{
+ public:
+  typedef dynamicgraph::Signal<dynamicgraph::Vector,int> VectorSignal;
+
+  AsyncPeriodicCall( void );
+  virtual ~AsyncPeriodicCall( void );
+
+  /// Add a signal copying the value of source at each post.
+  VectorSignal& addSnapshot( VectorSignal& source,const std::string& signalName );
+  /// Periodic call run by the background thread. Change it through the
+  /// methods below, or while the thread is stopped.
+  PeriodicCall& getCalls( void ) { return calls; }
+
+  /// \name Changes of the periodic call, with the thread stopped.
+  /// \{
+  void addSignal( const std::string& name,dynamicgraph::SignalBase<int>& sig );
+  void addSignal( const std::string& sigpath );
+  void addDownsampledSignal( const std::string& sigpath,
+			     const unsigned int& downsamplingFactor );
+  void rmSignal( const std::string& name );
+  void clear( void );
+  void setPhase( const std::string& name,const unsigned int& phase );
+  void setAutoStagger( const bool& stagger );
+  void freeze( void );
+  void unfreeze( void );
+  void resetStats( void );
+  /// \}
+
+  /// Take a snapshot at the given time, if the background thread can
+  /// accept it. Called by the control thread.
+  void post( const int& time );
+  /// Launch the background thread, if there is something to copy or to
+  /// call.
+  void start( void );
+  void stop( void );
+  bool isRunning( void ) const;
+
+  unsigned int getPostedCount( void ) const;
+  unsigned int getDroppedCount( void ) const;
+  unsigned int getProcessedCount( void ) const;
+  void resetCounters( void );
+
+  void display( std::ostream& os ) const;
+  void addSpecificCommands( dynamicgraph::Entity& ent,
+			    dynamicgraph::Entity::CommandMap_t& commap,
+			    const std::string & prefix = "" );
+
+ protected:
+  struct Snapshot
+  {
+    std::vector<dynamicgraph::Vector> values;
+    int time;
+  };
+
+  void workerLoop( void );
+  /* Stop the thread, apply the change, then start the thread again. */
+  void changeCalls( const boost::function< void( void ) >& change );
+
+  std::vector<VectorSignal*> sources;
+  std::vector<VectorSignal*> snapshotSignals;
+  PeriodicCall calls;
+
+  /* The background thread reads snapshots[processing] without the lock;
+   * the control thread writes the other one, under the lock. */
+  Snapshot snapshots[2];
+  int processing;
+  int next;
+  bool nextReady;
+
+  mutable boost::mutex mutex;
+  boost::condition_variable cond;
+  boost::thread* thread;
+  bool stopping;
+  bool running;
+
+  /* Counters, under the lock. */
+  unsigned int posted,dropped,processed;
+  /* Samples missed because the lock was busy, counted by the control
+   * thread alone and added to the counters at the next post. */
+  unsigned int missed;
+};
+
+} // namespace sot
+} // namespace dynamicgraph
+
+
+#endif // #ifndef __SOT_ASYNC_PERIODICCALL_HH__
+
+/*
+ * Local variables:
+ * c-basic-offset: 2
+ * End:
+ */
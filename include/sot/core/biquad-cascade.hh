@@ -0,0 +1,105 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SOT_BIQUAD_CASCADE_H__
+#define __SOT_BIQUAD_CASCADE_H__
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+#include <sot/core/config.hh>
+#include <dynamic-graph/entity.h>
+#include <dynamic-graph/linear-algebra.h>
+#include <dynamic-graph/signal-ptr.h>
+#include <dynamic-graph/signal-time-dependent.h>
+
+namespace dg = ::dynamicgraph;
+
+namespace dynamicgraph {
+  namespace sot {
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+using dynamicgraph::Entity;
+using dynamicgraph::SignalPtr;
+using dynamicgraph::SignalTimeDependent;
+
+/*!
+  \class BiquadCascade
+  \brief IIR filter made of second order sections, applied to each
+  component of a vector.
+
+  The sections are given as the rows [ b0 b1 b2 a0 a1 a2 ] of a matrix
+  (as scipy's sos), each section computing
+  y = ( b0 x + b1 x^-1 + b2 x^-2 - a1 y^-1 - a2 y^-2 ) / a0.
+  They are evaluated in transposed direct form II; the two states of a
+  section are stored as one array per state, over the channels, so that
+  each step is a vectorized operation on all the channels.
+
+  At the first sample (and after reset), the states are set to the steady
+  state of a constant input, to avoid the transient from zero.
+*/
+class SOT_CORE_DLLAPI BiquadCascade
+: public Entity
+{
+  DYNAMIC_GRAPH_ENTITY_DECL();
+ public:
+
+  SignalPtr< dg::Vector,int > SIN;
+  SignalTimeDependent< dg::Vector,int > SOUT;
+
+ public:
+  BiquadCascade( const std::string& n );
+  virtual ~BiquadCascade( void );
+
+  /// Load the sections, rows [ b0 b1 b2 a0 a1 a2 ].
+  void setSos( const dg::Matrix& sos );
+  const dg::Matrix& getSos( void ) const { return sos; }
+  void setButterworthLowPass( const int& order,const double& cutoff,
+                              const double& samplingPeriod );
+  void setButterworthHighPass( const int& order,const double& cutoff,
+                               const double& samplingPeriod );
+  void reset( void );
+
+  /// Sections of a Butterworth filter of the given order and cutoff
+  /// frequency (Hz), discretized by the bilinear transform with the
+  /// cutoff prewarped.
+  static dg::Matrix butterworthLowPass( const int& order,const double& cutoff,
+                                        const double& samplingPeriod );
+  static dg::Matrix butterworthHighPass( const int& order,const double& cutoff,
+                                         const double& samplingPeriod );
+
+ protected:
+
+  dg::Vector& compute( dg::Vector& res,const int& time );
+  void initializeStates( const dg::Vector& in );
+
+  /* Normalized coefficients (a0=1), one row per section. */
+  dg::Matrix sos;
+  /* Column s: state of the section s, one row per channel. */
+  Eigen::ArrayXXd z1,z2;
+  Eigen::ArrayXd y;
+  bool init;
+
+};
+
+  } /* namespace sot */
+} /* namespace dynamicgraph */
+
+#endif /* #ifndef __SOT_BIQUAD_CASCADE_H__ */
@@ -31,6 +31,7 @@ namespace dg = dynamicgraph;
 #include <dynamic-graph/entity.h>
 #include <dynamic-graph/all-signals.h>
 #include "sot/core/periodic-call.hh"
+#include "sot/core/async-periodic-call.hh"
 #include <sot/core/matrix-geometry.hh>
 #include "sot/core/api.hh"
 
@@ -51,6 +52,32 @@ namespace dynamicgraph {
       "noInteg", "oneInteg", "twoInteg"
     };
 
+    /// Define the integration scheme of the second order control input.
+    ///
+    /// The control is constant over a time step: the joint positions are
+    /// integrated exactly by all the schemes, except the semi-implicit Euler
+    /// one. The schemes differ on the free flyer, whose velocity is a body
+    /// twist varying over the step:
+    /// - euler: one exponential of the mean twist (midpoint, order 2),
+    /// - semiImplicitEuler: velocity first, then the position with the new
+    ///   velocity (order 1),
+    /// - rk2: Lie group Heun scheme, two exponentials (order 2),
+    /// - rk4: commutator-free Lie group scheme at the Gauss points, two
+    ///   exponentials (order 4).
+    enum Integrator
+    {
+      INTEGRATOR_EULER=0,
+      INTEGRATOR_SEMI_IMPLICIT_EULER=1,
+      INTEGRATOR_RK2=2,
+      INTEGRATOR_RK4=3,
+      INTEGRATOR_SIZE=4
+    };
+
+    const std::string Integrator_s[] =
+    {
+      "euler", "semiImplicitEuler", "rk2", "rk4"
+    };
+
     /* --------------------------------------------------------------------- */
     /* --- CLASS ----------------------------------------------------------- */
     /* --------------------------------------------------------------------- */
@@ -78,9 +105,14 @@ namespace dynamicgraph {
       bool sanityCheck_;
       dg::Vector vel_control_;
       ControlInput controlInputType_;
+      Integrator integrator_;
       bool withForceSignals[4];
       PeriodicCall periodicCallBefore_;
       PeriodicCall periodicCallAfter_;
+      /// Signals evaluated in the background from snapshots (logging).
+      AsyncPeriodicCall periodicCallAsync_;
+      /// Flat evaluation order of the graph upstream of controlSIN.
+      GraphSchedule controlSchedule_;
       double timestep_;
       
       /// \name Robot bounds used for sanity checks
@@ -92,6 +124,17 @@ namespace dynamicgraph {
       Vector lowerVelocity_;
       Vector lowerTorque_;
       /// \}
+
+      /// \name Real-time mode
+      /// In real-time mode, a tick does not allocate memory and does not
+      /// write to the log: the bound violations and the NaN controls are
+      /// only counted, per DoF, and read by the boundViolations command.
+      /// \{
+      bool realTime_;
+      Eigen::VectorXi positionViolations_;
+      Eigen::VectorXi velocityViolations_;
+      unsigned int nanControls_;
+      /// \}
     public:
 
       /* --- CONSTRUCTION --- */
@@ -106,8 +149,18 @@ namespace dynamicgraph {
       virtual void setSecondOrderIntegration();
       virtual void setNoIntegration();
       virtual void setControlInputType(const std::string& cit);
+      void setIntegrator(const std::string& integrator);
       virtual void increment(const double & dt = 5e-2);
 
+      /// Evaluate the graph from flat schedules (see GraphSchedule): the
+      /// control and the periodic calls.
+      void freeze();
+      void unfreeze();
+
+      /// Add an output signal receiving at each tick, in the background
+      /// thread of the asynchronous lane, the value of the signal sigpath.
+      void addSnapshot(const std::string& sigpath, const std::string& name);
+
       /// \name Sanity check parameterization
       /// \{
       void setSanityCheck   (const bool & enableCheck);
@@ -116,6 +169,13 @@ namespace dynamicgraph {
       void setTorqueBounds  (const Vector& lower, const Vector& upper);
       /// \}
 
+      /// \name Real-time mode
+      /// \{
+      void setRealTime(const bool & realTime);
+      void displayBoundViolations(std::ostream& os);
+      void resetBoundViolations();
+      /// \}
+
     public: /* --- DISPLAY --- */
       virtual void display(std::ostream& os) const;
       SOT_CORE_EXPORT friend std::ostream&
@@ -161,6 +221,12 @@ namespace dynamicgraph {
       /// Compute roll pitch yaw angles of freeflyer joint.
       void integrateRollPitchYaw(dg::Vector& state, const dg::Vector& control,
                                  double dt);
+      /// Integrate the free flyer with two successive body twists, each one
+      /// during dt.
+      void integrateRollPitchYaw(dg::Vector& state,
+                                 const Eigen::Matrix<double,6,1>& first,
+                                 const Eigen::Matrix<double,6,1>& second,
+                                 double dt);
       /// Store Position of free flyer joint
       MatrixHomogeneous ffPose_;
       /// Compute the new position, from the current control.
@@ -176,6 +242,14 @@ namespace dynamicgraph {
       ///                 pinocchio and the contact forces in order to estimate
       ///                 the joint torques for the given acceleration.
       virtual void integrate( const double & dt );
+      /// Saturate val within [lower,upper], and count the saturated DoFs in
+      /// violations. Return the number of saturated DoFs.
+      Vector::Index checkBounds(Vector& val, const Vector& lower,
+                                const Vector& upper, Eigen::VectorXi& violations,
+                                const char* what);
+      /// Run calls, logging the exceptions instead of propagating them.
+      void runPeriodicCall(PeriodicCall& calls, const int& time,
+                           const char* which);
     protected:
       /// Get freeflyer pose
       const MatrixHomogeneous& freeFlyerPose() const;
@@ -187,6 +261,7 @@ namespace dynamicgraph {
     private:
       // Intermediate variable to avoid dynamic allocation
       dg::Vector forceZero6;
+      dg::Vector zmpZero3;
     };
   } // namespace sot
 } // namespace dynamicgraph
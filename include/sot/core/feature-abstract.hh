@@ -31,6 +31,7 @@ namespace dg = dynamicgraph;
 
 /* SOT */
 #include <sot/core/flags.hh>
+#include <sot/core/selection-jacobian.hh>
 #include <dynamic-graph/all-signals.h>
 #include <dynamic-graph/entity.h>
 #include <sot/core/pool.hh>
@@ -146,6 +147,18 @@ namespace dynamicgraph {
       /// flag selectionSIN.
       virtual dg::Vector& computeErrorDot (dg::Vector& res,int time);
 
+      /// Callback for signal jacobianSelectionSOUT
+      ///
+      /// Features whose Jacobian is a scaled selection of the robot
+      /// degrees of freedom override this method and withSelectionJacobian.
+      /// The default implementation throws.
+      virtual SelectionJacobian&
+	computeJacobianSelection( SelectionJacobian& res,int time );
+
+      /// Return true for children that provide the jacobianSelection
+      /// output signal.
+      virtual bool withSelectionJacobian( void ) const { return false; }
+
       /*! @} */
 
       /* --- SIGNALS ------------------------------------------------------------ */
@@ -182,6 +195,10 @@ namespace dynamicgraph {
 	according to the robot state: \f$ J(t) = \frac{\delta{\bf s}^*(t)}{\delta {\bf q}(t)}\f$ */
       SignalTimeDependent<dg::Matrix,int> jacobianSOUT;
 
+      /*! \brief Sparse form of jacobianSOUT, only valid when
+	withSelectionJacobian returns true. */
+      SignalTimeDependent<SelectionJacobian,int> jacobianSelectionSOUT;
+
       /*! \brief Returns the dimension of the feature as an output signal. */
       SignalTimeDependent<unsigned int,int> dimensionSOUT;
 
@@ -200,6 +217,56 @@ namespace dynamicgraph {
 
       /*! @} */
 
+      /*! \name Fused evaluation.
+	A feature may compute its error and its Jacobian in a single pass,
+	sharing the reading of the inputs and the geometric computations. It
+	then overrides computeAll and calls enableComputeAll in its
+	constructor: the callbacks of errorSOUT, jacobianSOUT and errordotSOUT
+	copy their part of the shared result, which is computed once per time.
+	The time derivative of the error is only added to the shared result
+	once errordotSOUT has been read.
+	@{ */
+    protected:
+      typedef boost::function2<dg::Vector&,dg::Vector&,int> ErrorDotFunction;
+
+      /*! \brief Fill errorAll, jacobianAll and, if errordotAllRequested,
+	errordotAll, and set the corresponding flag for each part that could
+	be computed.
+	A feature only computes the parts whose inputs are plugged. A part
+	left unavailable is evaluated by computeError, computeJacobian or the
+	errordot callback when its signal is accessed, which also reports the
+	failure. The default implementation computes nothing. */
+      virtual void computeAll( int time );
+      /*! \brief Bind errorSOUT, jacobianSOUT and errordotSOUT to the shared
+	result. errordot evaluates errordotSOUT alone, computeErrorDot by
+	default. */
+      void enableComputeAll( void );
+      void enableComputeAll( const ErrorDotFunction& errordot );
+
+      dg::Vector errorAll;
+      dg::Matrix jacobianAll;
+      dg::Vector errordotAll;
+      bool errorAllAvailable,jacobianAllAvailable,errordotAllAvailable;
+      /// True once errordotSOUT has been read.
+      bool errordotAllRequested;
+
+    private:
+      enum SharedOutput
+	{ SHARED_ERROR = 1, SHARED_JACOBIAN = 2, SHARED_ERRORDOT = 4 };
+      /* Time of the last call to computeAll, and outputs read since. An
+	 output read twice at the same time has been forced to recompute
+	 (e.g. after a change of the inputs): the shared result is then
+	 recomputed too. */
+      int computeAllTime;
+      int computeAllConsumed;
+      void updateAll( int time,SharedOutput output );
+      dg::Vector& errorFromAll( dg::Vector& res,int time );
+      dg::Matrix& jacobianFromAll( dg::Matrix& res,int time );
+      dg::Vector& errordotFromAll( dg::Vector& res,int time );
+      ErrorDotFunction errordotAlone;
+    public:
+      /*! @} */
+
       /* --- REFERENCE VALUE S* ------------------------------------------------- */
     public:
 
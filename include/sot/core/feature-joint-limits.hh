@@ -82,6 +82,7 @@ class SOTFEATUREJOINTLIMITS_EXPORT FeatureJointLimits
   using FeatureAbstract::selectionSIN;
 
   using FeatureAbstract::jacobianSOUT;
+  using FeatureAbstract::jacobianSelectionSOUT;
   using FeatureAbstract::errorSOUT;
 
   /*! \name Dealing with the reference value to be reach with this feature.
@@ -98,6 +99,9 @@ class SOTFEATUREJOINTLIMITS_EXPORT FeatureJointLimits
 
   virtual dg::Vector& computeError( dg::Vector& res,int time );
   virtual dg::Matrix& computeJacobian( dg::Matrix& res,int time );
+  virtual SelectionJacobian&
+    computeJacobianSelection( SelectionJacobian& res,int time );
+  virtual bool withSelectionJacobian( void ) const { return true; }
   dg::Vector& computeWidthJl( dg::Vector& res,const int& time );
 
   /** Static Feature selection. */
@@ -102,6 +102,17 @@ class SOTFEATUREPOINT6DRELATIVE_EXPORT FeaturePoint6dRelative
   void initCommands( void );
   void initSdes( const std::string& featureDesiredName );
 
+ protected:
+  virtual void computeAll( int time );
+  void computeRelativePlacement( MatrixHomogeneous& pMpref,int time );
+  void errorFromPlacement( const MatrixHomogeneous& pMpref,
+			   dg::Vector& error,int time );
+  void jacobianFromPlacement( const MatrixHomogeneous& pMpref,
+			      dg::Matrix& J,int time );
+
+ private:
+  MatrixHomogeneous pMpref_;
+  dg::Matrix J_;
 } ;
 
 } /* namespace sot */} /* namespace dynamicgraph */
@@ -129,6 +129,22 @@ class SOTFEATUREPOINT6D_EXPORT FeaturePoint6d
   Eigen::Matrix3d P_, Pinv_;
   double accuracy_;
   void inverseJacobianRodrigues ();
+  MatrixHomogeneous hMhd_;
+  dg::Matrix LJq_;
+
+ protected:
+  virtual void computeAll( int time );
+  /** Placement of the reference in the computation frame. */
+  void computeRelativePosition( MatrixHomogeneous& hMhd,int time );
+  void errorFromRelativePosition( const MatrixHomogeneous& hMhd,
+				  dg::Vector& error,int time );
+  void jacobianFromRelativePosition( const MatrixHomogeneous& hMhd,
+				     dg::Matrix& J,int time );
+  /** Time derivative of the error, from the rotation error of the same
+      time. */
+  void errordotFromError( dg::Vector& errordot,int time );
+  /** True if the inputs of errordotFromError are plugged. */
+  bool errordotPlugged( void );
 } ;
 
 } /* namespace sot */} /* namespace dynamicgraph */
@@ -78,6 +78,9 @@ namespace dynamicgraph {
 
       virtual dg::Vector& computeError( dg::Vector& res, int );
       virtual dg::Matrix& computeJacobian( dg::Matrix& res, int );
+      virtual SelectionJacobian&
+	computeJacobianSelection( SelectionJacobian& res, int );
+      virtual bool withSelectionJacobian( void ) const { return true; }
       virtual dg::Vector& computeActivation( dg::Vector& res, int );
       virtual dg::Vector& computeErrorDot (dg::Vector& res,int time);
 
@@ -85,7 +88,7 @@ namespace dynamicgraph {
       signalIn_t posture_;
       signalIn_t postureDot_;
       signalOut_t error_;
-      dg::Matrix jacobian_;
+      SelectionJacobian jacobian_;
     private:
       std::vector <bool> activeDofs_;
       std::size_t nbActiveDofs_;
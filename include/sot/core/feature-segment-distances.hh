@@ -0,0 +1,137 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SOT_FEATURE_SEGMENTDISTANCES_HH__
+#define __SOT_FEATURE_SEGMENTDISTANCES_HH__
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+/* STD */
+#include <vector>
+
+/* SOT */
+#include <sot/core/feature-abstract.hh>
+#include <sot/core/exception-task.hh>
+
+/* --------------------------------------------------------------------- */
+/* --- API ------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+#if defined (WIN32)
+#  if defined (feature_segment_distances_EXPORTS)
+#    define SOTFEATURESEGMENTDISTANCES_EXPORT __declspec(dllexport)
+#  else
+#    define SOTFEATURESEGMENTDISTANCES_EXPORT __declspec(dllimport)
+#  endif
+#else
+#  define SOTFEATURESEGMENTDISTANCES_EXPORT
+#endif
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+namespace dynamicgraph { namespace sot {
+namespace dg = dynamicgraph;
+
+/*!
+  \class FeatureSegmentDistances
+  \brief Distances between P pairs of segments (capsule axes), for
+  collision avoidance.
+
+  Pair k is described by row k of the P x 12 matrix segmentsSIN: the two
+  endpoints of segment A followed by the two endpoints of segment B, in
+  the world frame. Storing one coordinate per column keeps each coordinate
+  contiguous over the pairs, so that all the closest-point computations are
+  vectorized over the pairs.
+
+  Rows 12k to 12k+5 (resp. 12k+6 to 12k+11) of jacobiansSIN contain the
+  6 x n Jacobian (linear velocity first) of a frame placed at the first
+  endpoint of segment A (resp. B), with axes aligned with the world frame.
+
+  Only the pairs selected by selectionSIN (one flag per pair) and closer
+  than activationDistanceSIN produce a row of the error and of the Jacobian.
+  The indices of these pairs are published in activeSOUT, so that the
+  bounds of an inequality task can be matched with the rows.
+*/
+class SOTFEATURESEGMENTDISTANCES_EXPORT FeatureSegmentDistances
+: public FeatureAbstract
+{
+
+ public:
+  static const std::string CLASS_NAME;
+  virtual const std::string& getClassName( void ) const { return CLASS_NAME; }
+
+ protected:
+  /* Work memory, sized with the number of pairs. */
+  dg::Matrix d1,d2,r;
+  dg::Matrix closestA,closestB,normals;
+  Eigen::ArrayXd a,b,c,e,f,s,t;
+  /* Indices of the pairs in the danger zone. */
+  std::vector<dg::Matrix::Index> activePairs;
+
+  /* --- SIGNALS ------------------------------------------------------------ */
+ public:
+  dg::SignalPtr< dg::Matrix,int > segmentsSIN;
+  /** Sum of the radii of the two capsules of each pair (optional). */
+  dg::SignalPtr< dg::Vector,int > radiiSIN;
+  dg::SignalPtr< dg::Matrix,int > jacobiansSIN;
+  /** Pairs farther than this distance are not considered. */
+  dg::SignalPtr< double,int > activationDistanceSIN;
+
+  /** Distance of all the pairs. */
+  dg::SignalTimeDependent<dg::Vector,int> distancesSOUT;
+  /** Indices of the pairs producing a row of the feature. */
+  dg::SignalTimeDependent<dg::Vector,int> activeSOUT;
+
+  using FeatureAbstract::selectionSIN;
+  using FeatureAbstract::jacobianSOUT;
+  using FeatureAbstract::errorSOUT;
+
+  /*! \name Dealing with the reference value to be reach with this feature.
+    @{
+  */
+  DECLARE_NO_REFERENCE;
+  /*! @} */
+
+
+ public:
+  FeatureSegmentDistances( const std::string& name );
+  virtual ~FeatureSegmentDistances( void ) {}
+
+  virtual unsigned int& getDimension( unsigned int & dim, int time );
+
+  virtual dg::Vector& computeError( dg::Vector& res,int time );
+  virtual dg::Matrix& computeJacobian( dg::Matrix& res,int time );
+  dg::Vector& computeDistances( dg::Vector& res,int time );
+  dg::Vector& computeActiveSet( dg::Vector& res,int time );
+
+  virtual void display( std::ostream& os ) const;
+
+} ;
+
+
+} /* namespace sot */} /* namespace dynamicgraph */
+
+#endif // #ifndef __SOT_FEATURE_SEGMENTDISTANCES_HH__
+
+/*
+ * Local variables:
+ * c-basic-offset: 2
+ * End:
+ */
@@ -89,6 +89,12 @@ class SOTFEATUREVECTOR3_EXPORT FeatureVector3
 
   virtual void display( std::ostream& os ) const;
 
+ protected:
+  virtual void computeAll( int time );
+  static void jacobianFromRotation( const MatrixRotation& R,
+				    const dg::Vector& vect,
+				    const dg::Matrix& Jq,dg::Matrix& J );
+
 } ;
 
 } /* namespace sot */} /* namespace dynamicgraph */
@@ -96,6 +96,13 @@ class SOTFEATUREVISUALPOINT_EXPORT FeatureVisualPoint
 
   virtual void display( std::ostream& os ) const;
 
+ protected:
+  virtual void computeAll( int time );
+  /** Fill L with the interaction matrix of the selected coordinates. */
+  void computeInteractionMatrix( const Flags& fl,const unsigned int dim,
+				 const dg::Vector& xy,const double& Z );
+  static void errorFromPoints( const Flags& fl,const dg::Vector& xy,
+			       const dg::Vector& xyDes,dg::Vector& error );
 
 } ;
 
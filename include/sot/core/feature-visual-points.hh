@@ -0,0 +1,112 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SOT_FEATURE_VISUALPOINTS_HH__
+#define __SOT_FEATURE_VISUALPOINTS_HH__
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+/* SOT */
+#include <sot/core/feature-abstract.hh>
+#include <sot/core/exception-task.hh>
+
+/* --------------------------------------------------------------------- */
+/* --- API ------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+#if defined (WIN32)
+#  if defined (feature_visual_points_EXPORTS)
+#    define SOTFEATUREVISUALPOINTS_EXPORT __declspec(dllexport)
+#  else
+#    define SOTFEATUREVISUALPOINTS_EXPORT __declspec(dllimport)
+#  endif
+#else
+#  define SOTFEATUREVISUALPOINTS_EXPORT
+#endif
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+namespace dynamicgraph { namespace sot {
+namespace dg = dynamicgraph;
+
+/*!
+  \class FeatureVisualPoints
+  \brief Class that defines a set of N 2D visual points.
+
+  The points are given as the rows of a N x 2 matrix, with their depths in
+  a vector of size N. The stacked 2N x 6 interaction matrix is built at
+  once and multiplied by the articular Jacobian a single time. The rows of
+  the error and of the Jacobian are ordered x0,y0,x1,y1,... The selection
+  flags act per point: bit i selects both coordinates of point i.
+*/
+class SOTFEATUREVISUALPOINTS_EXPORT FeatureVisualPoints
+  : public FeatureAbstract, public FeatureReferenceHelper<FeatureVisualPoints>
+{
+
+ public:
+  static const std::string CLASS_NAME;
+  virtual const std::string& getClassName( void ) const { return CLASS_NAME; }
+
+ protected:
+  /** Interaction matrix of all the points. */
+  dg::Matrix L;
+  /** Interaction matrix restricted to the selected points. */
+  dg::Matrix Lselec;
+
+  /* --- SIGNALS ------------------------------------------------------------ */
+ public:
+  /** Coordinates of the points, one point per row. */
+  dg::SignalPtr< dg::Matrix,int > xySIN;
+  /** Depth of the points (required to compute the interaction matrix). */
+  dg::SignalPtr< dg::Vector,int > ZSIN;
+  dg::SignalPtr< dg::Matrix,int > articularJacobianSIN;
+
+  using FeatureAbstract::selectionSIN;
+  using FeatureAbstract::jacobianSOUT;
+  using FeatureAbstract::errorSOUT;
+
+  DECLARE_REFERENCE_FUNCTIONS(FeatureVisualPoints);
+
+ public:
+  FeatureVisualPoints( const std::string& name );
+  virtual ~FeatureVisualPoints( void ) {}
+
+  virtual unsigned int& getDimension( unsigned int & dim, int time );
+
+  virtual dg::Vector& computeError( dg::Vector& res,int time );
+  virtual dg::Matrix& computeJacobian( dg::Matrix& res,int time );
+
+  virtual void display( std::ostream& os ) const;
+
+ protected:
+  /** Fill L with the interaction matrix of all the points. */
+  void computeInteractionMatrix( const dg::Matrix& xy,const dg::Vector& Z );
+
+} ;
+
+} /* namespace sot */} /* namespace dynamicgraph */
+
+#endif // #ifndef __SOT_FEATURE_VISUALPOINTS_HH__
+
+/*
+ * Local variables:
+ * c-basic-offset: 2
+ * End:
+ */
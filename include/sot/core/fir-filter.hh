@@ -32,6 +32,8 @@
 #include <dynamic-graph/command-setter.h>
 #include <dynamic-graph/command-getter.h>
 
+#include <sot/core/multi-channel-fir.hh>
+
 namespace dg = dynamicgraph;
 
 namespace dynamicgraph {
@@ -233,8 +235,26 @@ namespace dynamicgraph {
     private:
       std::vector<coefT> coefs;
       detail::circular_buffer<sigT> data;
+      /* Channel-major history and coefficients, used by FIRFilter<Vector,double>
+       * instead of data. */
+      MultiChannelFIR channelMajor;
     }; // class FIRFilter
 
+    /* Specializations defined with the plugin. */
+    template<>
+    Vector& FIRFilter<Vector, double>::compute( Vector& res,int time );
+    template<>
+    void FIRFilter<Vector, double>::resizeBuffer( const unsigned int& size );
+    template<>
+    void FIRFilter<Vector, double>::setElement( const unsigned int& rank,
+                                                const double& coef );
+    template<>
+    void FIRFilter<Vector, double>::reset_signal( Vector& res,
+                                                  const Vector& sample );
+    template<>
+    void FIRFilter<Vector, Matrix>::reset_signal( Vector& res,
+                                                  const Vector& sample );
+
     namespace command {
       using ::dynamicgraph::command::Command;
       using ::dynamicgraph::command::Value;
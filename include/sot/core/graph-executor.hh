@@ -0,0 +1,172 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SOT_GRAPH_EXECUTOR_HH__
+#define __SOT_GRAPH_EXECUTOR_HH__
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+/* SOT */
+#include <dynamic-graph/entity.h>
+#include <sot/core/api.hh>
+#include <sot/core/graph-schedule.hh>
+/* BOOST */
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/thread.hpp>
+/* STD */
+#include <deque>
+#include <string>
+#include <vector>
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+namespace dynamicgraph {
+  namespace sot {
+
+    /*!
+      \class GraphExecutor
+      \brief Parallel evaluation of the independent branches of the graph
+      upstream of a set of roots.
+
+      The graph is sorted by a GraphSchedule, then partitioned into tasks:
+      the signals of one entity always belong to the same task, since they
+      share the members of the entity (work memory, fused evaluations).
+      Entities depending on each other in both directions are merged into
+      one task. Within a task, the active signals of the schedule are
+      evaluated in order, each only if it needs an update; a task starts
+      once all the tasks it depends on are done. A signal read by several
+      other tasks is evaluated by its own task even if it is not active, so
+      that the tasks reading it do not run its update test concurrently.
+      The first tick after start is left to the pull, which selects the
+      active signals.
+
+      The tasks are run by a pool of workers, each owning a queue of ready
+      tasks: a worker takes the last task it queued, and steals the oldest
+      task of another worker when its own queue is empty. The thread calling
+      run works as the first worker, and returns when all the tasks are
+      done: the caller (typically the Sot) then pulls the roots, which are
+      up to date.
+
+      Only the dependencies declared to the signals are known: a callback
+      reading a signal that is not in its dependency list may run
+      concurrently with the evaluation of this signal. The deterministic
+      mode recomputes the signals serially in the order of the schedule, in
+      the calling thread.
+    */
+    class SOT_CORE_EXPORT GraphExecutor
+    {
+    public:
+      typedef GraphSchedule::SignalType SignalType;
+
+      GraphExecutor( void );
+      ~GraphExecutor( void );
+
+      void addRoot( SignalType& sig ) { schedule.addRoot( sig ); }
+      void clearRoots( void ) { schedule.clearRoots(); }
+
+      /// Sort and partition the graph, and launch the workers.
+      void start( void );
+      /// Stop the workers. run does nothing until the next start.
+      void stop( void );
+      bool isStarted( void ) const { return started; }
+
+      /// Number of workers, including the thread calling run.
+      void setWorkerCount( const unsigned int& nb );
+      unsigned int getWorkerCount( void ) const { return workerCount; }
+      /// CPU of each worker, as a list of integers ("0 2 4"). Worker k is
+      /// pinned on cpus[k-1 modulo the size of the list]; the thread
+      /// calling run keeps its own affinity. An empty list does not pin
+      /// the workers.
+      void setAffinity( const std::string& list );
+      void setDeterministic( const bool& deterministic );
+      bool isDeterministic( void ) const { return deterministic; }
+
+      /// Recompute the graph at the given time, and wait for the end.
+      void run( const int& time );
+
+      std::size_t getTaskCount( void ) const { return tasks.size(); }
+
+      void display( std::ostream& os ) const;
+      void addSpecificCommands( dynamicgraph::Entity& ent,
+				dynamicgraph::Entity::CommandMap_t& commap,
+				const std::string& prefix = "" );
+
+    protected:
+      struct Task
+      {
+	/* Indices of the signals in the schedule, in increasing order. */
+	std::vector<std::size_t> signals;
+	std::vector<std::size_t> successors;
+	unsigned int nbPredecessors;
+      };
+
+      /* Queue of the ready tasks of a worker. */
+      struct WorkerQueue
+      {
+	boost::mutex mutex;
+	std::deque<std::size_t> tasks;
+      };
+
+      void partition( void );
+      void launchWorkers( void );
+      void joinWorkers( void );
+
+      void workerLoop( const unsigned int id,unsigned int seen );
+      void work( const unsigned int id );
+      bool popTask( const unsigned int id,std::size_t& task );
+      void pushTask( const unsigned int id,const std::size_t task );
+      void execute( const std::size_t task );
+
+      GraphSchedule schedule;
+      std::vector<Task> tasks;
+      unsigned int partitionCount;
+
+      unsigned int workerCount;
+      std::vector<int> cpus;
+      bool deterministic;
+      bool started;
+
+      /* Worker threads (all but the calling thread) and their queues. */
+      std::vector<boost::thread*> threads;
+      std::vector<WorkerQueue*> queues;
+
+      /* State of the current run, protected by stateMutex. */
+      boost::mutex stateMutex;
+      boost::condition_variable stateCond;
+      std::vector<unsigned int> pending;
+      std::size_t remaining;
+      std::size_t queued;
+      unsigned int generation;
+      bool stopping;
+      int runTime;
+    };
+
+  } // namespace sot
+} // namespace dynamicgraph
+
+
+#endif // #ifndef __SOT_GRAPH_EXECUTOR_HH__
+
+/*
+ * Local variables:
+ * c-basic-offset: 2
+ * End:
+ */
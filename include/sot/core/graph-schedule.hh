@@ -0,0 +1,213 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SOT_GRAPH_SCHEDULE_HH__
+#define __SOT_GRAPH_SCHEDULE_HH__
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+/* SOT */
+#include <dynamic-graph/signal-base.h>
+#include <dynamic-graph/time-dependency.h>
+#include <sot/core/api.hh>
+/* STD */
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <vector>
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+namespace dynamicgraph {
+  namespace sot {
+
+    /*!
+      \class GraphSchedule
+      \brief Flat evaluation order of the signals reachable from a set of
+      roots.
+
+      freeze walks the dependency lists of the time-dependent signals and
+      the plugs of the input signals once, and stores the time-dependent
+      signals in a topological order (dependencies first). The roots are
+      not part of the schedule.
+
+      The schedule only anticipates the evaluations of the usual pull from
+      the roots, and does not evaluate more. The first tick after freeze
+      is a plain pull; the signals it evaluated (their time reached the
+      time of the tick) are the active signals. The next ticks evaluate the
+      active signals in order, then the roots, each one only if it needs an
+      update. The update test is the one of the signal (ready flag, period
+      and children), except that an active child is only compared by its
+      time: it was evaluated earlier in the same tick, so that the test
+      does not recurse into the graph anymore. A dependency that the
+      callbacks do not read, such as a time derivative of an error, is thus
+      not evaluated. A signal that a callback starts reading later is still
+      evaluated by the pull of its reader, but is scheduled only after the
+      next freeze.
+
+      The caller then reads the roots with accessCopy. A signal failing
+      during run is marked ready, so that its reader evaluates it again and
+      reports the error if it is really needed.
+
+      The structure of the graph (plugs and dependency lists) is recorded
+      at freeze, and checked every checkPeriod ticks (DEFAULT_CHECK_PERIOD
+      by default): the schedule is rebuilt, and the active signals learnt
+      again, when the topology changed. Between two checks, a new
+      dependency is still read by the callbacks, but the update tests do
+      not see it; invalidate forces the check at the next tick.
+    */
+    class SOT_CORE_EXPORT GraphSchedule
+    {
+    public:
+      typedef dynamicgraph::SignalBase<int> SignalType;
+      typedef dynamicgraph::TimeDependency<int> DependencyType;
+
+      GraphSchedule( void );
+
+      void addRoot( SignalType& sig );
+      void clearRoots( void );
+
+      /// Sort the signals reachable from the roots.
+      void freeze( void );
+      void unfreeze( void );
+      bool isFrozen( void ) const { return frozen; }
+
+      /// Return false if a plug or a dependency list changed since freeze.
+      bool checkTopology( void ) const;
+
+      /// Rebuild the schedule if the topology changed. Return true if it
+      /// was rebuilt.
+      bool update( void );
+
+      static const unsigned int DEFAULT_CHECK_PERIOD = 100;
+      /// Check the topology every period ticks.
+      void setCheckPeriod( const unsigned int& period );
+      unsigned int getCheckPeriod( void ) const { return checkPeriod; }
+      /// Check the topology at the next tick.
+      void invalidate( void ) { ticksToCheck = 0; }
+
+      /// Rebuild the schedule if the topology changed (when it is checked
+      /// at this tick), and record the active signals after the learning
+      /// tick. Return true if the schedule was rebuilt.
+      bool prepare( const int& time );
+
+      /// Evaluate the active signals that need an update. Does nothing if
+      /// the schedule is not frozen.
+      void runDependencies( const int& time );
+      /// Evaluate the active signals, then the roots that need an update.
+      /// If the schedule is not frozen, only pull the roots.
+      void run( const int& time );
+
+      /// True if the scheduled signal i is evaluated by run.
+      bool isActive( const std::size_t& i ) const
+      {
+	return (i<active.size())
+	  && ( active[i] || ( forced[i] && LEARNING_DONE==learningState ) );
+      }
+      /// Evaluate the scheduled signal i after the learning tick, even if
+      /// the learning tick did not read it. Until the next freeze.
+      void force( const std::size_t& i ) { forced[i] = true; }
+      /// Evaluate the scheduled signal i if it needs an update.
+      void evaluate( const std::size_t& i,const int& time );
+
+      /// Signals in evaluation order.
+      const std::vector<SignalType*>& getSchedule( void ) const
+      { return schedule; }
+      /// For each scheduled signal, the indices in the schedule of the
+      /// scheduled signals it directly depends on (through the signals left
+      /// out of the schedule, such as the input signals).
+      const std::vector< std::vector<std::size_t> >& getPredecessors( void ) const
+      { return predecessors; }
+      unsigned int getRebuildCount( void ) const { return rebuildCount; }
+
+      void display( std::ostream& os ) const;
+
+    protected:
+      /* Structure of a visited signal, as recorded at freeze. */
+      struct Node
+      {
+	SignalType* signal;
+	const DependencyType* dependency;
+	const SignalType* plugged;
+	/* Dependency list, sorted by address. */
+	std::vector<const SignalType*> dependencies;
+      };
+
+      /* Scheduled signal or root, with the range of its children in the
+       * children array. */
+      struct Step
+      {
+	SignalType* signal;
+	const DependencyType* dependency;
+	std::size_t begin,end;
+      };
+      /* Child of a step, with its index in the schedule (NOT_SCHEDULED
+       * for the signals left out of it). */
+      struct Child
+      {
+	const SignalType* signal;
+	std::size_t index;
+      };
+      static const std::size_t NOT_SCHEDULED = static_cast<std::size_t>( -1 );
+
+      static bool sameDependencies( const DependencyType& dep,
+				    const std::vector<const SignalType*>& sorted );
+      Step makeStep( SignalType* sig,
+		     const std::map<const SignalType*,std::size_t>& index );
+      bool needUpdate( const Step& step,const int& time ) const;
+      void visit( SignalType* sig,const bool isRoot );
+      void collectPredecessors( const SignalType* sig,
+				const std::map<const SignalType*,std::size_t>& index,
+				std::vector<std::size_t>& res );
+
+      std::vector<SignalType*> roots;
+      std::vector<Node> nodes;
+      std::vector<SignalType*> schedule;
+      std::vector< std::vector<std::size_t> > predecessors;
+      /* One step per scheduled signal, then one per root. */
+      std::vector<Step> steps;
+      std::vector<Child> children;
+      /* Scheduled signals evaluated by the learning tick. */
+      std::vector<bool> active;
+      /* Scheduled signals evaluated even if inactive (see force). */
+      std::vector<bool> forced;
+      enum LearningState { LEARNING_WAIT,LEARNING_TICK,LEARNING_DONE };
+      LearningState learningState;
+      int learningTime;
+      /* Visit state during freeze: 1 while in progress, 2 when sorted, 3
+       * for a root left to the pull. */
+      std::map<const SignalType*,int> visited;
+      bool frozen;
+      unsigned int rebuildCount;
+      unsigned int checkPeriod;
+      unsigned int ticksToCheck;
+    };
+
+  } // namespace sot
+} // namespace dynamicgraph
+
+
+#endif // #ifndef __SOT_GRAPH_SCHEDULE_HH__
+
+/*
+ * Local variables:
+ * c-basic-offset: 2
+ * End:
+ */
@@ -95,10 +95,14 @@ class IntegratorAbstract
   virtual sigT& integrate( sigT& res,int time ) = 0;
 
  public:
-  void pushNumCoef(const coefT& numCoef) { numerator.push_back(numCoef); }
-  void pushDenomCoef(const coefT& denomCoef) { denominator.push_back(denomCoef); }
-  void popNumCoef() { numerator.pop_back(); }
-  void popDenomCoef() { denominator.pop_back(); }
+  void pushNumCoef(const coefT& numCoef) { numerator.push_back(numCoef); coefficientsChanged(); }
+  void pushDenomCoef(const coefT& denomCoef) { denominator.push_back(denomCoef); coefficientsChanged(); }
+  void popNumCoef() { numerator.pop_back(); coefficientsChanged(); }
+  void popDenomCoef() { denominator.pop_back(); coefficientsChanged(); }
+
+ protected:
+  /// Called after each change of the numerator or of the denominator.
+  virtual void coefficientsChanged() {}
 
  public:
   dg::SignalPtr<sigT, int> SIN;
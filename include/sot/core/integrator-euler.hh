@@ -37,6 +37,41 @@
 namespace dynamicgraph { namespace sot {
 namespace dg = dynamicgraph;
 
+namespace detail
+{
+  /* A scalar coefficient is a 1x1 block applied to each channel, a matrix
+   * coefficient a block coupling all the channels. */
+  inline Matrix::Index integratorBlockSize(const double&) { return 1; }
+  inline Matrix::Index integratorBlockSize(const Matrix& c) { return c.rows(); }
+  inline bool isIntegratorBlock(const double&, Matrix::Index k) { return k == 1; }
+  inline bool isIntegratorBlock(const Matrix& c, Matrix::Index k)
+  { return c.rows() == k && c.cols() == k; }
+  inline Matrix integratorBlock(const double& c) { return Matrix::Constant(1, 1, c); }
+  inline const Matrix& integratorBlock(const Matrix& c) { return c; }
+
+  /* Number of columns of the state for a signal: one per channel with
+   * 1x1 blocks, else the signal is a single column (0 if its size does
+   * not match the blocks). */
+  inline Matrix::Index integratorChannels(const double&, Matrix::Index k)
+  { return k == 1 ? 1 : 0; }
+  inline Matrix::Index integratorChannels(const Vector& v, Matrix::Index k)
+  {
+    if (k == 1) return v.size();
+    return v.size() == k ? 1 : 0;
+  }
+
+  template<class Block>
+  void integratorWrite(Block b, const double& v) { b(0,0) = v; }
+  template<class Block>
+  void integratorWrite(Block b, const Vector& v)
+  { if (b.rows() == 1) b = v.transpose(); else b = v; }
+  template<class Block>
+  void integratorRead(const Block& b, double& v) { v = b(0,0); }
+  template<class Block>
+  void integratorRead(const Block& b, Vector& v)
+  { if (b.rows() == 1) v = b.transpose(); else v = b; }
+} // namespace detail
+
 /*!
  * \class IntegratorEuler
  * \brief integrates an ODE using a naive Euler integration.
@@ -45,6 +80,10 @@ namespace dg = dynamicgraph;
  * previous values of the other derivatives and the input
  * signal, then integrated n times, which will most certainly
  * induce a huge drift for ODEs with a high order at the denominator.
+ *
+ * This scheme is linear: it is turned into a state-space realization when
+ * the coefficients change, and each step is a single matrix product over
+ * all the channels.
 */
 template<class sigT,class coefT>
 class IntegratorEuler
@@ -68,6 +107,7 @@ class IntegratorEuler
     , derivativeSOUT(boost::bind(&IntegratorEuler<sigT,coefT>::derivative,this,_1,_2),
 		     SOUT,
 		     "sotIntegratorEuler("+name+")::output(vector)::derivativesout")
+    , blockSize(1)
   {
     this->signalRegistration( derivativeSOUT );
 
@@ -93,60 +133,91 @@ class IntegratorEuler
   virtual ~IntegratorEuler( void ) {}
 
 protected:
-  std::vector<sigT> inputMemory;
-  std::vector<sigT> outputMemory;
-
   dg::SignalTimeDependent<sigT, int> derivativeSOUT;
 
   double dt;
   double invdt;
 
-public:
-  sigT& integrate( sigT& res, int time )
+  /* Realization of the transfer function, built when the coefficients or
+   * the sampling period change. The state stacks the memories of the
+   * input derivatives and of the output derivatives, then the input: for
+   * scalar coefficients, each channel of a vector signal is a column. The
+   * realization maps it to the next memories, the output and its
+   * derivative. */
+  Matrix::Index blockSize;
+  Matrix realization;
+  Matrix memory;
+  Matrix update;
+
+  void coefficientsChanged()
   {
-    sotDEBUG(15)<<"# In {"<<std::endl;
-
-    sigT sum;
-    sigT tmp1, tmp2;
-    const std::vector<coefT>& num = numerator;
-    const std::vector<coefT>& denom = denominator;
-
-    // Step 1
-    tmp1 = inputMemory[0];
-    inputMemory[0] = SIN.access(time);
-    sum = num[0] * inputMemory[0];
-    // End of step 1. Here, sum is b_0 X
-
-    // Step 2
-    int numsize = (int)num.size();
-    for(int i = 1; i < numsize; ++i)
+    typedef Matrix::Index Index;
+    realization.resize(0,0);
+    if (numerator.empty() || denominator.empty()) return;
+
+    // The coefficients are pushed one at a time: until they have the
+    // same size, there is no realization.
+    const Index k = detail::integratorBlockSize(numerator[0]);
+    for(std::size_t i = 0; i < numerator.size(); ++i)
+      if (!detail::isIntegratorBlock(numerator[i], k)) return;
+    for(std::size_t i = 0; i < denominator.size(); ++i)
+      if (!detail::isIntegratorBlock(denominator[i], k)) return;
+
+    const Index m = (Index)numerator.size() - 1;
+    const Index n = (Index)denominator.size() - 1;
+    const Index N = m + n;
+    const Index input = k*N;
+
+    // Derivatives of the input by finite differences: d_0 = X, and
+    // d_i = (d_(i-1) - previous d_(i-1)) / dt.
+    Matrix in = Matrix::Zero(k*(m+1), k*(N+1));
+    in.block(0, input, k, k).setIdentity();
+    for(Index i = 1; i <= m; ++i)
     {
-      tmp2 = inputMemory[i-1] - tmp1;
-      tmp2 *= invdt;
-      tmp1 = inputMemory[i];
-      inputMemory[i] = tmp2;
-      sum += (num[i] * inputMemory[i]);
+      in.middleRows(k*i, k) = in.middleRows(k*(i-1), k) * invdt;
+      in.block(k*i, k*(i-1), k, k).diagonal().array() -= invdt;
     }
-    // End of step 2. Here, sum is b_m * d(m)X / dt^m + ... - b_0 X
 
-    // Step 3
-    int denomsize = (int)denom.size() - 1;
-    for(int i = 0; i < denomsize; ++i)
+    // Highest derivative of the output from the ODE (a_n is taken as 1),
+    // then integrated n times.
+    Matrix out = Matrix::Zero(k*(n+1), k*(N+1));
+    for(Index i = 0; i <= m; ++i)
+      out.middleRows(k*n, k) += detail::integratorBlock(numerator[i]) * in.middleRows(k*i, k);
+    for(Index i = 0; i < n; ++i)
+      out.block(k*n, k*(m+i), k, k) -= detail::integratorBlock(denominator[i]);
+    for(Index i = n-1; i >= 0; --i)
     {
-      sum -= (denom[i] * outputMemory[i]);
+      out.middleRows(k*i, k) = out.middleRows(k*(i+1), k) * dt;
+      out.block(k*i, k*(m+i), k, k).diagonal().array() += 1;
     }
-    // End of step 3. Here, sum is b_m * d(m)X / dt^m + ... - b_0 X - a_0 Y - ... a_n-1 d(n-1)Y / dt^(n-1)
 
-    // Step 4
-    outputMemory[denomsize] = sum;
-    for(int i = denomsize-1; i >= 0; --i)
-    {
-      outputMemory[i] += (outputMemory[i+1] * dt);
-    }
-    // End of step 4. The ODE is integrated
+    realization.setZero(k*(N+2), k*(N+1));
+    realization.topRows(k*m) = in.topRows(k*m);
+    realization.middleRows(k*m, k*n) = out.topRows(k*n);
+    realization.middleRows(input, k) = out.topRows(k);
+    if (n > 0) realization.bottomRows(k) = out.middleRows(k, k);
+    blockSize = k;
+  }
 
-    inputMemory[0] = SIN.access(time);
-    res = outputMemory[0];
+public:
+  sigT& integrate( sigT& res, int time )
+  {
+    sotDEBUG(15)<<"# In {"<<std::endl;
+
+    const sigT& in = SIN.access(time);
+    if (realization.size() == 0)
+      throw dg::ExceptionSignal (dg::ExceptionSignal::GENERIC,
+          "Integrator coefficients do not define a transfer function.");
+    if (memory.rows() != realization.cols()
+        || memory.cols() != detail::integratorChannels(in, blockSize))
+      throw dg::ExceptionSignal (dg::ExceptionSignal::GENERIC,
+          "Integrator memory does not match the input: call initialize.");
+
+    const Matrix::Index states = memory.rows() - blockSize;
+    detail::integratorWrite(memory.bottomRows(blockSize), in);
+    update.noalias() = realization * memory;
+    memory.topRows(states) = update.topRows(states);
+    detail::integratorRead(update.middleRows(states, blockSize), res);
 
     sotDEBUG(15)<<"# Out }"<<std::endl;
     return res;
@@ -154,12 +225,12 @@ public:
 
   sigT& derivative ( sigT& res, int time )
   {
-    if (outputMemory.size() < 2)
+    if (denominator.size() < 2)
       throw dg::ExceptionSignal (dg::ExceptionSignal::GENERIC,
           "Integrator does not compute the derivative.");
 
     SOUT.recompute(time);
-    res = outputMemory[1];
+    detail::integratorRead(update.bottomRows(blockSize), res);
     return res;
   }
 
@@ -167,6 +238,7 @@ public:
   {
     dt = period;
     invdt = 1/period;
+    coefficientsChanged();
   }
 
   double getSamplingPeriod () const
@@ -176,21 +248,23 @@ public:
 
   void initialize ()
   {
-    std::size_t numsize = numerator.size();
-    inputMemory.resize(numsize);
-
-    inputMemory[0] = SIN.accessCopy();
-    for(std::size_t i = 1; i < numsize; ++i)
-    {
-      inputMemory[i] = inputMemory[0];
-    }
-
-    std::size_t denomsize = denominator.size();
-    outputMemory.resize(denomsize);
-    for(std::size_t i = 0; i < denomsize; ++i)
-    {
-      outputMemory[i] = inputMemory[0];
-    }
+    const sigT& in = SIN.accessCopy();
+    if (realization.size() == 0)
+      throw dg::ExceptionSignal (dg::ExceptionSignal::GENERIC,
+          "Integrator coefficients do not define a transfer function.");
+    const Matrix::Index channels
+      = detail::integratorChannels(in, blockSize);
+    if (channels == 0)
+      throw dg::ExceptionSignal (dg::ExceptionSignal::GENERIC,
+          "Integrator input does not match the coefficients.");
+
+    // All the memories, and the derivatives, start at the input value.
+    memory.resize(realization.cols(), channels);
+    update.resize(realization.rows(), channels);
+    for(Matrix::Index i = 0; i < memory.rows(); i += blockSize)
+      detail::integratorWrite(memory.middleRows(i, blockSize), in);
+    for(Matrix::Index i = 0; i < update.rows(); i += blockSize)
+      detail::integratorWrite(update.middleRows(i, blockSize), in);
   }
 };
 
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SOT_KALMAN_BANK_H__
+#define __SOT_KALMAN_BANK_H__
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+#include <sot/core/config.hh>
+#include <dynamic-graph/entity.h>
+#include <dynamic-graph/linear-algebra.h>
+#include <dynamic-graph/signal-ptr.h>
+#include <dynamic-graph/signal-time-dependent.h>
+
+namespace dg = ::dynamicgraph;
+
+namespace dynamicgraph {
+  namespace sot {
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+using dynamicgraph::Entity;
+using dynamicgraph::SignalPtr;
+using dynamicgraph::SignalTimeDependent;
+
+/*!
+  \class KalmanBank
+  \brief Bank of independent linear Kalman filters sharing the same model.
+
+  All the filters use the same F, H, Q and R, with R diagonal:
+
+    x  = F x    + w ,   y  = H x  + v
+     k      k-1    k     k      k    k
+
+  The measures of the filters are stacked in the input y (filter after
+  filter), and the estimations in the output x_est. The optional input
+  y_valid has one entry per measure, 0 to skip it: the covariances of
+  the filters then differ.
+
+  The states and covariances are stored as one array per coefficient,
+  over the filters, so that each step of the prediction and of the
+  (sequential, one measure at a time) update is a vectorized operation on
+  all the filters.
+*/
+class SOT_CORE_DLLAPI KalmanBank
+: public Entity
+{
+  DYNAMIC_GRAPH_ENTITY_DECL();
+ public:
+
+  SignalPtr< dg::Vector,int > measureSIN;         // y, stacked
+  SignalPtr< dg::Vector,int > measureValiditySIN; // 0 to skip a measure
+  SignalPtr< dg::Matrix,int > modelTransitionSIN; // F
+  SignalPtr< dg::Matrix,int > modelMeasureSIN;    // H
+  SignalPtr< dg::Matrix,int > noiseTransitionSIN; // Q
+  SignalPtr< dg::Matrix,int > noiseMeasureSIN;    // R
+  SignalTimeDependent< dg::Vector,int > stateUpdateSOUT;    // x_est, stacked
+  SignalTimeDependent< dg::Vector,int > varianceUpdateSOUT; // diag P, stacked
+
+ public:
+  KalmanBank( const std::string& n );
+  virtual ~KalmanBank( void );
+
+  /// Stacked initial states: their number gives the number of filters.
+  void setInitialState( const dg::Vector& x0 );
+  /// Initial variance, the same for all the filters.
+  void setInitialVariance( const dg::Matrix& P0 );
+  unsigned int getNbFilters( void ) const { return (unsigned int)X.rows(); }
+
+ protected:
+
+  dg::Vector& computeStateUpdate( dg::Vector& res,const int& time );
+  dg::Vector& computeVarianceUpdate( dg::Vector& res,const int& time );
+  void initializeStates( const dg::Matrix::Index& stateSize );
+
+  dg::Vector initialState;
+  dg::Matrix initialVariance;
+  bool init;
+
+  /* One row per filter. Column a of X is the coordinate a of the states,
+   * column a+n*b of P the coefficient (a,b) of the covariances. */
+  Eigen::ArrayXXd X,Xp;
+  Eigen::ArrayXXd P,FP;
+  /* P H_j^T, gain and Joseph correction of the measure j. */
+  Eigen::ArrayXXd Ph,K,C;
+  Eigen::ArrayXd z,s;
+
+};
+
+  } /* namespace sot */
+} /* namespace dynamicgraph */
+
+#endif /* #ifndef __SOT_KALMAN_BANK_H__ */
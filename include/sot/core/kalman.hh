@@ -32,7 +32,9 @@
 #include <dynamic-graph/entity.h>
 #include <dynamic-graph/linear-algebra.h>
 #include <Eigen/LU>
+#include <Eigen/Cholesky>
 #include <sot/core/constraint.hh>
+#include <sot/core/exception-tools.hh>
 
 /* -------------------------------------------------------------------------- */
 /* --- API ------------------------------------------------------------------ */
@@ -55,10 +57,148 @@
 namespace dynamicgraph {
   namespace sot {
 
+/*!
+  \brief Covariance prediction and update of the Kalman filter, on
+  preallocated buffers. N is the size of the state, fixed for the common
+  sizes, or Eigen::Dynamic.
+
+  The gain is obtained by a LDLT solve of the innovation covariance
+  instead of its inverse, and the covariance is updated in Joseph form,
+  which keeps it symmetric and positive:
+
+    P    = (I - K H) P      (I - K H)^T + K R K^T
+     k|k              k|k-1
+
+  When R is diagonal, computeSequential processes the measurements one
+  scalar at a time, without any solve. In both cases, the measurements
+  whose entry in mask is 0 are skipped: their column of K is 0. An empty
+  mask keeps all the measurements.
+*/
+template<int N>
+class KalmanVarianceUpdate
+{
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  typedef Eigen::Matrix<double,N,N> StateMatrix;
+  typedef Eigen::Matrix<double,Eigen::Dynamic,N> MeasureMatrix;
+
+  /// From P_{k-1|k-1} in P, compute P_{k|k} in P, with the prediction
+  /// P_{k|k-1}, the innovation covariance S and the gain K.
+  void compute (const Matrix& F, const Matrix& Q,
+		const Matrix& H, const Matrix& R, const Vector& mask,
+		Matrix& P, Matrix& Pk_k_1, Matrix& S, Matrix& K)
+  {
+    predict (F, Q, P);
+
+    // A skipped measurement has a null row in H, and is decoupled from
+    // the others in S: its row of K^T is 0.
+    H_ = H;
+    for (typename MeasureMatrix::Index i = 0; i < H_.rows (); ++i)
+      if (!isValid (mask, i)) H_.row (i).setZero ();
+    HP_.noalias () = H_ * Pk_k_1_;
+    S_.noalias () = HP_ * H_.transpose ();
+    S_ += R;
+    for (Matrix::Index i = 0; i < S_.rows (); ++i)
+      if (!isValid (mask, i)) {
+	S_.row (i).setZero ();
+	S_.col (i).setZero ();
+	S_ (i, i) = 1.;
+      }
+    // LDLT also factors an indefinite S: check the sign of its pivots.
+    ldlt_.compute (S_);
+    if (ldlt_.info () != Eigen::Success
+	|| !(ldlt_.vectorD ().array () > 0.).all ())
+      SOT_THROW ExceptionTools (ExceptionTools::GENERIC,
+				"Innovation covariance is not positive",
+				" (size %d).", (int) S_.rows ());
+    // K^T = S^-1 H P_{k|k-1}, as S and P are symmetric.
+    Kt_ = ldlt_.solve (HP_);
+
+    // Joseph form, factored as A + (K R - A H^T) K^T with
+    // A = (I - K H) P_{k|k-1}, to avoid the products of size n^3.
+    FP_ = Pk_k_1_;
+    FP_.noalias () -= Kt_.transpose () * HP_;
+    KR_.noalias () = Kt_.transpose () * R;
+    KR_.noalias () -= FP_ * H_.transpose ();
+    P_ = FP_;
+    P_.noalias () += KR_ * Kt_;
+
+    P = P_;
+    Pk_k_1 = Pk_k_1_;
+    S = S_;
+    K = Kt_.transpose ();
+  }
+
+  /// Same as compute for a diagonal R, one measurement at a time.
+  void computeSequential (const Matrix& F, const Matrix& Q,
+			  const Matrix& H, const Matrix& R, const Vector& mask,
+			  Matrix& P, Matrix& Pk_k_1, Matrix& K)
+  {
+    predict (F, Q, P);
+
+    H_ = H;
+    P_ = Pk_k_1_;
+    Kt_.setZero (H_.rows (), H_.cols ());
+    for (typename MeasureMatrix::Index i = 0; i < H_.rows (); ++i) {
+      if (!isValid (mask, i)) continue;
+      const double r = R (i, i);
+      Ph_.noalias () = P_ * H_.row (i).transpose ();
+      const double s = H_.row (i).dot (Ph_) + r;
+      if (!(s > 0))
+	SOT_THROW ExceptionTools (ExceptionTools::GENERIC,
+				  "Innovation variance is not positive",
+				  " (measure %d).", (int) i);
+      k_ = Ph_ / s;
+
+      // The state is corrected by the innovation of the previous
+      // measurements too: K <- (I - k h) K, then its column i is k.
+      hK_.noalias () = Kt_ * H_.row (i).transpose ();
+      Kt_.noalias () -= hK_ * k_.transpose ();
+      Kt_.row (i) += k_.transpose ();
+
+      // Joseph form for a scalar measurement, factored as in compute.
+      P_.noalias () -= k_ * Ph_.transpose ();
+      Ph_.noalias () = P_ * H_.row (i).transpose ();
+      Ph_ = r * k_ - Ph_;
+      P_.noalias () += Ph_ * k_.transpose ();
+    }
+
+    P = P_;
+    Pk_k_1 = Pk_k_1_;
+    K = Kt_.transpose ();
+  }
+
+ protected:
+  void predict (const Matrix& F, const Matrix& Q, const Matrix& P)
+  {
+    F_ = F;
+    P_ = P;
+    FP_.noalias () = F_ * P_;
+    Pk_k_1_.noalias () = FP_ * F_.transpose ();
+    Pk_k_1_ += Q;
+  }
+
+  static bool isValid (const Vector& mask, const Matrix::Index& i)
+  {
+    return mask.size () == 0 || mask (i) != 0;
+  }
+
+  StateMatrix F_, P_, FP_, Pk_k_1_;
+  MeasureMatrix H_, HP_, Kt_;
+  Eigen::Matrix<double,N,Eigen::Dynamic> KR_;
+  Eigen::Matrix<double,N,1> Ph_, k_;
+  Vector hK_;
+  Matrix S_;
+  Eigen::LDLT<Matrix> ldlt_;
+};
+
 class SOT_KALMAN_EXPORT Kalman
 :public Entity
 {
  public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
   static const std::string CLASS_NAME;
   virtual const std::string& getClassName( void ) const { return CLASS_NAME; }
 
@@ -75,6 +215,7 @@ protected:
   SignalPtr< Matrix,int > modelMeasureSIN;    // H
   SignalPtr< Matrix,int > noiseTransitionSIN; // Q
   SignalPtr< Matrix,int > noiseMeasureSIN;    // R
+  SignalPtr< Vector,int > measureValiditySIN; // 0 to skip a measure
 
   SignalPtr< Vector,int > statePredictedSIN; // x_{k|k-1}
   SignalPtr< Vector,int > observationPredictedSIN; // y_pred = h (x_{k|k-1})
@@ -137,8 +278,9 @@ public:
       "    x   = x      + K  z             (state)   \n"
       "     k|k   k|k-1    k  k                      \n"
       "\n"
-      "    P   =(I - K  H ) P                        \n"
-      "     k|k       k  k   k|k-1                   \n"
+      "                                     T      T\n"
+      "    P   =(I - K  H ) P      (I - K  H )  + K R K\n"
+      "     k|k       k  k   k|k-1       k  k      k k k\n"
       "\n"
       "  Signals\n"
       "    - input(vector)::x_pred:  state prediction\n"
@@ -152,6 +294,7 @@ public:
       "                                                 k-1\n"
       "    - input(matrix)::R:       variance of noise v\n"
       "                                                 k\n"
+      "    - input(vector)::y_valid: optional, 0 for the measures to skip\n"
       "    - output(matrix)::P_pred: variance of prediction\n"
       "                                               ^\n"
       "    - output(vector)::x_est:  state estimation x\n"
@@ -160,6 +303,10 @@ public:
 protected:
   Matrix& computeVarianceUpdate (Matrix& P_k_k, const int& time);
   Vector& computeStateUpdate (Vector& x_est,const int& time );
+  template<int N>
+  void updateVariance (KalmanVarianceUpdate<N>& update,
+		       const Matrix& F, const Matrix& Q,
+		       const Matrix& H, const Matrix& R, const Vector& mask);
 
   void setStateEstimation (const Vector& x0)
   {
@@ -172,6 +319,19 @@ protected:
     stateVariance_ = P0;
     varianceUpdateSOUT.recompute (0);
   }
+
+  void setSequentialUpdate (const bool& sequential)
+  {
+    sequentialUpdate_ = sequential;
+  }
+  bool getSequentialUpdate () const { return sequentialUpdate_; }
+
+  const Vector& measureValidity (const int& time);
+
+  // Process the measures one at a time when R is diagonal.
+  bool sequentialUpdate_;
+  // All measures valid, when measureValiditySIN is not plugged.
+  Vector noMask_;
   // Current state estimation
   // ^
   // x
@@ -187,10 +347,6 @@ protected:
   //              k    k    k  k|k-1
   Vector z_;
 
-  // F    P
-  //  k-1  k-1|k-1
-  Matrix FP_;
-
   // Variance prediction
   // P
   //  k|k-1
@@ -201,6 +357,13 @@ protected:
 
   // Kalman Gain
   Matrix K_;
+
+  // Covariance update, specialized for the common sizes of the state.
+  KalmanVarianceUpdate<3> varianceUpdate3_;
+  KalmanVarianceUpdate<6> varianceUpdate6_;
+  KalmanVarianceUpdate<9> varianceUpdate9_;
+  KalmanVarianceUpdate<12> varianceUpdate12_;
+  KalmanVarianceUpdate<Eigen::Dynamic> varianceUpdate_;
 public:
   Kalman( const std::string & name ) ;
   /* --- Entity --- */
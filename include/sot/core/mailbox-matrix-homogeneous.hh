@@ -0,0 +1,62 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SOT_MAILBOX_MATRIX_HOMOGENEOUS_HH
+#define __SOT_MAILBOX_MATRIX_HOMOGENEOUS_HH
+
+/* --- SOT PLUGIN  --- */
+#include <sot/core/mailbox.hh>
+
+#include <sot/core/matrix-geometry.hh>
+
+/* --------------------------------------------------------------------- */
+/* --- API ------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+#if defined (WIN32) 
+#  if defined (mailbox_matrix_homogeneous_EXPORTS)
+#    define MAILBOX_MATRIX_HOMOGENEOUS_EXPORT __declspec(dllexport)
+#  else  
+#    define MAILBOX_MATRIX_HOMOGENEOUS_EXPORT  __declspec(dllimport)
+#  endif 
+#else
+#  define MAILBOX_MATRIX_HOMOGENEOUS_EXPORT 
+#endif
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+namespace dynamicgraph {
+  namespace sot {
+#ifdef WIN32
+    class MAILBOX_MATRIX_HOMOGENEOUS_EXPORT MailboxMatrixHomogeneous : public Mailbox<MatrixHomogeneous> 
+    {
+    public:
+      MailboxMatrixHomogeneous( const std::string& name );
+    };
+#else
+    typedef Mailbox<MatrixHomogeneous> MailboxMatrixHomogeneous;
+#endif
+  } // namespace sot
+} // namespace dynamicgraph
+
+#endif // #ifndef  __SOT_MAILBOX_HH
+
+
+
+
+
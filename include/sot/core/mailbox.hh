@@ -25,6 +25,9 @@
 /* --- SOT PLUGIN  --- */
 #include <dynamic-graph/entity.h>
 #include <dynamic-graph/all-signals.h>
+#include <dynamic-graph/linear-algebra.h>
+#include <sot/core/matrix-geometry.hh>
+#include <Eigen/StdVector>
 
 /* --- BOOST --- */
 #include <boost/thread/mutex.hpp>
@@ -37,13 +40,68 @@
 #include <sys/time.h>
 #else
 #include <sot/core/utils-windows.hh>
+#include <windows.h>
 #endif /*WIN32*/
 #include <string>
+#include <vector>
 
 namespace dynamicgraph { namespace sot {
 
 namespace dg = dynamicgraph;
 
+/* --- INTERPOLATION --- */
+/* Value between before (alpha=0) and after (alpha=1). Objects without a
+ * specific interpolation take the nearest sample. */
+template< class Object >
+void mailboxInterpolate( const Object& before,const Object& after,
+			 const double& alpha,Object& res )
+{
+  res = ( alpha<.5 ) ? before : after;
+}
+
+inline void mailboxInterpolate( const dg::Vector& before,const dg::Vector& after,
+				const double& alpha,dg::Vector& res )
+{
+  if( before.size()!=after.size() ) { res = ( alpha<.5 ) ? before : after; return; }
+  res = before + alpha*( after-before );
+}
+
+/* Slerp of the rotation, linear interpolation of the translation. */
+inline void mailboxInterpolate( const MatrixHomogeneous& before,
+				const MatrixHomogeneous& after,
+				const double& alpha,MatrixHomogeneous& res )
+{
+  const VectorQuaternion qBefore( before.linear() ),qAfter( after.linear() );
+  res.linear() = qBefore.slerp( alpha,qAfter ).toRotationMatrix();
+  res.translation() = before.translation()
+    + alpha*( after.translation()-before.translation() );
+  res.makeAffine();
+}
+
+/*!
+  \class Mailbox
+  \brief Hand over objects posted by another thread to the graph.
+
+  The mailbox is a triple buffer: the writer fills its own buffer, then
+  swaps it atomically with the buffer of the latest sample; the reader
+  swaps the buffer of the latest sample with its own one when a sample
+  is fresh. Neither side takes a lock or waits for the other one, and the
+  reader always gets the latest complete sample. Once each buffer has
+  received an object of a given size (after three posts), posting objects
+  of the same size does not allocate anymore.
+
+  The samples overwritten by a newer post before the reader took them are
+  counted, as are the reads finding no new sample.
+
+  In history mode (setHistory), the posted samples are also kept, stamped
+  on a monotonic clock (getMonotonicTime), in a ring of fixed capacity.
+  The output interpolated gives the object interpolated at the time of
+  the input time (or now, if it is not plugged) minus the delay: linear
+  for vectors, slerp for homogeneous matrices. Before the oldest sample
+  or after the newest one, the nearest sample is given. The writer only
+  queues the samples in preallocated slots, dropping them when the queue
+  is full; they are moved to the ring when the output is computed.
+*/
 template< class Object >
 class Mailbox
 : public dg::Entity
@@ -58,26 +116,75 @@ class Mailbox
     Object obj;
     struct timeval timestamp;
   };
+  struct sotHistorySample
+  {
+    Object obj;
+    double time;
+  };
+  /* The fixed-size objects (homogeneous matrices) need aligned slots. */
+  typedef std::vector< sotHistorySample,
+		       Eigen::aligned_allocator<sotHistorySample> > HistoryVector;
 
 public:
-  
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
   Mailbox( const std::string& name );
   ~Mailbox( void );
   
   void post( const Object& obj );
+  /// Post an object acquired at time, read on getMonotonicTime.
+  void post( const Object& obj,const double& time );
   sotTimestampedObject& get( sotTimestampedObject& res,const int& dummy );
 
   Object& getObject( Object& res,const int& time );
   struct timeval& getTimestamp( struct timeval& res,const int& time );
 
   bool hasBeenUpdated( void );
-  
-protected:
 
-  boost::timed_mutex mainObjectMutex;
-  Object mainObject;
-  struct timeval mainTimeStamp;
-  bool update;
+  /// Number of samples replaced by a newer post before being read.
+  unsigned int getOverwrittenCount( void ) const { return overwritten; }
+  /// Number of reads without any new sample since the previous read.
+  unsigned int getStaleReadCount( void ) const { return staleReads; }
+  virtual void display( std::ostream& os ) const;
+
+  /// Keep the last capacity samples (0 to disable). To be called before
+  /// the writer starts posting.
+  void setHistory( const unsigned int& capacity );
+  Object& getInterpolated( Object& res,const int& time );
+  /// Number of samples left out of the history: queue full, or posted
+  /// with a time older than the newest sample.
+  unsigned int getHistoryDropCount( void ) const
+  { return queueOverflows+outOfOrder; }
+  /// Monotonic time in seconds.
+  static double getMonotonicTime( void );
+
+protected:
+  /* The latest sample is in buffers[ latest&INDEX ]; FRESH is set when
+   * it has not been read yet. */
+  static const long INDEX = 3;
+  static const long FRESH = 4;
+  long exchangeLatest( const long& value );
+
+  sotTimestampedObject buffers[3];
+  volatile long latest;
+  /* Owned by the writer and by the reader, respectively. */
+  long writeIndex;
+  long readIndex;
+  volatile unsigned int overwritten;
+  volatile unsigned int staleReads;
+
+  /* The writer queues the samples in queue[ queueHead%capacity ], the
+   * reader moves them to the ring history. */
+  void drainQueue( void );
+  HistoryVector queue;
+  volatile unsigned long queueHead;
+  volatile unsigned long queueTail;
+  HistoryVector history;
+  unsigned int historyStart;
+  unsigned int historySize;
+  volatile unsigned int queueOverflows;
+  unsigned int outOfOrder;
+  double delay;
 
  public: /* --- SIGNALS --- */
 
@@ -85,6 +192,9 @@ protected:
   dg::SignalTimeDependent< Object,int > objSOUT;
   dg::SignalTimeDependent< struct timeval,int > timeSOUT;
 
+  dg::SignalPtr< double,int > timeSIN;
+  dg::SignalTimeDependent< Object,int > interpolatedSOUT;
+
 };
 
 
@@ -22,12 +22,25 @@
 #define __SOT_MAILBOX_T_CPP
 
 #include <sot/core/mailbox.hh>
+#include <dynamic-graph/command-bind.h>
+#include <dynamic-graph/command-direct-getter.h>
+#include <dynamic-graph/command-direct-setter.h>
 
 namespace dynamicgraph {
   namespace sot {
 
     namespace dg = dynamicgraph;
 
+    /* Full memory barrier between the writer and the reader. */
+    inline void mailboxMemoryBarrier( void )
+    {
+#ifdef WIN32
+      MemoryBarrier();
+#else
+      __sync_synchronize();
+#endif
+    }
+
     /* -------------------------------------------------------------------------- */
     /* --- CONSTRUCTION --------------------------------------------------------- */
     /* -------------------------------------------------------------------------- */
@@ -35,9 +48,20 @@ namespace dynamicgraph {
     Mailbox<Object>::
     Mailbox( const std::string& name )
       :Entity(name)
-      ,mainObjectMutex()
-      ,mainObject()
-      ,update(false)
+      ,latest(0)
+      ,writeIndex(1)
+      ,readIndex(2)
+      ,overwritten(0)
+      ,staleReads(0)
+      ,queue()
+      ,queueHead(0)
+      ,queueTail(0)
+      ,history()
+      ,historyStart(0)
+      ,historySize(0)
+      ,queueOverflows(0)
+      ,outOfOrder(0)
+      ,delay(0.)
 
       ,SOUT( boost::bind(&Mailbox::get,this,_1,_2),
 	     sotNOSIGNAL,
@@ -48,16 +72,55 @@ namespace dynamicgraph {
       ,timeSOUT( boost::bind(&Mailbox::getTimestamp,this,_1,_2),
 		 SOUT,
 		 "Mailbox("+name+")::output(Object)::timestamp" )
+      ,timeSIN( NULL,"Mailbox("+name+")::input(double)::time" )
+      ,interpolatedSOUT( boost::bind(&Mailbox::getInterpolated,this,_1,_2),
+			 timeSIN,
+			 "Mailbox("+name+")::output(Object)::interpolated" )
     {
-      signalRegistration( SOUT<<objSOUT<<timeSOUT );
+      for( int i=0;i<3;++i )
+	{
+	  buffers[i].timestamp.tv_sec = 0;
+	  buffers[i].timestamp.tv_usec = 0;
+	}
+      signalRegistration( SOUT<<objSOUT<<timeSOUT<<timeSIN<<interpolatedSOUT );
       SOUT.setDependencyType( TimeDependency<int>::BOOL_DEPENDENT );
+
+      using namespace dynamicgraph::command;
+      addCommand("setHistory",
+		 makeCommandVoid1(*this,&Mailbox::setHistory,
+				  docCommandVoid1("Keep the given number of samples to "
+						  "interpolate (0 to disable), before "
+						  "posting.",
+						  "unsigned int")));
+      addCommand("setDelay",
+		 makeDirectSetter(*this,&delay,
+				  docDirectSetter("delay of the interpolated output "
+						  "(seconds)","double")));
+      addCommand("getDelay",
+		 makeDirectGetter(*this,&delay,
+				  docDirectGetter("delay of the interpolated output "
+						  "(seconds)","double")));
     }
 
     template< class Object >
     Mailbox<Object>::
     ~Mailbox( void )
     {
-      boost::timed_mutex::scoped_lock lockMain( mainObjectMutex );
+    }
+
+    /* Atomic exchange, with a full memory barrier. */
+    template< class Object >
+    long Mailbox<Object>::
+    exchangeLatest( const long& value )
+    {
+#ifdef WIN32
+      return InterlockedExchange( &latest,value );
+#else
+      long previous;
+      do { previous = latest; }
+      while(! __sync_bool_compare_and_swap( &latest,previous,value ) );
+      return previous;
+#endif
     }
 
     /* -------------------------------------------------------------------------- */
@@ -67,16 +130,7 @@ namespace dynamicgraph {
     bool Mailbox<Object>::
     hasBeenUpdated( void )
     {
-      boost::timed_mutex::scoped_try_lock lockMain( this->mainObjectMutex );
-  
-      if( lockMain.owns_lock() )
-	{
-	  return update;
-	}
-      else 
-	{
-	  return false;
-	}
+      return 0!=( latest&FRESH );
     }
 
 
@@ -85,16 +139,16 @@ namespace dynamicgraph {
     typename Mailbox<Object>::sotTimestampedObject& Mailbox<Object>::
     get( typename Mailbox<Object>::sotTimestampedObject& res,const int& /*dummy*/ )
     {
-      boost::timed_mutex::scoped_try_lock lockMain( this->mainObjectMutex );
-  
-      if( lockMain.owns_lock() )
-	{
-	  res.timestamp.tv_sec=this->mainTimeStamp.tv_sec;
-	  res.timestamp.tv_usec=this->mainTimeStamp.tv_usec;
-      
-	  update = false;
-	  res.obj = this->mainObject;
-	}
+      /* Take the latest sample, leaving the buffer read before to the
+       * writer. */
+      if( 0!=( latest&FRESH ) )
+	readIndex = exchangeLatest( readIndex )&INDEX;
+      else ++staleReads;
+
+      const sotTimestampedObject& sample = buffers[readIndex];
+      res.timestamp.tv_sec = sample.timestamp.tv_sec;
+      res.timestamp.tv_usec = sample.timestamp.tv_usec;
+      res.obj = sample.obj;
 
       return res;
     }
@@ -104,10 +158,37 @@ namespace dynamicgraph {
     void Mailbox<Object>::
     post( const Object& value )
     {
-      boost::timed_mutex::scoped_lock lockMain( this->mainObjectMutex );
-      mainObject = value;
-      gettimeofday( &this->mainTimeStamp, NULL );
-      update = true;
+      post( value,getMonotonicTime() );
+    }
+
+    template< class Object >
+    void Mailbox<Object>::
+    post( const Object& value,const double& time )
+    {
+      /* Queue the sample for the history, unless the queue is full. */
+      if(! queue.empty() )
+	{
+	  const unsigned long head = queueHead;
+	  if( head-queueTail>=queue.size() ) ++queueOverflows;
+	  else
+	    {
+	      sotHistorySample& queued = queue[ head%queue.size() ];
+	      queued.obj = value;
+	      queued.time = time;
+	      mailboxMemoryBarrier();
+	      queueHead = head+1;
+	    }
+	}
+
+      sotTimestampedObject& sample = buffers[writeIndex];
+      sample.obj = value;
+      gettimeofday( &sample.timestamp, NULL );
+
+      /* Publish the sample, and get back the previous one, or the one the
+       * reader left. */
+      const long previous = exchangeLatest( writeIndex|FRESH );
+      if( 0!=( previous&FRESH ) ) ++overwritten;
+      writeIndex = previous&INDEX;
       SOUT.setReady();
 
       return;
@@ -121,6 +202,116 @@ namespace dynamicgraph {
       res = data.obj; return res;
     }
 
+    template< class Object >
+    void Mailbox<Object>::
+    display( std::ostream& os ) const
+    {
+      os << getClassName() << " " << getName() << ": "
+	 << overwritten << " samples overwritten, "
+	 << staleReads << " stale reads" << std::endl;
+      if(! history.empty() )
+	os << "  history of " << history.size() << " samples: "
+	   << historySize << " kept, " << queueOverflows+outOfOrder
+	   << " dropped, delay " << delay << " s" << std::endl;
+    }
+
+    /* -------------------------------------------------------------------------- */
+    /* --- HISTORY -------------------------------------------------------------- */
+    /* -------------------------------------------------------------------------- */
+
+    template< class Object >
+    double Mailbox<Object>::
+    getMonotonicTime( void )
+    {
+#ifdef WIN32
+      LARGE_INTEGER frequency,counter;
+      QueryPerformanceFrequency( &frequency );
+      QueryPerformanceCounter( &counter );
+      return (double)counter.QuadPart/(double)frequency.QuadPart;
+#else
+      struct timespec now;
+      clock_gettime( CLOCK_MONOTONIC,&now );
+      return (double)now.tv_sec + 1e-9*(double)now.tv_nsec;
+#endif
+    }
+
+    template< class Object >
+    void Mailbox<Object>::
+    setHistory( const unsigned int& capacity )
+    {
+      queue.assign( capacity,sotHistorySample() );
+      history.assign( capacity,sotHistorySample() );
+      queueHead = queueTail = 0;
+      historyStart = historySize = 0;
+      queueOverflows = outOfOrder = 0;
+    }
+
+    /* Move the queued samples to the end of the ring, overwriting the
+     * oldest ones. */
+    template< class Object >
+    void Mailbox<Object>::
+    drainQueue( void )
+    {
+      const unsigned long head = queueHead;
+      if( head==queueTail ) return;
+      mailboxMemoryBarrier();
+
+      const unsigned int capacity = (unsigned int)history.size();
+      for( unsigned long i=queueTail;i!=head;++i )
+	{
+	  const sotHistorySample& queued = queue[ i%capacity ];
+	  if( historySize>0
+	      && queued.time<history[ ( historyStart+historySize-1 )%capacity ].time )
+	    { ++outOfOrder; continue; }
+
+	  sotHistorySample* slot;
+	  if( historySize<capacity )
+	    slot = &history[ ( historyStart+historySize++ )%capacity ];
+	  else
+	    {
+	      slot = &history[ historyStart ];
+	      historyStart = ( historyStart+1 )%capacity;
+	    }
+	  slot->obj = queued.obj;
+	  slot->time = queued.time;
+	}
+
+      /* The slots are copied before being given back to the writer. */
+      mailboxMemoryBarrier();
+      queueTail = head;
+    }
+
+    template< class Object >
+    Object& Mailbox<Object>::
+    getInterpolated( Object& res,const int& time )
+    {
+      if( history.empty() ) return res;
+      drainQueue();
+      if( 0==historySize ) return res;
+
+      const double t = ( timeSIN.isPlugged() ? timeSIN( time ) : getMonotonicTime() )
+	- delay;
+      const unsigned int capacity = (unsigned int)history.size();
+      const sotHistorySample& newest
+	= history[ ( historyStart+historySize-1 )%capacity ];
+      if( t>=newest.time ) { res = newest.obj; return res; }
+
+      /* The requested time is usually close to the newest sample. */
+      for( unsigned int k=historySize-1;k>0;--k )
+	{
+	  const sotHistorySample& before = history[ ( historyStart+k-1 )%capacity ];
+	  if( before.time<=t )
+	    {
+	      const sotHistorySample& after = history[ ( historyStart+k )%capacity ];
+	      mailboxInterpolate( before.obj,after.obj,
+				  ( t-before.time )/( after.time-before.time ),res );
+	      return res;
+	    }
+	}
+      res = history[ historyStart ].obj;
+      return res;
+    }
+
     template< class Object >
     timeval& Mailbox<Object>::
     getTimestamp( struct timeval& res,const int& time )
@@ -139,8 +330,14 @@ namespace dynamicgraph {
   namespace dynamicgraph {                      \
     namespace sot {							\
       template void Mailbox<S>::post(const S& obj );			\
-      template dynamicgraph::Vector&  Mailbox<S>::getObject( S& res,const int& time ); \
+      template void Mailbox<S>::post(const S& obj,const double& time );	\
+      template S&  Mailbox<S>::getObject( S& res,const int& time );	\
+      template S&  Mailbox<S>::getInterpolated( S& res,const int& time ); \
+      template void Mailbox<S>::setHistory(const unsigned int& capacity); \
+      template void Mailbox<S>::drainQueue(void);			\
+      template double Mailbox<S>::getMonotonicTime(void);		\
       template bool Mailbox<S>::hasBeenUpdated(void);			\
+      template void Mailbox<S>::display(std::ostream& os) const;	\
       template Mailbox<S>::~Mailbox();					\
       template Mailbox<S>::sotTimestampedObject& Mailbox<S>::get( Mailbox<S>::sotTimestampedObject& res,const int& dummy ); \
       template Mailbox<S>::Mailbox(const std::string& name);		\
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SOT_MULTI_CHANNEL_FIR_HH__
+#define __SOT_MULTI_CHANNEL_FIR_HH__
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+/* SOT */
+#include <sot/core/api.hh>
+/* Matrix */
+#include <dynamic-graph/linear-algebra.h>
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+namespace dynamicgraph {
+  namespace sot {
+
+    /*!
+      \class MultiChannelFIR
+      \brief FIR filter applied to each component of a vector, with the same
+      scalar coefficients.
+
+      The history is stored channel by channel, each in a mirrored ring of
+      twice the number of coefficients: a new sample is written at the
+      position p and at p+N, so that the last N samples of a channel are
+      always contiguous, from the newest to the oldest. Each output is then
+      the dot product of the coefficients (aligned by Eigen) with a
+      contiguous window, and all the outputs are computed by one vectorized
+      matrix-vector product.
+
+      Several filters can share the history, with one column of
+      coefficients each: their outputs are then one matrix product.
+
+      The samples before the first one are taken as zero, unless the
+      history is filled with a sample. The history is reset when the number
+      of coefficients or of channels changes; no allocation happens
+      otherwise.
+    */
+    class SOT_CORE_EXPORT MultiChannelFIR
+    {
+    public:
+      MultiChannelFIR( void );
+
+      /// Set the number of coefficients, set to zero.
+      void resize( const std::size_t& nbTaps );
+      std::size_t getSize( void ) const { return nbTaps; }
+      std::size_t getNbChannels( void ) const { return nbChannels; }
+
+      /// Coefficient of the first filter.
+      void setCoefficient( const std::size_t& rank,const double& coef );
+      double getCoefficient( const std::size_t& rank ) const;
+      /// Set all the coefficients, one column per filter.
+      void setCoefficients( const dynamicgraph::Matrix& coefs );
+      const dynamicgraph::Matrix& getCoefficients( void ) const { return coefs; }
+
+      /// Forget the previous samples.
+      void reset( const std::size_t& nbChannels );
+      /// Take the previous samples as equal to in.
+      void fill( const dynamicgraph::Vector& in );
+
+      /// Push the sample in, and write the channels filtered by the first
+      /// filter in out.
+      void compute( const dynamicgraph::Vector& in,dynamicgraph::Vector& out );
+      /// Push the sample in, and write in the column f of out the channels
+      /// filtered by the filter f.
+      void compute( const dynamicgraph::Vector& in,dynamicgraph::Matrix& out );
+
+    protected:
+      /* nbTaps x nbChannels view of the last samples, newest first. */
+      typedef Eigen::Map<const dynamicgraph::Matrix,0,Eigen::OuterStride<> >
+      Windows;
+      /* Write the sample in the history, and return the windows. */
+      Windows push( const dynamicgraph::Vector& in );
+
+      dynamicgraph::Matrix coefs;
+      /* Channel c occupies history[ 2*nbTaps*c, 2*nbTaps*(c+1) ), seen as
+       * the column c of a 2*nbTaps x nbChannels matrix. */
+      dynamicgraph::Vector history;
+      std::size_t nbTaps;
+      std::size_t nbChannels;
+      std::size_t position;
+    };
+
+  } // namespace sot
+} // namespace dynamicgraph
+
+
+#endif // #ifndef __SOT_MULTI_CHANNEL_FIR_HH__
+
+/*
+ * Local variables:
+ * c-basic-offset: 2
+ * End:
+ */
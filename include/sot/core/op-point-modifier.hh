@@ -57,6 +57,10 @@ namespace dg = dynamicgraph;
 /// The position of the local frame in the frame of the joint is represented by
 /// transformation.
 ///
+/// The signals jacobiansIN / jacobians apply the same transformation to
+/// K Jacobians stacked in a 6K x n matrix. In world-frame mode, the K
+/// placements of the joints are stacked in the 4K x 4 matrix positionsIN.
+///
 class SOTOPPOINTMODIFIER_EXPORT OpPointModifier
 : public dg::Entity
 {
@@ -72,11 +76,16 @@ class SOTOPPOINTMODIFIER_EXPORT OpPointModifier
   dg::SignalTimeDependent<dg::Matrix,int> jacobianSOUT;
   dg::SignalTimeDependent<MatrixHomogeneous,int> positionSOUT;
 
+  dg::SignalPtr<dg::Matrix,int> jacobiansSIN;
+  dg::SignalPtr<dg::Matrix,int> positionsSIN;
+  dg::SignalTimeDependent<dg::Matrix,int> jacobiansSOUT;
+
 public:
   OpPointModifier( const std::string& name );
   virtual ~OpPointModifier( void ){}
 
   dg::Matrix& jacobianSOUT_function( dg::Matrix& res,const int& time );
+  dg::Matrix& jacobiansSOUT_function( dg::Matrix& res,const int& time );
   MatrixHomogeneous& positionSOUT_function( MatrixHomogeneous& res,const int& time );
   void setTransformation( const Eigen::Matrix4d& tr );
   void setTransformationBySignalName( std::istringstream& cmdArgs );
@@ -85,6 +94,19 @@ public:
  private:
   MatrixHomogeneous transformation;
 
+  /* Blocks of the twist bVa, computed by setTransformation:
+   * bVa = [ bRa  skew(bta) bRa ; 0  bRa ]. */
+  Eigen::Matrix3d bRa, bTxRa;
+  /* Translation of the transformation, used in world-frame mode. */
+  Eigen::Vector3d aAB;
+
+  /* Write the transformed Jacobian of aJa (6 x n) into the 6 rows of res. */
+  template< typename JacobianIn,typename JacobianOut >
+    void applyEndEffector( const JacobianIn& aJa,JacobianOut res ) const;
+  template< typename JacobianIn,typename JacobianOut >
+    void applyWorldFrame( const MatrixRotation& oRa,
+			  const JacobianIn& oJa,JacobianOut res ) const;
+
 
   /* This bool tunes the effect of the modifier for end-effector Jacobian (ie the output
    * velocity is expressed in the end-effector frame) of from the world-ref Jacobian (ie
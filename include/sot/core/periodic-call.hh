@@ -30,9 +30,11 @@
 #include <dynamic-graph/signal-base.h>
 #include <dynamic-graph/entity.h>
 #include <sot/core/api.hh>
+#include <sot/core/graph-schedule.hh>
 /* STD */
 #include <list>
 #include <map>
+#include <vector>
 #include <string>
 
 /* --------------------------------------------------------------------- */
@@ -44,6 +46,17 @@ namespace sot {
 
 /*!
   \class PeriodicCall
+
+  The signals are stored by name, and called from a flat list rebuilt when
+  the set of signals changes. A downsampled signal of factor N and phase P
+  is called at the times t such that t%N==P. The phase is set explicitly
+  with setPhase, or chosen by the automatic staggering (setAutoStagger) to
+  spread the downsampled signals over the ticks, weighted by their measured
+  execution time. The signals are first staggered with the same weight;
+  they are staggered again once, when each of them has been called
+  STAGGER_CALLS times, with their measured weights. resetStats, changing
+  the list or enabling the staggering again start a new measure, for
+  instance when the load of the signals changed.
 */
 class SOT_CORE_EXPORT PeriodicCall
 {
@@ -52,24 +65,65 @@ class SOT_CORE_EXPORT PeriodicCall
   {
     dynamicgraph::SignalBase<int>* signal;
     unsigned int downsamplingFactor;
+    unsigned int phase;
+    /* True if the phase is left to the automatic staggering. */
+    bool autoPhase;
+    /* Next time at which the signal is called. */
+    int nextTime;
+    /* Dependencies of the signal, when the call is frozen. */
+    GraphSchedule schedule;
+
+    /* Execution time of the calls, in microseconds. */
+    unsigned int nbCalls;
+    double lastDuration,totalDuration,maxDuration;
 
     SignalToCall()
     {
       signal = NULL;
       downsamplingFactor = 1;
+      phase = 0; autoPhase = true;
+      nextTime = 0;
+      resetStats();
     }
 
     SignalToCall(dynamicgraph::SignalBase<int>* s, unsigned int df=1)
     {
       signal = s;
-      downsamplingFactor = df;
+      downsamplingFactor = (df>0) ? df : 1;
+      phase = 0; autoPhase = true;
+      nextTime = 0;
+      schedule.addRoot( *s );
+      resetStats();
+    }
+
+    void resetStats()
+    {
+      nbCalls = 0;
+      lastDuration = totalDuration = maxDuration = 0;
     }
+    double meanDuration() const
+    { return (nbCalls>0) ? totalDuration/nbCalls : 0; }
   };
 
   typedef std::map< std::string,SignalToCall > SignalMapType;
   SignalMapType signalMap;
+  /* Flat list of the signals of signalMap, in calling order. */
+  std::vector<SignalToCall*> callList;
 
   int innerTime;
+  bool frozen;
+  bool autoStagger;
+  /* True until the phases are staggered from measured weights. */
+  bool staggerPending;
+  /* Calls of each signal measured before the second staggering. */
+  static const unsigned int STAGGER_CALLS = 5;
+
+  void addSignalToCall( const std::string &name,const SignalToCall& sig );
+  /* Rebuild callList, and the phases if the staggering is automatic. */
+  void updateCallList( void );
+  void staggerPhases( void );
+  /* Stagger the phases again once the signals have been measured. */
+  void staggerMeasured( void );
 
   /* --- FUNCTIONS ------------------------------------------------------------ */
  public:
@@ -86,9 +140,25 @@ class SOT_CORE_EXPORT PeriodicCall
   void runSignals( const int& t );
   void run( const int& t );
 
-  void clear( void ) { signalMap.clear(); }
+  void clear( void ) { signalMap.clear(); updateCallList(); }
+  bool empty( void ) const { return signalMap.empty(); }
+
+  /// Call the signal at the times t such that t%factor==phase.
+  void setPhase( const std::string &name,const unsigned int& phase );
+  /// Choose the phases of the downsampled signals without explicit phase
+  /// to balance the load of the ticks.
+  void setAutoStagger( const bool& stagger );
+  void resetStats( void );
+
+  /// Evaluate the dependencies of each signal from a flat schedule
+  /// (see GraphSchedule) instead of the recursive pull.
+  void freeze( void );
+  void unfreeze( void );
+  bool isFrozen( void ) const { return frozen; }
 
   void display( std::ostream& os ) const;
+  /// Execution time of each signal.
+  void displayStats( std::ostream& os ) const;
   void addSpecificCommands( dynamicgraph::Entity& ent,
 			    dynamicgraph::Entity::CommandMap_t& commap,
 			    const std::string & prefix = "" );
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SOT_SAVITZKY_GOLAY_H__
+#define __SOT_SAVITZKY_GOLAY_H__
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+#include <sot/core/config.hh>
+#include <sot/core/multi-channel-fir.hh>
+#include <dynamic-graph/entity.h>
+#include <dynamic-graph/linear-algebra.h>
+#include <dynamic-graph/signal.h>
+#include <dynamic-graph/signal-ptr.h>
+#include <dynamic-graph/signal-time-dependent.h>
+
+namespace dg = ::dynamicgraph;
+
+namespace dynamicgraph {
+  namespace sot {
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+using dynamicgraph::Entity;
+using dynamicgraph::Signal;
+using dynamicgraph::SignalPtr;
+using dynamicgraph::SignalTimeDependent;
+
+/*!
+  \class SavitzkyGolay
+  \brief Smoothed value, first and second derivatives of a vector signal,
+  by a least-square polynomial fit over a sliding window.
+
+  The polynomial of the given order fitting the last size samples is
+  evaluated delay samples before the newest one: 0 gives an estimate
+  without lag, (size-1)/2 the centered (smoothest) one. The fit being
+  linear in the samples, the three outputs are three FIR filters, whose
+  coefficients are computed once by setWindow; they share the history of
+  a MultiChannelFIR and are computed in one product at each sample.
+
+  The history starts filled with the first sample, so that the derivatives
+  start from zero. The derivatives are scaled by the time step dt.
+*/
+class SOT_CORE_DLLAPI SavitzkyGolay
+: public Entity
+{
+  DYNAMIC_GRAPH_ENTITY_DECL();
+ public:
+
+  SignalPtr< dg::Vector,int > SIN;
+  Signal< double,int > timestepSIN;
+  SignalTimeDependent< int,int > filterSINTERN;
+  SignalTimeDependent< dg::Vector,int > valueSOUT;
+  SignalTimeDependent< dg::Vector,int > derivativeSOUT;
+  SignalTimeDependent< dg::Vector,int > secondDerivativeSOUT;
+
+ public:
+  SavitzkyGolay( const std::string& n );
+  virtual ~SavitzkyGolay( void );
+
+  void setWindow( const int& size,const int& order,const int& delay );
+  void reset( void );
+
+  /// Coefficients for a unit time step: row k applies to the sample k
+  /// steps old, the columns give the value, the first and the second
+  /// derivatives.
+  static dg::Matrix coefficients( const int& size,const int& order,
+                                  const int& delay );
+
+ protected:
+
+  int& filter( int& dummy,const int& time );
+  dg::Vector& getValue( dg::Vector& res,const int& time );
+  dg::Vector& getDerivative( dg::Vector& res,const int& time );
+  dg::Vector& getSecondDerivative( dg::Vector& res,const int& time );
+
+  MultiChannelFIR fir;
+  /* One column per output, one row per channel. */
+  dg::Matrix outputs;
+  double timestep;
+  bool init;
+
+};
+
+  } /* namespace sot */
+} /* namespace dynamicgraph */
+
+#endif /* #ifndef __SOT_SAVITZKY_GOLAY_H__ */
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SOT_SELECTION_JACOBIAN_HH__
+#define __SOT_SELECTION_JACOBIAN_HH__
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+/* Matrix */
+#include <dynamic-graph/linear-algebra.h>
+namespace dg = dynamicgraph;
+
+/* STD */
+#include <iosfwd>
+
+/* SOT */
+#include "sot/core/api.hh"
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+namespace dynamicgraph {
+  namespace sot {
+
+    /*! \class SelectionJacobian
+      \brief Jacobian made of scaled rows of the identity.
+
+      Row \f$i\f$ of the represented matrix has a single non-zero
+      coefficient \f$s_i\f$ located in column \f$c_i\f$. This is the shape
+      of the Jacobian of joint-space features (posture, joint limits): the
+      product with any matrix \f$M\f$ reduces to a gather of the rows of
+      \f$M\f$, \f$(S M)_i = s_i M_{c_i}\f$, instead of a dense product.
+    */
+    class SOT_CORE_EXPORT SelectionJacobian
+    {
+    public:
+      typedef dg::Matrix::Index Index;
+      typedef Eigen::Matrix<Index,Eigen::Dynamic,1> IndexVector;
+
+    protected:
+      IndexVector colIndices;
+      dg::Vector scales;
+      Index nbCols;
+
+    public:
+      SelectionJacobian( const Index& nbRows=0,const Index& nbCols=0 );
+
+      /*! \brief Change the size of the represented matrix. Already stored
+	rows are kept when the number of rows is unchanged. */
+      void resize( const Index& nbRows,const Index& nbCols );
+
+      inline Index rows( void ) const { return colIndices.size(); }
+      inline Index cols( void ) const { return nbCols; }
+
+      /*! \brief Set row i to s.e_j^T. */
+      inline void set( const Index& i,const Index& j,const double& s=1. )
+      { colIndices(i) = j; scales(i) = s; }
+      inline const Index& colIndex( const Index& i ) const
+      { return colIndices(i); }
+      inline const double& scale( const Index& i ) const
+      { return scales(i); }
+
+      /*! \brief Write the dense matrix in res. */
+      dg::Matrix& toDense( dg::Matrix& res ) const;
+      /*! \brief Write the rows of the represented matrix in J, starting at
+	row \a row. J should already have the correct number of columns. */
+      void writeRows( dg::Matrix& J,const Index& row ) const;
+      /*! \brief Compute res = S*M by gathering the rows of M. */
+      dg::Matrix& multiply( const dg::Matrix& M,dg::Matrix& res ) const;
+      /*! \brief Compute res = S*v. */
+      dg::Vector& multiply( const dg::Vector& v,dg::Vector& res ) const;
+
+      /*! \brief Copy the rows of other in this, starting at row \a row.
+	Both should have the same number of columns. */
+      void setRows( const Index& row,const SelectionJacobian& other );
+
+      SOT_CORE_EXPORT friend std::ostream&
+	operator<<( std::ostream& os,const SelectionJacobian& S );
+      SOT_CORE_EXPORT friend std::istream&
+	operator>>( std::istream& is,SelectionJacobian& S );
+    };
+
+  } // namespace sot
+} // namespace dynamicgraph
+
+#endif // #ifndef __SOT_SELECTION_JACOBIAN_HH__
@@ -0,0 +1,124 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SOT_SHM_RING_HH__
+#define __SOT_SHM_RING_HH__
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+/* SOT */
+#include <sot/core/api.hh>
+#include <sot/core/abstract-sot-external-interface-v2.hh>
+/* STD */
+#include <stdint.h>
+#include <string>
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+namespace dynamicgraph {
+  namespace sot {
+
+    /*!
+      \class ShmRing
+      \brief Single producer, single consumer ring of frames in POSIX shared
+      memory.
+
+      A frame is a sequence number and the values of an ExchangeBuffer. The
+      process creating the ring gives the layout of the buffer (names and
+      sizes of the blocks), which the other process reads back with
+      readLayout to address the blocks by handle.
+
+      The producer only writes the head index, the consumer only the tail
+      index: no lock is taken, and a full ring drops the new frame instead
+      of blocking the producer.
+    */
+    class SOT_CORE_EXPORT ShmRing
+    {
+    public:
+      ShmRing( void );
+      ~ShmRing( void );
+
+      /// Create the segment name (e.g. "/sot-sensors"), replacing a stale
+      /// one. capacity is rounded up to a power of 2.
+      void create( const std::string& name,const ExchangeBuffer& layout,
+                   const unsigned int& capacity );
+      /// Open a segment created by another process. Return false if it does
+      /// not exist or is not initialized yet.
+      bool open( const std::string& name );
+      /// Unmap the segment, and remove it if it was created here.
+      void close( void );
+      bool isOpen( void ) const { return NULL!=header; }
+
+      /// Producer side. Return false, and count the frame, if the ring is full.
+      bool push( const ExchangeBuffer& buffer,const uint64_t& seq );
+      /// Consumer side. Return false if the ring is empty.
+      bool pop( ExchangeBuffer& buffer,uint64_t& seq );
+      /// Consumer side: skip to the most recent frame. The number of frames
+      /// skipped is added to getSkippedCount.
+      bool popLatest( ExchangeBuffer& buffer,uint64_t& seq );
+
+      /// Rebuild in buffer the blocks of the creator's buffer.
+      void readLayout( ExchangeBuffer& buffer ) const;
+
+      unsigned int getCapacity( void ) const;
+      unsigned int getFrameSize( void ) const;
+      unsigned int getOverflowCount( void ) const { return overflows; }
+      unsigned int getSkippedCount( void ) const { return skipped; }
+
+    protected:
+      static const uint32_t MAGIC = 0x534f5452; // "SOTR"
+      static const std::size_t LAYOUT_SIZE = 4096;
+
+      struct Header
+      {
+        volatile uint32_t magic;
+        uint32_t frameSize;
+        uint32_t capacity;
+        char layout[LAYOUT_SIZE];
+        /* Head and tail on their own cache lines. */
+        char pad0[64];
+        volatile uint64_t head;
+        char pad1[64-sizeof(uint64_t)];
+        volatile uint64_t tail;
+        char pad2[64-sizeof(uint64_t)];
+      };
+
+      double* frame( const uint64_t& index );
+      void readFrame( const uint64_t& index,ExchangeBuffer& buffer,
+                      uint64_t& seq );
+
+      std::string name;
+      Header* header;
+      std::size_t mappedSize;
+      bool owner;
+      unsigned int overflows,skipped;
+    };
+
+  } // namespace sot
+} // namespace dynamicgraph
+
+
+#endif // #ifndef __SOT_SHM_RING_HH__
+
+/*
+ * Local variables:
+ * c-basic-offset: 2
+ * End:
+ */
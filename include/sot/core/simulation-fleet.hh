@@ -0,0 +1,91 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SOT_SIMULATION_FLEET_HH__
+#define __SOT_SIMULATION_FLEET_HH__
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+/* SOT */
+#include <dynamic-graph/linear-algebra.h>
+#include <sot/core/api.hh>
+/* BOOST */
+#include <boost/thread/mutex.hpp>
+/* STD */
+#include <vector>
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+namespace dynamicgraph {
+  namespace sot {
+
+    class Device;
+
+    /*!
+      \class SimulationFleet
+      \brief Step independent copies of a graph on a pool of threads.
+
+      Each thread takes the next copy not yet simulated, and runs all its
+      ticks: the copies do not share any signal, so that the threads only
+      share the index of the next copy. A copy whose increment throws is
+      stopped and counted as failed; its ticks are left out of the
+      statistics on the durations.
+    */
+    class SOT_CORE_EXPORT SimulationFleet
+    {
+    public:
+      /// rate is the number of ticks per second, 0 to run as fast as
+      /// possible.
+      SimulationFleet( const std::vector<Device*>& devices,
+                       const unsigned int& nbTicks,
+                       const double& dt,const double& rate );
+
+      void run( const unsigned int& nbThreads );
+
+      /// Durations of the ticks of the copies that did not fail, sorted.
+      std::vector<double> sortedDurations( void ) const;
+      /// Element of sorted at the fraction p of its length (nearest rank).
+      static double percentile( const std::vector<double>& sorted,
+                                const double& p );
+
+      /// Duration of each tick of each copy, copy after copy.
+      std::vector<double> durations;
+      /// Whether each copy failed.
+      std::vector<bool> failed;
+      /// Final states, one column per copy.
+      Matrix states;
+      unsigned int overruns,failures;
+
+    protected:
+      const std::vector<Device*>& devices_;
+      const unsigned int nbTicks_;
+      const double dt_;
+      const long period_;
+      std::size_t nextCopy_;
+      boost::mutex mutex_;
+
+      void work( void );
+      bool simulate( const std::size_t& copy,unsigned int& copyOverruns );
+    };
+
+  } // namespace sot
+} // namespace dynamicgraph
+
+#endif // #ifndef __SOT_SIMULATION_FLEET_HH__
@@ -37,6 +37,7 @@ namespace dg = dynamicgraph;
 #include <sot/core/flags.hh>
 #include <dynamic-graph/entity.h>
 #include <sot/core/constraint.hh>
+#include <sot/core/graph-executor.hh>
 
 /* --------------------------------------------------------------------- */
 /* --- API ------------------------------------------------------------- */
@@ -116,6 +117,10 @@ namespace dynamicgraph {
       /*! Force the recomputation at each step. */
       bool recomputeEachTime;
 
+      /*! \brief Parallel evaluation of the graph upstream of the control,
+	before the tasks are solved (see GraphExecutor). */
+      GraphExecutor executor;
+
     public:
 
       /*! \brief Threshold to compute the dumped pseudo inverse. */
@@ -114,8 +114,14 @@ class SOTTASK_EXPORT Task
   VectorMultiBound&
     computeTaskExponentialDecrease( VectorMultiBound& errorRef,int time );
   dg::Matrix& computeJacobian( dg::Matrix& J,int time );
+  SelectionJacobian& computeJacobianSelection( SelectionJacobian& J,int time );
   dg::Vector& computeErrorTimeDerivative( dg::Vector & res, int time);
 
+  /*! \brief True if all the features of the task provide a selection
+    Jacobian. In that case, jacobianSelectionSOUT can be used in place of
+    jacobianSOUT. */
+  bool withSelectionJacobian( void ) const;
+
 
   /* --- SIGNALS ------------------------------------------------------------ */
  public:
@@ -124,6 +130,7 @@ class SOTTASK_EXPORT Task
   dg::SignalPtr< Flags,int > controlSelectionSIN;
   dg::SignalTimeDependent< dg::Vector,int > errorSOUT;
   dg::SignalTimeDependent< dg::Vector,int > errorTimeDerivativeSOUT;
+  dg::SignalTimeDependent< SelectionJacobian,int > jacobianSelectionSOUT;
 
   /* --- DISPLAY ------------------------------------------------------------ */
   void display( std::ostream& os ) const;
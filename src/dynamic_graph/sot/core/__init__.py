@@ -6,6 +6,8 @@ from feature_position_relative import FeaturePositionRelative
 from feature_generic import FeatureGeneric
 from feature_joint_limits import FeatureJointLimits
 from feature_visual_point import FeatureVisualPoint
+from feature_visual_points import FeatureVisualPoints
+from feature_segment_distances import FeatureSegmentDistances
 from task import Task
 from task_pd import TaskPD
 from constraint import Constraint
@@ -17,5 +19,8 @@ from math_small_entities import *
 from visual_point_projecter import VisualPointProjecter
 from feature_visual_point import FeatureVisualPoint
 from kalman import Kalman
+from kalman_bank import KalmanBank
 from exp_moving_avg import ExpMovingAvg
+from biquad_cascade import BiquadCascade
+from savitzky_golay import SavitzkyGolay
 from gradient_ascent import GradientAscent
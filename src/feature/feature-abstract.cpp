@@ -48,13 +48,22 @@ FeatureAbstract( const std::string& name )
   ,jacobianSOUT( boost::bind(&FeatureAbstract::computeJacobian,this,_1,_2),
                  selectionSIN,
                  "sotFeatureAbstract("+name+")::output(matrix)::jacobian" )
+  ,jacobianSelectionSOUT( boost::bind(&FeatureAbstract::computeJacobianSelection,
+				      this,_1,_2),
+			  selectionSIN,
+			  "sotFeatureAbstract("+name+")::output(selection)::jacobianSelection" )
   ,dimensionSOUT( boost::bind(&FeatureAbstract::getDimension,this,_1,_2),
                   selectionSIN,
                   "sotFeatureAbstract("+name+")::output(uint)::dim" )
+  ,errorAll(),jacobianAll(),errordotAll()
+  ,errorAllAvailable(false),jacobianAllAvailable(false)
+  ,errordotAllAvailable(false),errordotAllRequested(false)
+  ,computeAllTime(-1),computeAllConsumed(0)
 {
   selectionSIN = true;
   signalRegistration( selectionSIN
-		      <<errorSOUT<<jacobianSOUT<<dimensionSOUT );
+		      <<errorSOUT<<jacobianSOUT<<jacobianSelectionSOUT
+		      <<dimensionSOUT );
   featureRegistration();
   initCommands();
 }
@@ -138,3 +147,88 @@ computeErrorDot( dynamicgraph::Vector& res,int time )
   
   return res; 
 }
+
+SelectionJacobian& FeatureAbstract::
+computeJacobianSelection( SelectionJacobian& res,int )
+{
+  SOT_THROW ExceptionFeature( ExceptionFeature::BAD_INIT,
+			      "No selection Jacobian for this feature.",
+			      " (while considering feature <%s>).",
+			      getName().c_str() );
+  return res;
+}
+
+/* --------------------------------------------------------------------- */
+/* --- FUSED EVALUATION ------------------------------------------------ */
+/* --------------------------------------------------------------------- */
+
+/* Nothing is shared by default: each output is then evaluated by its
+ * own method. */
+void FeatureAbstract::
+computeAll( int )
+{
+}
+
+void FeatureAbstract::
+enableComputeAll( void )
+{
+  enableComputeAll( boost::bind(&FeatureAbstract::computeErrorDot,this,_1,_2) );
+}
+
+void FeatureAbstract::
+enableComputeAll( const ErrorDotFunction& errordot )
+{
+  errordotAlone = errordot;
+  errorSOUT.setFunction( boost::bind(&FeatureAbstract::errorFromAll,
+				     this,_1,_2) );
+  jacobianSOUT.setFunction( boost::bind(&FeatureAbstract::jacobianFromAll,
+					this,_1,_2) );
+  errordotSOUT.setFunction( boost::bind(&FeatureAbstract::errordotFromAll,
+					this,_1,_2) );
+}
+
+/* An input failing upstream interrupts computeAll: the parts left
+ * unavailable then report the failure through their own method. */
+void FeatureAbstract::
+updateAll( int time,SharedOutput output )
+{
+  if( (time!=computeAllTime)||(computeAllConsumed&output) )
+    {
+      sotDEBUG(25) << "computeAll at time " << time << std::endl;
+      errorAllAvailable = jacobianAllAvailable = errordotAllAvailable = false;
+      computeAllConsumed = 0;
+      computeAllTime = time;
+      try { computeAll( time ); }
+      catch( const dynamicgraph::ExceptionAbstract& ) {}
+      catch( const dynamicgraph::sot::ExceptionAbstract& ) {}
+    }
+  computeAllConsumed |= output;
+}
+
+dynamicgraph::Vector& FeatureAbstract::
+errorFromAll( dynamicgraph::Vector& res,int time )
+{
+  updateAll( time,SHARED_ERROR );
+  if( errorAllAvailable ) res = errorAll; else computeError( res,time );
+  return res;
+}
+
+dynamicgraph::Matrix& FeatureAbstract::
+jacobianFromAll( dynamicgraph::Matrix& res,int time )
+{
+  updateAll( time,SHARED_JACOBIAN );
+  if( jacobianAllAvailable ) res = jacobianAll; else computeJacobian( res,time );
+  return res;
+}
+
+/* The first read of errordotSOUT finds a shared result computed without
+ * the derivative: it is evaluated alone, and shared from the next time
+ * on. */
+dynamicgraph::Vector& FeatureAbstract::
+errordotFromAll( dynamicgraph::Vector& res,int time )
+{
+  errordotAllRequested = true;
+  updateAll( time,SHARED_ERRORDOT );
+  if( errordotAllAvailable ) res = errordotAll; else errordotAlone( res,time );
+  return res;
+}
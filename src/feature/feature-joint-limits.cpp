@@ -58,6 +58,10 @@ FeatureJointLimits( const string& fName )
   errorSOUT.addDependency( upperJlSIN );
   errorSOUT.addDependency( lowerJlSIN );
 
+  jacobianSelectionSOUT.addDependency( jointSIN );
+  jacobianSelectionSOUT.addDependency( widthJlSINTERN );
+  jacobianSOUT.addDependency( jacobianSelectionSOUT );
+
   signalRegistration( jointSIN<<upperJlSIN<<lowerJlSIN<<widthJlSINTERN );
 
   // Commands
@@ -102,56 +106,51 @@ FeatureJointLimits::computeWidthJl( Vector& res,const int& time )
 {
   sotDEBUGIN(15);
 
-  const Vector UJL = upperJlSIN.access(time);
-  const Vector LJL = lowerJlSIN.access(time);
-  const Vector::Index SIZE=UJL.size();
-  res.resize(SIZE);
-
-  for( Vector::Index i=0;i<SIZE;++i )
-    {      res(i)=UJL(i)-LJL(i);    }
+  const Vector& UJL = upperJlSIN.access(time);
+  const Vector& LJL = lowerJlSIN.access(time);
+  res = UJL-LJL;
 
   sotDEBUGOUT(15);
   return res;
 }
 
 /** Compute the interaction matrix from a subset of
- * the possible features.
+ * the possible features. The matrix is a scaled selection of the
+ * joints: its dense form is only built from the selection.
  */
 Matrix& FeatureJointLimits::
 computeJacobian( Matrix& J,int time )
 {
   sotDEBUG(15)<<"# In {"<<endl;
 
+  jacobianSelectionSOUT.access(time).toDense(J);
+
+  sotDEBUG(15)<<"# Out }"<<endl;
+  return J;
+}
+
+SelectionJacobian& FeatureJointLimits::
+computeJacobianSelection( SelectionJacobian& J,int time )
+{
+  sotDEBUG(15)<<"# In {"<<endl;
+
   const unsigned int SIZE=dimensionSOUT.access(time);
-  const Vector q = jointSIN.access(time);
+  const Vector& q = jointSIN.access(time);
   const Flags &fl = selectionSIN(time);
-  //const unsigned int SIZE_FF=SIZE+freeFloatingSize;
   const Vector::Index SIZE_TOTAL=q.size();
-  const Vector WJL = widthJlSINTERN.access(time);
-  J.resize( SIZE,SIZE_TOTAL ); J.setZero();
+  const Vector& WJL = widthJlSINTERN.access(time);
+  J.resize( SIZE,SIZE_TOTAL );
 
   unsigned int idx=0;
   for( unsigned int i=0;i<SIZE_TOTAL;++i )
     {
       if( fl(i) )
 	{
-	  if( fabs(WJL(i))>1e-3 ) J(idx,i)=1/WJL(i);
-	  else J(idx,i)=1.;
+	  if( fabs(WJL(i))>1e-3 ) J.set(idx,i,1/WJL(i));
+	  else J.set(idx,i,1.);
 	  idx++;
 	}
     }
-//   if( 0!=freeFloatingIndex )
-//     for( unsigned int i=0;i<freeFloatingIndex;++i )
-//       {
-// 	if( fabs(WJL(i))>1e-3 ) J(i,i)=1/WJL(i); else J(i,i)=1.;
-//       }
-
-//   if( SIZE!=freeFloatingIndex )
-//     for( unsigned int i=freeFloatingIndex;i<SIZE;++i )
-//       {
-// 	if( fabs(WJL(i))>1e-3 ) J(i,i+freeFloatingSIZE)=1/WJL(i);
-// 	else J(i,i)=1.;
-//       }
 
   sotDEBUG(15)<<"# Out }"<<endl;
   return J;
@@ -166,10 +165,10 @@ FeatureJointLimits::computeError( Vector& error,int time )
   sotDEBUGIN(15);
 
   const Flags &fl = selectionSIN(time);
-  const Vector q = jointSIN.access(time);
-  const Vector UJL = upperJlSIN.access(time);
-  const Vector LJL = lowerJlSIN.access(time);
-  const Vector WJL = widthJlSINTERN.access(time);
+  const Vector& q = jointSIN.access(time);
+  const Vector& UJL = upperJlSIN.access(time);
+  const Vector& LJL = lowerJlSIN.access(time);
+  const Vector& WJL = widthJlSINTERN.access(time);
   const int SIZE=dimensionSOUT.access(time);
   const Vector::Index SIZE_TOTAL=q.size();
 
@@ -51,6 +51,8 @@ FeaturePoint6dRelative( const string& pointName )
   ,articularJacobianReferenceSIN( NULL,"sotFeaturePoint6dRelative("+name+")::input(matrix)::JqRef" )
   ,dotpositionSIN(NULL,"sotFeaturePoint6dRelative("+name+")::input(matrixHomo)::dotposition" )
   ,dotpositionReferenceSIN(NULL,"sotFeaturePoint6dRelative("+name+")::input(matrixHomo)::dotpositionRef" )
+  ,pMpref_()
+  ,J_()
 {
   jacobianSOUT.addDependency( positionReferenceSIN );
   jacobianSOUT.addDependency( articularJacobianReferenceSIN );
@@ -65,8 +67,8 @@ FeaturePoint6dRelative( const string& pointName )
 		      dotpositionReferenceSIN <<
 		      errordotSOUT );
 
-  errordotSOUT.setFunction (boost::bind (&FeaturePoint6dRelative::computeErrordot,
-					 this, _1, _2));
+  /* errordotSOUT is bound to computeErrordot through the shared result, by
+   * the constructor of FeaturePoint6d. */
   initCommands();
 }
 
@@ -76,6 +78,16 @@ FeaturePoint6dRelative( const string& pointName )
 /* --------------------------------------------------------------------- */
 
 
+/* Placement of the reference point in the frame of the point. */
+void FeaturePoint6dRelative::
+computeRelativePlacement( MatrixHomogeneous& pMpref,int time )
+{
+  const MatrixHomogeneous & wMp = positionSIN(time);
+  const MatrixHomogeneous & wMpref = positionReferenceSIN(time);
+
+  pMpref = wMp.inverse(Eigen::Affine)*wMpref;
+}
+
 /** Compute the interaction matrix from a subset of
  * the possible features.
  */
@@ -84,38 +96,33 @@ computeJacobian( Matrix& Jres,int time )
 {
   sotDEBUG(15)<<"# In {"<<endl;
 
+  computeRelativePlacement( pMpref_,time );
+  jacobianFromPlacement( pMpref_,Jres,time );
+
+  sotDEBUG(15)<<"# Out }"<<endl;
+  return Jres;
+}
+
+void FeaturePoint6dRelative::
+jacobianFromPlacement( const MatrixHomogeneous& pMpref,Matrix& Jres,int time )
+{
   const Matrix & Jq = articularJacobianSIN(time);
   const Matrix & JqRef = articularJacobianReferenceSIN(time);
-  const MatrixHomogeneous & wMp = positionSIN(time);
-  const MatrixHomogeneous & wMpref = positionReferenceSIN(time);
 
   const Matrix::Index cJ = Jq.cols();
-  Matrix J(6,cJ);
-  {
-    MatrixHomogeneous pMw;  pMw = wMp.inverse(Eigen::Affine);
-    MatrixHomogeneous pMpref; pMpref= pMw*wMpref;
-
-    MatrixTwist pVpref;    buildFrom(pMpref, pVpref );
-    J = pVpref*JqRef;
-    J -= Jq;
-  }
+  MatrixTwist pVpref;    buildFrom(pMpref, pVpref );
+  J_.resize(6,cJ);
+  J_.noalias() = pVpref*JqRef;
+  J_ -= Jq;
 
   const Flags &fl = selectionSIN(time);
   const int dim = dimensionSOUT(time);
   sotDEBUG(15) <<"Dimension="<<dim<<std::endl;
   Jres.resize(dim,cJ) ;
 
-  unsigned int rJ = 0;
+  Matrix::Index rJ = 0;
   for( unsigned int r=0;r<6;++r )
-    if( fl(r) )
-      {
-	for( unsigned int c=0;c<cJ;++c )
-	  Jres(rJ,c)=J(r,c);
-	rJ ++;
-      }
-
-  sotDEBUG(15)<<"# Out }"<<endl;
-  return Jres;
+    if( fl(r) ) Jres.row(rJ++) = J_.row(r);
 }
 
 /** Compute the error between two visual features from a subset
@@ -126,15 +133,16 @@ FeaturePoint6dRelative::computeError( Vector& error,int time )
 {
   sotDEBUGIN(15);
 
-//   /* TODO */
-//   error.resize(6); error.fill(.0);
+  computeRelativePlacement( pMpref_,time );
+  errorFromPlacement( pMpref_,error,time );
 
-  const MatrixHomogeneous & wMp = positionSIN(time);
-  const MatrixHomogeneous & wMpref = positionReferenceSIN(time);
-
-  MatrixHomogeneous pMw;  pMw = wMp.inverse(Eigen::Affine);
-  MatrixHomogeneous pMpref; pMpref = pMw*wMpref;
+  sotDEBUGOUT(15);
+  return error ;
+}
 
+void FeaturePoint6dRelative::
+errorFromPlacement( const MatrixHomogeneous& pMpref,Vector& error,int time )
+{
   MatrixHomogeneous Merr;
   try
     {
@@ -174,9 +182,34 @@ FeaturePoint6dRelative::computeError( Vector& error,int time )
     { if( fl(i) ) error(cursor++) = Merr(i,3); }
   for( unsigned int i=0;i<3;++i )
     { if( fl(i+3) ) error(cursor++) = rerr.angle()*rerr.axis()(i); }
+}
+
+/* The relative placement pMpref is shared by the error and the Jacobian. */
+void FeaturePoint6dRelative::
+computeAll( int time )
+{
+  sotDEBUGIN(15);
+
+  if( !positionSIN.isPlugged()||!positionReferenceSIN.isPlugged() ) return;
+
+  computeRelativePlacement( pMpref_,time );
+  errorFromPlacement( pMpref_,errorAll,time );
+  errorAllAvailable = true;
+
+  if( articularJacobianSIN.isPlugged()
+      &&articularJacobianReferenceSIN.isPlugged() )
+    {
+      jacobianFromPlacement( pMpref_,jacobianAll,time );
+      jacobianAllAvailable = true;
+    }
+
+  if( errordotAllRequested && errordotPlugged() )
+    {
+      errordotFromError( errordotAll,time );
+      errordotAllAvailable = true;
+    }
 
   sotDEBUGOUT(15);
-  return error ;
 }
 
 /** Compute the error between two visual features from a subset
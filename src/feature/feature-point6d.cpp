@@ -62,7 +62,7 @@ FeaturePoint6d( const string& pointName )
     ,articularJacobianSIN( NULL,"sotFeaturePoint6d("+name+")::input(matrix)::Jq" )
   , error_th_ (),
     R_ (), Rref_ (), Rt_ (), Rreft_ (), P_ (3, 3), Pinv_ (3, 3),
-    accuracy_ (1e-8)
+    accuracy_ (1e-8), hMhd_ (), LJq_ ()
 {
   jacobianSOUT.addDependency( positionSIN );
   jacobianSOUT.addDependency( articularJacobianSIN );
@@ -71,8 +71,8 @@ FeaturePoint6d( const string& pointName )
 
   signalRegistration( positionSIN<<articularJacobianSIN );
   signalRegistration (errordotSOUT << velocitySIN);
-  errordotSOUT.setFunction (boost::bind (&FeaturePoint6d::computeErrordot,
-					 this, _1, _2));
+  enableComputeAll (boost::bind (&FeaturePoint6d::computeErrordot,
+				 this, _1, _2));
   errordotSOUT.addDependency (velocitySIN);
   errordotSOUT.addDependency (positionSIN);
   errordotSOUT.addDependency (errorSOUT);
@@ -178,6 +178,46 @@ getDimension( unsigned int & dim, int time )
 }
 
 
+/* Placement of the reference in the computation frame: hMhd in the
+ * current frame, hdMh in the desired frame. The error, its Jacobian and
+ * the derivative of the error are all expressed from it. */
+void FeaturePoint6d::
+computeRelativePosition( MatrixHomogeneous& hMhd,int time )
+{
+  const MatrixHomogeneous& wMh = positionSIN(time);
+  sotDEBUG(15)<<"wMh = "<<wMh<<endl;
+
+  /* Computing only translation:                                        *
+   * trans( hMw wMhd ) = htw + hRw wthd                                 *
+   *                   = -hRw wth + hrW wthd                            *
+   *                   = hRw ( wthd - wth )                             *
+   * The second line is obtained by writting hMw as the inverse of wMh. */
+
+  if(isReferenceSet())
+    {
+      const MatrixHomogeneous& wMhd = getReference()->positionSIN(time);
+      sotDEBUG(15)<<"wMhd = "<<wMhd<<endl;
+      switch(computationFrame_)
+        {
+        case FRAME_CURRENT:
+          hMhd = wMh.inverse(Eigen::Affine)*wMhd; break;
+        case FRAME_DESIRED:
+          hMhd = wMhd.inverse(Eigen::Affine)*wMh; break; // Compute hdMh indeed.
+        };
+    }
+  else
+    {
+      switch(computationFrame_)
+        {
+        case FRAME_CURRENT:
+          hMhd=wMh.inverse(); break;
+        case FRAME_DESIRED:
+          hMhd=wMh; break; // Compute hdMh indeed.
+        };
+    }
+  sotDEBUG(15)<<"hMhd = "<<hMhd<<endl;
+}
+
 /** Compute the interaction matrix from a subset of
  * the possible features.
  */
@@ -186,8 +226,18 @@ computeJacobian( Matrix& J,int time )
 {
   sotDEBUG(15)<<"# In {"<<endl;
 
+  computeRelativePosition( hMhd_,time );
+  jacobianFromRelativePosition( hMhd_,J,time );
+
+  sotDEBUG(15)<<"# Out }"<<endl;
+  return J;
+}
+
+void FeaturePoint6d::
+jacobianFromRelativePosition( const MatrixHomogeneous& hMhd,Matrix& J,int time )
+{
   const Matrix & Jq = articularJacobianSIN(time);
-  const int & dim = dimensionSOUT(time);
+  const unsigned int & dim = dimensionSOUT(time);
   const Flags &fl = selectionSIN(time);
 
   sotDEBUG(25)<<"dim = "<<dimensionSOUT(time)<<" time:" << time << " "
@@ -198,100 +248,45 @@ computeJacobian( Matrix& J,int time )
   sotDEBUG(15) <<"Dimension="<<dim<<std::endl;
 
   const Matrix::Index cJ = Jq.cols();
-  J.resize(dim,cJ) ;
-  Matrix LJq(6,cJ);
+  LJq_.resize(6,cJ);
 
   if( FRAME_CURRENT==computationFrame_ )
     {
       /* The Jacobian on rotation is equal to Jr = - hdRh Jr6d.
-       * The Jacobian in translation is equalt to Jt = [hRw(wthd-wth)]x Jr - Jt. */
-      const MatrixHomogeneous& wMh = positionSIN(time);
-      MatrixRotation wRh;      wRh = wMh.linear();
-      MatrixRotation wRhd;
-      Vector hdth(3),Rhdth(3);
-
-      if( isReferenceSet() )
-        {
-          const MatrixHomogeneous& wMhd = getReference()->positionSIN(time);
-          wRhd = wMhd.linear();
-          for( unsigned int i=0;i<3;++i ) hdth(i)=wMhd(i,3)-wMh(i,3);
-        }
-      else
-        {
-          wRhd.setIdentity();
-          for( unsigned int i=0;i<3;++i ) hdth(i)=-wMh(i,3);
-        }
-      Rhdth=(wRh.inverse())*hdth;
-      MatrixRotation hdRh; hdRh = (wRhd.inverse())*wRh;
-
-      Matrix Lx(6,6);
-      for(unsigned int i=0;i<3;i++)
-	{for(unsigned int j=0;j<3;j++)
-            {
-              if( i==j) { Lx(i,j)=-1; } else { Lx(i,j)=0; }
-              Lx(i+3,j)=0;
-              Lx(i+3,j+3)=-hdRh(i,j);
-            }
-        }
-      const double & X=Rhdth(0), &Y=Rhdth(1), &Z=Rhdth(2);
-      Lx(0,4) = -Z ;      Lx(0,5) =  Y ;       Lx(1,3) = Z ;
-      Lx(1,5) = -X ;      Lx(2,3) = -Y ;       Lx(2,4) = X ;
-      Lx(0,3) =  0 ;      Lx(1,4) =  0 ;       Lx(2,5) = 0 ;
+       * The Jacobian in translation is equalt to Jt = [hRw(wthd-wth)]x Jr - Jt.
+       * hRw(wthd-wth) is the translation of hMhd, hdRh its rotation
+       * transposed. */
+      const Eigen::Vector3d Rhdth = hMhd.translation();
+      MatrixRotation hdRh; hdRh = hMhd.linear().transpose();
+
+      Eigen::Matrix3d Lx;
+      Lx <<      0.,-Rhdth(2), Rhdth(1),
+	   Rhdth(2),       0.,-Rhdth(0),
+	  -Rhdth(1), Rhdth(0),       0.;
       sotDEBUG(15) << "Lx= "<<Lx<<endl;
 
-      LJq=Lx*Jq;
+      LJq_.topRows(3).noalias() = Lx*Jq.middleRows(3,3);
+      LJq_.topRows(3) -= Jq.topRows(3);
+      LJq_.bottomRows(3).noalias() = -hdRh*Jq.middleRows(3,3);
     }
   else
     {
       /* The Jacobian in rotation is equal to Jr = hdJ = hdRh Jr.
-       * The Jacobian in translation is equal to Jr = hdJ = hdRh Jr. */
-      const MatrixHomogeneous& wMh = positionSIN(time);
-      MatrixRotation wRh; wRh = wMh.linear();
-      MatrixRotation hdRh;
+       * The Jacobian in translation is equal to Jr = hdJ = hdRh Jr.
+       * hdRh is the rotation of hdMh. */
+      MatrixRotation hdRh; hdRh = hMhd.linear();
 
-      if( isReferenceSet() )
-        {
-          const MatrixHomogeneous& wMhd = getReference()->positionSIN(time);
-          MatrixRotation wRhd; wRhd = wMhd.linear();
-          hdRh = (wRhd.inverse())*wRh;
-        }
-      else
-        { hdRh = wRh; }
-
-       LJq.fill(0);
-       for(unsigned int i=0;i<3;i++)
-         for(unsigned int j=0;j<cJ;j++)
-           {
-             for(unsigned int k=0;k<3;k++)
-               {
-                 LJq(i,j)+=hdRh(i,k)*Jq(k,j);
-                 LJq(i+3,j)+=hdRh(i,k)*Jq(k+3,j);
-               }
-           }
+      LJq_.topRows(3).noalias() = hdRh*Jq.topRows(3);
+      LJq_.bottomRows(3).noalias() = hdRh*Jq.middleRows(3,3);
     }
 
   /* Select the active line of Jq. */
-  unsigned int rJ = 0;
+  J.resize(dim,cJ) ;
+  Matrix::Index rJ = 0;
   for( unsigned int r=0;r<6;++r )
-    if( fl(r) )
-      {
-	for( unsigned int c=0;c<cJ;++c )
-	  J(rJ,c)=LJq(r,c);
-	rJ ++;
-      }
-
-  sotDEBUG(15)<<"# Out }"<<endl;
-  return J;
+    if( fl(r) ) J.row(rJ++) = LJq_.row(r);
 }
 
-#define SOT_COMPUTE_H1MH2(wMh,wMhd,hMhd) {			\
-    MatrixHomogeneous hMw; hMw = wMh.inverse(Eigen::Affine);	\
-    sotDEBUG(15)<<"hMw = "<<hMw<<endl;				\
-    hMhd = hMw * wMhd;						\
-    sotDEBUG(15)<<"hMhd = "<<hMhd<<endl;			\
-  }
-
-
 /** Compute the error between two visual features from a subset
  * a the possible features.
  */
@@ -300,39 +295,17 @@ FeaturePoint6d::computeError( Vector& error,int time )
 {
   sotDEBUGIN(15);
 
-  const Flags &fl = selectionSIN(time);
-  const MatrixHomogeneous& wMh = positionSIN(time);
-  sotDEBUG(15)<<"wMh = "<<wMh<<endl;
+  computeRelativePosition( hMhd_,time );
+  errorFromRelativePosition( hMhd_,error,time );
 
-  /* Computing only translation:                                        *
-   * trans( hMw wMhd ) = htw + hRw wthd                                 *
-   *                   = -hRw wth + hrW wthd                            *
-   *                   = hRw ( wthd - wth )                             *
-   * The second line is obtained by writting hMw as the inverse of wMh. */
+  sotDEBUGOUT(15);
+  return error ;
+}
 
-  MatrixHomogeneous hMhd;
-  if(isReferenceSet())
-    {
-      const MatrixHomogeneous& wMhd = getReference()->positionSIN(time);
-      sotDEBUG(15)<<"wMhd = "<<wMhd<<endl;
-      switch(computationFrame_)
-        {
-        case FRAME_CURRENT:
-          SOT_COMPUTE_H1MH2(wMh,wMhd,hMhd); break;
-        case FRAME_DESIRED:
-          SOT_COMPUTE_H1MH2(wMhd,wMh,hMhd); break; // Compute hdMh indeed.
-        };
-    }
-  else
-    {
-      switch(computationFrame_)
-        {
-        case FRAME_CURRENT:
-          hMhd=wMh.inverse(); break;
-        case FRAME_DESIRED:
-          hMhd=wMh; break; // Compute hdMh indeed.
-        };
-    }
+void FeaturePoint6d::
+errorFromRelativePosition( const MatrixHomogeneous& hMhd,Vector& error,int time )
+{
+  const Flags &fl = selectionSIN(time);
 
   sotDEBUG(25)<<"dim = "<<dimensionSOUT(time)<<" time:" << time << " "
               << dimensionSOUT.getTime() << " " << dimensionSOUT.getReady() << endl;
@@ -353,9 +326,37 @@ FeaturePoint6d::computeError( Vector& error,int time )
 	  error(cursor++) = error_th_.angle()*error_th_.axis()(i);
       }
     }
+}
+
+/* The placement hMhd and the rotation error are computed once for the
+ * error and the Jacobian. A missing input only disables the parts that
+ * need it. */
+void FeaturePoint6d::
+computeAll( int time )
+{
+  sotDEBUGIN(15);
+
+  if( !positionSIN.isPlugged()
+      ||( isReferenceSet()&&!getReference()->positionSIN.isPlugged() ) )
+    return;
+
+  computeRelativePosition( hMhd_,time );
+  errorFromRelativePosition( hMhd_,errorAll,time );
+  errorAllAvailable = true;
+
+  if( articularJacobianSIN.isPlugged() )
+    {
+      jacobianFromRelativePosition( hMhd_,jacobianAll,time );
+      jacobianAllAvailable = true;
+    }
+
+  if( errordotAllRequested && errordotPlugged() )
+    {
+      errordotFromError( errordotAll,time );
+      errordotAllAvailable = true;
+    }
 
   sotDEBUGOUT(15);
-  return error ;
 }
 
 void FeaturePoint6d::inverseJacobianRodrigues ()
@@ -393,6 +394,22 @@ void FeaturePoint6d::inverseJacobianRodrigues ()
 }
 
 Vector& FeaturePoint6d::computeErrordot( Vector& errordot,int time )
+{
+  if(isReferenceSet()) errorSOUT.recompute (time);
+  errordotFromError( errordot,time );
+  return errordot;
+}
+
+bool FeaturePoint6d::
+errordotPlugged( void )
+{
+  return !isReferenceSet()
+    ||( positionSIN.isPlugged()&&getReference()->velocitySIN.isPlugged()
+	&&getReference()->positionSIN.isPlugged() );
+}
+
+void FeaturePoint6d::
+errordotFromError( Vector& errordot,int time )
 {
   if(isReferenceSet()) {
     const Vector& velocity = getReference()->velocitySIN(time);
@@ -412,7 +429,6 @@ Vector& FeaturePoint6d::computeErrordot( Vector& errordot,int time )
     Rref_ = Mref.linear();
     tref_= Mref.translation();
     Rreft_ = Rref_.transpose ();
-    errorSOUT.recompute (time);
     inverseJacobianRodrigues ();
     switch (computationFrame_) {
     case FRAME_CURRENT:
@@ -448,8 +464,6 @@ Vector& FeaturePoint6d::computeErrordot( Vector& errordot,int time )
       }
     }
   }
-
-  return errordot;
 }
 
 
@@ -107,6 +107,12 @@ namespace dynamicgraph {
     }
 
     dg::Matrix& FeaturePosture::computeJacobian( dg::Matrix& res, int )
+    {
+      return jacobian_.toDense (res);
+    }
+
+    SelectionJacobian& FeaturePosture::
+    computeJacobianSelection( SelectionJacobian& res, int )
     {
       res = jacobian_;
       return res;
@@ -174,12 +180,11 @@ namespace dynamicgraph {
       }
       // recompute jacobian
       jacobian_.resize (nbActiveDofs_, dim);
-      jacobian_.setZero ();
 
       std::size_t index=0;
       for (std::size_t i=0; i<activeDofs_.size (); ++i) {
 	if (activeDofs_ [i]) {
-	  jacobian_ (index, i) = 1;
+	  jacobian_.set (index, i);
 	  index ++;
 	}
       }
@@ -0,0 +1,234 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+/* --- SOT --- */
+#include <sot/core/debug.hh>
+#include <sot/core/feature-segment-distances.hh>
+#include <sot/core/exception-feature.hh>
+
+using namespace std;
+
+using namespace dynamicgraph::sot;
+using namespace dynamicgraph;
+
+#include <sot/core/factory.hh>
+DYNAMICGRAPH_FACTORY_ENTITY_PLUGIN(FeatureSegmentDistances,"FeatureSegmentDistances");
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+static const double EPSILON = 1e-12;
+
+FeatureSegmentDistances::
+FeatureSegmentDistances( const string& name )
+  : FeatureAbstract( name )
+    ,activePairs()
+    ,segmentsSIN( NULL,"sotFeatureSegmentDistances("+name+")::input(matrix)::segments" )
+    ,radiiSIN( NULL,"sotFeatureSegmentDistances("+name+")::input(vector)::radii" )
+    ,jacobiansSIN( NULL,"sotFeatureSegmentDistances("+name+")::input(matrix)::Jq" )
+    ,activationDistanceSIN( NULL,"sotFeatureSegmentDistances("+name+")::input(double)::activationDistance" )
+    ,distancesSOUT( boost::bind(&FeatureSegmentDistances::computeDistances,this,_1,_2),
+		    segmentsSIN<<radiiSIN,
+		    "sotFeatureSegmentDistances("+name+")::output(vector)::distances" )
+    ,activeSOUT( boost::bind(&FeatureSegmentDistances::computeActiveSet,this,_1,_2),
+		 distancesSOUT<<activationDistanceSIN<<selectionSIN,
+		 "sotFeatureSegmentDistances("+name+")::output(vector)::active" )
+{
+  activationDistanceSIN = .1;
+
+  dimensionSOUT.addDependency( activeSOUT );
+
+  jacobianSOUT.addDependency( activeSOUT );
+  jacobianSOUT.addDependency( jacobiansSIN );
+
+  errorSOUT.addDependency( activeSOUT );
+
+  signalRegistration( segmentsSIN<<radiiSIN<<jacobiansSIN
+		      <<activationDistanceSIN<<distancesSOUT<<activeSOUT );
+}
+
+
+/* --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+unsigned int& FeatureSegmentDistances::
+getDimension( unsigned int & dim, int time )
+{
+  sotDEBUG(25)<<"# In {"<<endl;
+
+  dim = static_cast<unsigned int>( activeSOUT(time).size() );
+
+  sotDEBUG(25)<<"# Out }"<<endl;
+  return dim;
+}
+
+/* --------------------------------------------------------------------- */
+/* Closest points between segments [A0,A1] and [B0,B1] (see Ericson,
+ * Real-Time Collision Detection, 5.1.9), written with array expressions
+ * over all the pairs instead of a loop of branches. The work arrays are
+ * members: they are only reallocated when the number of pairs changes. */
+Vector& FeatureSegmentDistances::
+computeDistances( Vector& res,int time )
+{
+  sotDEBUGIN(15);
+
+  const Matrix& seg = segmentsSIN(time);
+  if( seg.cols()!=12 )
+    { throw(ExceptionFeature(ExceptionFeature::UNCOMPATIBLE_SIZE,
+			     "segments should be a P x 12 matrix",
+			     " (got %d columns).",(int)seg.cols())); }
+  const Matrix::Index P = seg.rows();
+
+  d1 = seg.middleCols(3,3)-seg.middleCols(0,3);
+  d2 = seg.middleCols(9,3)-seg.middleCols(6,3);
+  r  = seg.middleCols(0,3)-seg.middleCols(6,3);
+
+  a = d1.rowwise().squaredNorm().array();
+  e = d2.rowwise().squaredNorm().array();
+  b = (d1.array()*d2.array()).rowwise().sum();
+  c = (d1.array()*r.array()).rowwise().sum();
+  f = (d2.array()*r.array()).rowwise().sum();
+
+  /* General case: closest points of the lines, then clamp. */
+  s = (a*e-b*b > EPSILON).select
+    ( ((b*f-c*e)/(a*e-b*b).max(EPSILON)).max(0.).min(1.), 0. );
+  t = (b*s+f)/e.max(EPSILON);
+  s = (t<0.).select( (-c/a.max(EPSILON)).max(0.).min(1.),
+		     (t>1.).select( ((b-c)/a.max(EPSILON)).max(0.).min(1.), s ) );
+  t = t.max(0.).min(1.);
+
+  /* Degenerate segments reduced to a point. */
+  s = (e<=EPSILON).select( (-c/a.max(EPSILON)).max(0.).min(1.), s );
+  t = (e<=EPSILON).select( Eigen::ArrayXd::Zero(P), t );
+  t = (a<=EPSILON).select( (f/e.max(EPSILON)).max(0.).min(1.), t );
+  s = (a<=EPSILON).select( Eigen::ArrayXd::Zero(P), s );
+
+  closestA = seg.middleCols(0,3) + (d1.array().colwise()*s).matrix();
+  closestB = seg.middleCols(6,3) + (d2.array().colwise()*t).matrix();
+  normals = closestA-closestB;
+
+  res = normals.rowwise().norm();
+  normals.array().colwise() /= res.array().max(EPSILON);
+
+  if( radiiSIN.isPlugged() )
+    {
+      const Vector& radii = radiiSIN(time);
+      if( radii.size()!=P )
+	{ throw(ExceptionFeature(ExceptionFeature::UNCOMPATIBLE_SIZE,
+				 "radii should have one entry per pair",
+				 " (%d instead of %d).",(int)radii.size(),(int)P)); }
+      res -= radii;
+    }
+
+  sotDEBUGOUT(15);
+  return res;
+}
+
+Vector& FeatureSegmentDistances::
+computeActiveSet( Vector& res,int time )
+{
+  sotDEBUGIN(15);
+
+  const Vector& dist = distancesSOUT(time);
+  const double& activation = activationDistanceSIN(time);
+  const Flags& fl = selectionSIN(time);
+
+  activePairs.clear();
+  for( Matrix::Index k=0;k<dist.size();++k )
+    if( fl(static_cast<int>(k)) && dist(k)<activation )
+      activePairs.push_back(k);
+
+  res.resize( activePairs.size() );
+  for( std::size_t i=0;i<activePairs.size();++i )
+    res(i) = static_cast<double>(activePairs[i]);
+
+  sotDEBUGOUT(15);
+  return res;
+}
+
+/* --------------------------------------------------------------------- */
+/** Compute the interaction matrix from a subset of
+ * the possible features.
+ */
+Matrix& FeatureSegmentDistances::
+computeJacobian( Matrix& J,int time )
+{
+  sotDEBUG(15)<<"# In {"<<endl;
+
+  activeSOUT(time);
+  const Matrix& seg = segmentsSIN(time);
+  const Matrix& Jq = jacobiansSIN(time);
+  if( Jq.rows()!=12*seg.rows() )
+    { throw(ExceptionFeature(ExceptionFeature::UNCOMPATIBLE_SIZE,
+			     "Jq should have 12 rows per pair",
+			     " (%d rows for %d pairs).",
+			     (int)Jq.rows(),(int)seg.rows())); }
+
+  /* The closest points are stationary, so the derivative of the distance
+   * is the relative velocity of the closest points along the normal:
+   * n^T (vA + wA x rA) = [ n^T (rA x n)^T ] JA, and the same for B. */
+  J.resize( activePairs.size(),Jq.cols() );
+  Eigen::Matrix<double,1,12> coefs;
+  for( std::size_t i=0;i<activePairs.size();++i )
+    {
+      const Matrix::Index k = activePairs[i];
+      const Eigen::Vector3d n = normals.row(k).transpose();
+      const Eigen::Vector3d rA
+	= ( closestA.row(k)-seg.block<1,3>(k,0) ).transpose();
+      const Eigen::Vector3d rB
+	= ( closestB.row(k)-seg.block<1,3>(k,6) ).transpose();
+
+      coefs.segment<3>(0) = n.transpose();
+      coefs.segment<3>(3) = rA.cross(n).transpose();
+      coefs.segment<3>(6) = -n.transpose();
+      coefs.segment<3>(9) = -rB.cross(n).transpose();
+      J.row(i).noalias() = coefs*Jq.middleRows(12*k,12);
+    }
+
+  sotDEBUG(15)<<"# Out }"<<endl;
+  return J;
+}
+
+/** Compute the error as the distances of the active pairs.
+ */
+Vector&
+FeatureSegmentDistances::computeError( Vector& error,int time )
+{
+  sotDEBUGIN(15);
+
+  activeSOUT(time);
+  const Vector& dist = distancesSOUT(time);
+
+  error.resize( activePairs.size() );
+  for( std::size_t i=0;i<activePairs.size();++i )
+    error(i) = dist( activePairs[i] );
+
+  sotDEBUGOUT(15);
+  return error ;
+}
+
+void FeatureSegmentDistances::
+display( std::ostream& os ) const
+{
+  os <<"SegmentDistances <"<<name<<">: " << activePairs.size()
+     << " active pairs";
+}
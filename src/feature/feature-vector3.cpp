@@ -59,6 +59,7 @@ FeatureVector3( const string& pointName )
 
   signalRegistration( vectorSIN<<positionSIN
                       <<articularJacobianSIN<<positionRefSIN );
+  enableComputeAll();
 }
 
 
@@ -90,26 +91,27 @@ computeJacobian( Matrix& J,int time )
   const MatrixHomogeneous & M = positionSIN(time);
   MatrixRotation R; R = M.linear();
 
-  Matrix Skew(3,3);
-  Skew( 0,0 ) = 0        ; Skew( 0,1 )=-vect( 2 );  Skew( 0,2 ) = vect( 1 );
-  Skew( 1,0 ) = vect( 2 ); Skew( 1,1 )= 0        ;  Skew( 1,2 ) =-vect( 0 );
-  Skew( 2,0 ) =-vect( 1 ); Skew( 2,1 )= vect( 0 );  Skew( 2,2 ) = 0        ;
-
-  Matrix RSk(3,3); RSk = R*Skew;
-
-  J.resize(3,Jq.cols());
-  for( unsigned int i=0;i<3;++i )
-    for( int j=0;j<Jq.cols();++j )
-      {
-        J(i,j)=0;
-        for( unsigned int k=0;k<3;++k )
-          {  J(i,j)-=RSk(i,k)*Jq(k+3,j);   }
-      }
+  jacobianFromRotation( R,vect,Jq,J );
 
   sotDEBUG(15)<<"# Out }"<<endl;
   return J;
 }
 
+/* J = - R [v]x Jr */
+void FeatureVector3::
+jacobianFromRotation( const MatrixRotation& R,const Vector& vect,
+		      const Matrix& Jq,Matrix& J )
+{
+  Eigen::Matrix3d Skew;
+  Skew <<         0,-vect( 2 ), vect( 1 ),
+          vect( 2 ),         0,-vect( 0 ),
+         -vect( 1 ), vect( 0 ),         0;
+
+  const Eigen::Matrix3d RSk = R*Skew;
+  J.resize(3,Jq.cols());
+  J.noalias() = -RSk*Jq.middleRows(3,3);
+}
+
 /** Compute the error between two visual features from a subset
 *a the possible features.
  */
@@ -135,6 +137,41 @@ FeatureVector3::computeError( Vector& Mvect3,int time )
   return Mvect3 ;
 }
 
+/* The rotation of the body and the vector are read once for the error and
+ * the Jacobian. */
+void FeatureVector3::
+computeAll( int time )
+{
+  sotDEBUGIN(15);
+
+  if( !positionSIN.isPlugged()||!vectorSIN.isPlugged() ) return;
+
+  MatrixRotation R; R = positionSIN(time).linear();
+  const Vector & vect = vectorSIN(time);
+
+  if( positionRefSIN.isPlugged() )
+    {
+      errorAll.resize(3);
+      errorAll.noalias() = R*vect;
+      errorAll -= positionRefSIN(time);
+      errorAllAvailable = true;
+    }
+
+  if( articularJacobianSIN.isPlugged() )
+    {
+      jacobianFromRotation( R,vect,articularJacobianSIN(time),jacobianAll );
+      jacobianAllAvailable = true;
+    }
+
+  if( errordotAllRequested )
+    {
+      computeErrorDot( errordotAll,time );
+      errordotAllAvailable = true;
+    }
+
+  sotDEBUGOUT(15);
+}
+
 void FeatureVector3::
 display( std::ostream& os ) const
 {
@@ -58,6 +58,7 @@ FeatureVisualPoint( const string& pointName )
   errorSOUT.addDependency( ZSIN );
 
   signalRegistration( xySIN<<ZSIN<<articularJacobianSIN );
+  enableComputeAll();
 }
 
 void FeatureVisualPoint::addDependenciesFromReference( void )
@@ -102,18 +103,27 @@ computeJacobian( Matrix& J,int time )
 
   sotDEBUG(15) << "Get selection flags." << endl;
   const Flags &fl = selectionSIN(time);
+  const Vector & xy = xySIN(time);
+  sotDEBUG(5)<<xy<<std::endl;
 
-  const int dim = dimensionSOUT(time);
-  L.resize(dim,6) ;
-  unsigned int cursorL = 0;
+  computeInteractionMatrix( fl,dimensionSOUT(time),xy,ZSIN(time) );
+  sotDEBUG(15) << "Jq:"<<endl<<articularJacobianSIN(time)<<endl;
 
-  sotDEBUG(5)<<std::endl;
+  J = L*articularJacobianSIN(time);
 
-  const double & Z = ZSIN(time);
-  sotDEBUG(5)<<xySIN(time)<<std::endl;
-  const double & x = xySIN(time)(0);
-  const double & y = xySIN(time)(1);
+  sotDEBUG(15)<<"# Out }"<<endl;
+  return J;
+}
 
+void FeatureVisualPoint::
+computeInteractionMatrix( const Flags& fl,const unsigned int dim,
+			  const Vector& xy,const double& Z )
+{
+  L.resize(dim,6) ;
+  unsigned int cursorL = 0;
+
+  const double & x = xy(0);
+  const double & y = xy(1);
 
   if( Z<0 )
     { throw(ExceptionFeature(ExceptionFeature::BAD_INIT,
@@ -147,12 +157,6 @@ computeJacobian( Matrix& J,int time )
     cursorL++;
   }
   sotDEBUG(15) << "L:"<<endl<<L<<endl;
-  sotDEBUG(15) << "Jq:"<<endl<<articularJacobianSIN(time)<<endl;
-  
-  J = L*articularJacobianSIN(time);
-
-  sotDEBUG(15)<<"# Out }"<<endl;
-  return J;
 }
 
 /** Compute the error between two visual features from a subset
@@ -164,19 +168,65 @@ FeatureVisualPoint::computeError( Vector& error,int time )
   const Flags &fl = selectionSIN(time);
   sotDEBUGIN(15);
   error.resize(dimensionSOUT(time)) ;
-  unsigned int cursorL = 0;
 
   if(! isReferenceSet() )
     { throw(ExceptionFeature(ExceptionFeature::BAD_INIT,
 			     "S* is not of adequate type.")); }
 
+  errorFromPoints( fl,xySIN(time),getReference()->xySIN(time),error );
+
+  sotDEBUGOUT(15);
+  return error ;
+}
+
+void FeatureVisualPoint::
+errorFromPoints( const Flags& fl,const Vector& xy,const Vector& xyDes,
+		 Vector& error )
+{
+  unsigned int cursorL = 0;
   if( fl(0) )
-    { error( cursorL++ ) = xySIN(time)(0) - getReference()->xySIN(time)(0) ;   }
+    { error( cursorL++ ) = xy(0) - xyDes(0) ;   }
   if( fl(1) )
-    { error( cursorL++ ) = xySIN(time)(1) - getReference()->xySIN(time)(1) ;   }
+    { error( cursorL++ ) = xy(1) - xyDes(1) ;   }
+}
+
+/* The point, its selection and the dimension are read once for the error
+ * and the interaction matrix. */
+void FeatureVisualPoint::
+computeAll( int time )
+{
+  sotDEBUGIN(15);
+
+  if( !xySIN.isPlugged() ) return;
+
+  const Flags & fl = selectionSIN(time);
+  const unsigned int dim = dimensionSOUT(time);
+  const Vector & xy = xySIN(time);
+
+  if( isReferenceSet()&&getReference()->xySIN.isPlugged() )
+    {
+      errorAll.resize( dim );
+      errorFromPoints( fl,xy,getReference()->xySIN(time),errorAll );
+      errorAllAvailable = true;
+    }
+
+  /* A point behind the camera is reported by computeJacobian. */
+  if( ZSIN.isPlugged()&&articularJacobianSIN.isPlugged() )
+    try
+      {
+	computeInteractionMatrix( fl,dim,xy,ZSIN(time) );
+	jacobianAll.noalias() = L*articularJacobianSIN(time);
+	jacobianAllAvailable = true;
+      }
+    catch( const ExceptionFeature& ) {}
+
+  if( errordotAllRequested )
+    {
+      computeErrorDot( errordotAll,time );
+      errordotAllAvailable = true;
+    }
 
   sotDEBUGOUT(15);
-  return error ;
 }
 
 void FeatureVisualPoint::
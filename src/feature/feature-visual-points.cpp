@@ -0,0 +1,229 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+/* --- SOT --- */
+#include <sot/core/feature-visual-points.hh>
+#include <sot/core/exception-feature.hh>
+#include <sot/core/debug.hh>
+#include <sot/core/factory.hh>
+using namespace std;
+using namespace dynamicgraph::sot;
+using namespace dynamicgraph;
+
+
+DYNAMICGRAPH_FACTORY_ENTITY_PLUGIN(FeatureVisualPoints,"FeatureVisualPoints");
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+namespace {
+  /* View on the rows x_i (parity 0) or y_i (parity 1) of one column of
+   * the stacked interaction matrix. */
+  typedef Eigen::Map< Vector,0,Eigen::InnerStride<2> > StridedVector;
+
+  inline StridedVector
+  interactionRows( Matrix& L,const Matrix::Index parity,const Matrix::Index col )
+  {
+    return StridedVector( L.col(col).data()+parity,L.rows()/2 );
+  }
+}
+
+FeatureVisualPoints::
+FeatureVisualPoints( const string& pointName )
+  : FeatureAbstract( pointName )
+    ,L()
+    ,Lselec()
+    ,xySIN( NULL,"sotFeatureVisualPoints("+name+")::input(matrix)::xy" )
+    ,ZSIN( NULL,"sotFeatureVisualPoints("+name+")::input(vector)::Z" )
+    ,articularJacobianSIN( NULL,"sotFeatureVisualPoints("+name+")::input(matrix)::Jq" )
+{
+  jacobianSOUT.addDependency( xySIN );
+  jacobianSOUT.addDependency( ZSIN );
+  jacobianSOUT.addDependency( articularJacobianSIN );
+
+  errorSOUT.addDependency( xySIN );
+
+  signalRegistration( xySIN<<ZSIN<<articularJacobianSIN );
+}
+
+void FeatureVisualPoints::addDependenciesFromReference( void )
+{
+  assert( isReferenceSet() );
+  errorSOUT.addDependency( getReference()->xySIN );
+}
+
+void FeatureVisualPoints::removeDependenciesFromReference( void )
+{
+  assert( isReferenceSet() );
+  errorSOUT.removeDependency( getReference()->xySIN );
+}
+
+/* --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+unsigned int& FeatureVisualPoints::
+getDimension( unsigned int & dim, int time )
+{
+  sotDEBUG(25)<<"# In {"<<endl;
+
+  const Flags &fl = selectionSIN.access(time);
+  const Matrix::Index NBPOINTS = xySIN.access(time).rows();
+
+  dim = 0;
+  for( Matrix::Index i=0;i<NBPOINTS;++i )
+    if( fl(static_cast<int>(i)) ) dim+=2;
+
+  sotDEBUG(25)<<"# Out }"<<endl;
+  return dim;
+}
+
+void FeatureVisualPoints::
+computeInteractionMatrix( const Matrix& xy,const Vector& Z )
+{
+  const Matrix::Index NBPOINTS = xy.rows();
+  L.resize( 2*NBPOINTS,6 );
+
+  const Eigen::ArrayWrapper<const Matrix::ConstColXpr> x = xy.col(0).array();
+  const Eigen::ArrayWrapper<const Matrix::ConstColXpr> y = xy.col(1).array();
+  const Eigen::ArrayWrapper<const Vector> z = Z.array();
+
+  /* Rows of x. */
+  interactionRows(L,0,0).array() = -z.inverse();
+  interactionRows(L,0,1).setZero();
+  interactionRows(L,0,2).array() = x/z;
+  interactionRows(L,0,3).array() = x*y;
+  interactionRows(L,0,4).array() = -(1+x*x);
+  interactionRows(L,0,5).array() = y;
+
+  /* Rows of y. */
+  interactionRows(L,1,0).setZero();
+  interactionRows(L,1,1).array() = -z.inverse();
+  interactionRows(L,1,2).array() = y/z;
+  interactionRows(L,1,3).array() = 1+y*y;
+  interactionRows(L,1,4).array() = -x*y;
+  interactionRows(L,1,5).array() = -x;
+}
+
+/** Compute the interaction matrix from a subset of
+ * the possible features.
+ */
+Matrix& FeatureVisualPoints::
+computeJacobian( Matrix& J,int time )
+{
+  sotDEBUG(15)<<"# In {"<<endl;
+
+  const Flags &fl = selectionSIN(time);
+  const Matrix& xy = xySIN(time);
+  const Vector& Z = ZSIN(time);
+  const Matrix& Jq = articularJacobianSIN(time);
+  const Matrix::Index NBPOINTS = xy.rows();
+  const unsigned int dim = dimensionSOUT(time);
+
+  if( xy.cols()!=2 || Z.size()!=NBPOINTS )
+    { throw(ExceptionFeature(ExceptionFeature::UNCOMPATIBLE_SIZE,
+			     "xy should be N x 2 and Z of size N",
+			     " (xy is %dx%d, Z is %d).",
+			     (int)xy.rows(),(int)xy.cols(),(int)Z.size())); }
+
+  if( (Z.array()<0).any() )
+    { throw(ExceptionFeature(ExceptionFeature::BAD_INIT,
+			     "VisualPoints: a point is behind the camera"," (Zmin=%.1f).",
+			     Z.minCoeff())); }
+
+  if( (Z.array().abs()<1e-6).any() )
+    { throw(ExceptionFeature(ExceptionFeature::BAD_INIT,
+			     "VisualPoints: a Z coordinate is null"," (Zmin=%.3f)",
+			     Z.array().abs().minCoeff())); }
+
+  computeInteractionMatrix( xy,Z );
+  sotDEBUG(15) << "L:"<<endl<<L<<endl;
+  sotDEBUG(15) << "Jq:"<<endl<<Jq<<endl;
+
+  if( static_cast<Matrix::Index>(dim)==L.rows() )
+    { J.noalias() = L*Jq; }
+  else
+    {
+      Lselec.resize( dim,6 );
+      Matrix::Index cursorL = 0;
+      for( Matrix::Index i=0;i<NBPOINTS;++i )
+	if( fl(static_cast<int>(i)) )
+	  { Lselec.middleRows(cursorL,2) = L.middleRows(2*i,2); cursorL+=2; }
+      J.noalias() = Lselec*Jq;
+    }
+
+  sotDEBUG(15)<<"# Out }"<<endl;
+  return J;
+}
+
+/** Compute the error between two visual features from a subset
+ * a the possible features.
+ */
+Vector&
+FeatureVisualPoints::computeError( Vector& error,int time )
+{
+  const Flags &fl = selectionSIN(time);
+  sotDEBUGIN(15);
+
+  if(! isReferenceSet() )
+    { throw(ExceptionFeature(ExceptionFeature::BAD_INIT,
+			     "S* is not of adequate type.")); }
+
+  const Matrix& xy = xySIN(time);
+  const Matrix& xyDes = getReference()->xySIN(time);
+  if( xyDes.rows()!=xy.rows() || xyDes.cols()!=xy.cols() )
+    { throw(ExceptionFeature(ExceptionFeature::UNCOMPATIBLE_SIZE,
+			     "S* does not have the same number of points.")); }
+
+  error.resize(dimensionSOUT(time)) ;
+  unsigned int cursorL = 0;
+  for( Matrix::Index i=0;i<xy.rows();++i )
+    if( fl(static_cast<int>(i)) )
+      {
+	error( cursorL++ ) = xy(i,0) - xyDes(i,0);
+	error( cursorL++ ) = xy(i,1) - xyDes(i,1);
+      }
+
+  sotDEBUGOUT(15);
+  return error ;
+}
+
+void FeatureVisualPoints::
+display( std::ostream& os ) const
+{
+  os <<"VisualPoints <"<<name<<">:";
+
+  try{
+    const Matrix& xy = xySIN.accessCopy ();
+    const Flags& fl = selectionSIN.accessCopy ();
+    for( Matrix::Index i=0;i<xy.rows();++i )
+      if( fl(static_cast<int>(i)) )
+	os << " (" << xy(i,0) << "," << xy(i,1) << ")";
+  }  catch(const ExceptionAbstract&){ os<< " XY or select not set."; }
+}
+
+
+
+/*
+ * Local variables:
+ * c-basic-offset: 2
+ * End:
+ */
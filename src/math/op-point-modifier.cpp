@@ -24,6 +24,7 @@
 
 #include <sot/core/op-point-modifier.hh>
 #include <sot/core/matrix-geometry.hh>
+#include <sot/core/exception-tools.hh>
 
 
 using namespace std;
@@ -49,12 +50,19 @@ OpPointModifier( const std::string& name )
    ,positionSOUT( boost::bind(&OpPointModifier::positionSOUT_function,this,_1,_2),
 		  positionSIN,
 		  "OpPointModifior("+name+")::output(matrixhomo)::position" )
+   ,jacobiansSIN(NULL,"OpPointModifior("+name+")::input(matrix)::jacobiansIN")
+   ,positionsSIN(NULL,"OpPointModifior("+name+")::input(matrix)::positionsIN")
+   ,jacobiansSOUT( boost::bind(&OpPointModifier::jacobiansSOUT_function,this,_1,_2),
+		   jacobiansSIN<<positionsSIN,
+		   "OpPointModifior("+name+")::output(matrix)::jacobians" )
   ,transformation()
   ,isEndEffector(true)
 {
   sotDEBUGIN(15);
 
-  signalRegistration( jacobianSIN<<positionSIN<<jacobianSOUT<<positionSOUT );
+  setTransformation( Eigen::Matrix4d::Identity() );
+  signalRegistration( jacobianSIN<<positionSIN<<jacobianSOUT<<positionSOUT
+		      <<jacobiansSIN<<positionsSIN<<jacobiansSOUT );
   {
 
     using namespace dynamicgraph::command;
@@ -62,8 +70,9 @@ OpPointModifier( const std::string& name )
 	       makeDirectGetter(*this,&transformation.matrix(),
 				docDirectGetter("transformation","matrix 4x4 homo")));
     addCommand("setTransformation",
-	       makeDirectSetter(*this, &transformation.matrix(),
-				docDirectSetter("dimension","matrix 4x4 homo")));
+	       makeCommandVoid1(*this,&OpPointModifier::setTransformation,
+				docCommandVoid1("Set the transformation and precompute the twist.",
+						"matrix 4x4 homo")));
     addCommand("getEndEffector",
 	       makeDirectGetter(*this,&isEndEffector,
 				docDirectGetter("end effector mode","bool")));
@@ -75,51 +84,94 @@ OpPointModifier( const std::string& name )
   sotDEBUGOUT(15);
 }
 
+/* res := bJb = bVa aJa, as two 3 x n block products. */
+template< typename JacobianIn,typename JacobianOut >
+void OpPointModifier::
+applyEndEffector( const JacobianIn& aJa,JacobianOut res ) const
+{
+  res.topRows(3).noalias() = bRa*aJa.topRows(3);
+  res.topRows(3).noalias() += bTxRa*aJa.bottomRows(3);
+  res.bottomRows(3).noalias() = bRa*aJa.bottomRows(3);
+}
+
+/* Consider that the jacobian of point A in frame A is given: J  = aJa
+ * and that homogenous transformation from A to B is given aMb in getTransfo()
+ * and homo transfo from 0 to A is given oMa in positionSIN.
+ * Then return oJb, the jacobian of point B expressed in frame O:
+ *     oJb = ( oRa 0 ; 0 oRa ) * bVa * aJa
+ *         = [ I skew(oAB); 0 I ] * oJa
+ * with oAB = oRb bAB = oRb (-bRa aAB ) = -oRa aAB, and aAB = translation(aMb).
+ */
+template< typename JacobianIn,typename JacobianOut >
+void OpPointModifier::
+applyWorldFrame( const MatrixRotation& oRa,
+		 const JacobianIn& oJa,JacobianOut res ) const
+{
+  const Eigen::Vector3d oAB = oRa*aAB;
+  Eigen::Matrix3d Tx;
+  Tx <<       0., oAB(2),-oAB(1),
+        -oAB(2),      0., oAB(0),
+         oAB(1),-oAB(0),      0.;
+
+  res.topRows(3) = oJa.topRows(3);
+  res.topRows(3).noalias() += Tx*oJa.bottomRows(3);
+  res.bottomRows(3) = oJa.bottomRows(3);
+}
+
 dynamicgraph::Matrix&
 OpPointModifier::jacobianSOUT_function( dynamicgraph::Matrix& res,const int& iter )
 {
+  const dynamicgraph::Matrix& aJa = jacobianSIN( iter );
+  res.resize( 6,aJa.cols() );
   if( isEndEffector )
     {
-      const dynamicgraph::Matrix& aJa = jacobianSIN( iter );
-      const MatrixHomogeneous & aMb = transformation;
-
-      MatrixTwist bVa; buildFrom(aMb.inverse (), bVa );
-      res = bVa * aJa; // res := bJb
-      return res;
+      applyEndEffector( aJa.topRows(6),res.topRows(6) );
+      return res; // res := bJb
     }
   else
     {
-      /* Consider that the jacobian of point A in frame A is given: J  = aJa
-       * and that homogenous transformation from A to B is given aMb in getTransfo()
-       * and homo transfo from 0 to A is given oMa in positionSIN.
-       * Then return oJb, the jacobian of point B expressed in frame O:
-       *     oJb = ( oRa 0 ; 0 oRa ) * bVa * aJa
-       *         = [ I skew(oAB); 0 I ] * oJa
-       * with oAB = oRb bAB = oRb (-bRa aAB ) = -oRa aAB, and aAB = translation(aMb).
-       */
-
-      const dynamicgraph::Matrix& oJa = jacobianSIN( iter );
-      const MatrixHomogeneous & aMb = transformation;
       const MatrixHomogeneous & oMa = positionSIN(iter);
       MatrixRotation oRa; oRa = oMa.linear();
-      dynamicgraph::Vector aAB(3); aAB = aMb.translation();
-      dynamicgraph::Vector oAB = oRa*aAB;
+      applyWorldFrame( oRa,aJa.topRows(6),res.topRows(6) );
+      return res; // res := 0Jb
+    }
+}
 
-      const dynamicgraph::Matrix::Index nq = oJa.cols();
-      res.resize( 6,oJa.cols() );
-      for( int j=0;j<nq;++j )
+dynamicgraph::Matrix&
+OpPointModifier::jacobiansSOUT_function( dynamicgraph::Matrix& res,const int& iter )
+{
+  const dynamicgraph::Matrix& aJa = jacobiansSIN( iter );
+  if( aJa.rows()%6 != 0 )
+    {
+      SOT_THROW ExceptionTools( ExceptionTools::GENERIC,
+				"The stacked Jacobians should have 6K rows",
+				" (%d rows).",(int)aJa.rows() );
+    }
+  const dynamicgraph::Matrix::Index K = aJa.rows()/6;
+  res.resize( aJa.rows(),aJa.cols() );
+
+  if( isEndEffector )
+    {
+      for( dynamicgraph::Matrix::Index k=0;k<K;++k )
+	applyEndEffector( aJa.middleRows(6*k,6),res.middleRows(6*k,6) );
+    }
+  else
+    {
+      const dynamicgraph::Matrix& oMa = positionsSIN( iter );
+      if( oMa.rows()!=4*K || oMa.cols()!=4 )
 	{
-	  /* This is a I*Jtrans + skew*Jrot product, unrolled by hand ... */
-	  res(0,j) = oJa(0,j) -oAB(1)*oJa(2+3,j) + oAB(2)*oJa(1+3,j);
-	  res(1,j) = oJa(1,j) -oAB(2)*oJa(0+3,j) + oAB(0)*oJa(2+3,j);
-	  res(2,j) = oJa(2,j) -oAB(0)*oJa(1+3,j) + oAB(1)*oJa(0+3,j);
-	  for( int i=0;i<3;++i )
-	    {
-	      res(i+3,j) = oJa(i+3,j);
-	    }
+	  SOT_THROW ExceptionTools( ExceptionTools::GENERIC,
+				    "The stacked positions should be a 4K x 4 matrix",
+				    " (%dx%d for %d Jacobians).",
+				    (int)oMa.rows(),(int)oMa.cols(),(int)K );
+	}
+      for( dynamicgraph::Matrix::Index k=0;k<K;++k )
+	{
+	  const MatrixRotation oRa = oMa.block<3,3>(4*k,0);
+	  applyWorldFrame( oRa,aJa.middleRows(6*k,6),res.middleRows(6*k,6) );
 	}
-      return res; // res := 0Jb
     }
+  return res;
 }
 
 MatrixHomogeneous&
@@ -136,7 +188,17 @@ OpPointModifier::positionSOUT_function( MatrixHomogeneous& res,const int& iter )
 
 void
 OpPointModifier::setTransformation( const Eigen::Matrix4d& tr )
-{ transformation.matrix() = tr; }
+{
+  transformation.matrix() = tr;
+
+  /* The twist bVa only depends on the transformation: its blocks are
+   * computed once here rather than at each access to the Jacobian. */
+  MatrixHomogeneous bMa; bMa = transformation.inverse( Eigen::Affine );
+  MatrixTwist bVa; buildFrom( bMa,bVa );
+  bRa = bVa.block<3,3>(0,0);
+  bTxRa = bVa.block<3,3>(0,3);
+  aAB = transformation.translation();
+}
 const Eigen::Matrix4d&
 OpPointModifier::getTransformation( void )
 { return transformation.matrix(); }
@@ -52,6 +52,33 @@ namespace dynamicgraph {
     using dynamicgraph::command::Value;
     using dynamicgraph::command::Command;
 
+    /* The vector signals with scalar coefficients are filtered channel by
+     * channel, on contiguous windows. */
+    template<>
+    Vector& FIRFilter<Vector, double>::compute( Vector& res,int time )
+    {
+      channelMajor.compute( SIN.access( time ),res );
+      return res;
+    }
+
+    /* As in the generic filter, the first coefficients are kept. */
+    template<>
+    void FIRFilter<Vector, double>::resizeBuffer( const unsigned int& size )
+    {
+      coefs.resize( size );
+      channelMajor.resize( size );
+      for( unsigned int i=0;i<size;++i )
+        channelMajor.setCoefficient( i,coefs[i] );
+    }
+
+    template<>
+    void FIRFilter<Vector, double>::setElement( const unsigned int& rank,
+                                                const double& coef )
+    {
+      coefs [rank] = coef;
+      channelMajor.setCoefficient( rank,coef );
+    }
+
     SOT_FACTORY_TEMPLATE_ENTITY_PLUGIN(FIRFilter,double,double,double_double,"FIRFilter")
     SOT_FACTORY_TEMPLATE_ENTITY_PLUGIN(FIRFilter,Vector,double,vec_double,"FIRFilter")
     SOT_FACTORY_TEMPLATE_ENTITY_PLUGIN(FIRFilter,Vector,Matrix,vec_mat,"FIRFilter")
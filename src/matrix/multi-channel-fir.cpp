@@ -0,0 +1,142 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+/* --- SOT --- */
+#include <sot/core/multi-channel-fir.hh>
+#include <sot/core/exception-tools.hh>
+#include <sot/core/debug.hh>
+
+using namespace dynamicgraph::sot;
+using dynamicgraph::Vector;
+using dynamicgraph::Matrix;
+
+MultiChannelFIR::
+MultiChannelFIR( void )
+  : coefs( 0,1 )
+  ,history( 0 )
+  ,nbTaps( 0 )
+  ,nbChannels( 0 )
+  ,position( 0 )
+{
+}
+
+void MultiChannelFIR::
+resize( const std::size_t& size )
+{
+  nbTaps = size;
+  coefs.setZero( nbTaps,coefs.cols() );
+  reset( nbChannels );
+}
+
+void MultiChannelFIR::
+setCoefficient( const std::size_t& rank,const double& coef )
+{
+  if( rank>=nbTaps )
+    SOT_THROW ExceptionTools( ExceptionTools::GENERIC,
+                              "Rank of the coefficient out of range",
+                              " (%d>=%d).",(int)rank,(int)nbTaps );
+  coefs( rank,0 ) = coef;
+}
+
+double MultiChannelFIR::
+getCoefficient( const std::size_t& rank ) const
+{
+  if( rank>=nbTaps )
+    SOT_THROW ExceptionTools( ExceptionTools::GENERIC,
+                              "Rank of the coefficient out of range",
+                              " (%d>=%d).",(int)rank,(int)nbTaps );
+  return coefs( rank,0 );
+}
+
+void MultiChannelFIR::
+setCoefficients( const Matrix& newCoefs )
+{
+  if( 0==newCoefs.cols() )
+    SOT_THROW ExceptionTools( ExceptionTools::GENERIC,
+                              "At least one filter is needed",
+                              " (%d coefficients).",(int)newCoefs.rows() );
+  const bool sameSize = ( (std::size_t)newCoefs.rows()==nbTaps );
+  coefs = newCoefs;
+  nbTaps = coefs.rows();
+  if(! sameSize ) reset( nbChannels );
+}
+
+void MultiChannelFIR::
+reset( const std::size_t& size )
+{
+  nbChannels = size;
+  history.setZero( 2*nbTaps*nbChannels );
+  position = 0;
+}
+
+void MultiChannelFIR::
+fill( const Vector& in )
+{
+  if( (std::size_t)in.size()!=nbChannels ) reset( in.size() );
+  Eigen::Map<Matrix> all( history.data(),2*nbTaps,nbChannels );
+  all.rowwise() = in.transpose();
+}
+
+MultiChannelFIR::Windows MultiChannelFIR::
+push( const Vector& in )
+{
+  if( (std::size_t)in.size()!=nbChannels ) reset( in.size() );
+
+  /* The window [position,position+nbTaps) goes from the newest sample to
+   * the oldest one. */
+  if( nbTaps>0 )
+    {
+      position = ( 0==position ) ? nbTaps-1 : position-1;
+      double* channel = history.data();
+      for( std::size_t c=0;c<nbChannels;++c,channel+=2*nbTaps )
+        channel[ position ] = channel[ position+nbTaps ] = in( c );
+    }
+
+  /* One column per channel. */
+  return Windows( history.data()+position,nbTaps,nbChannels,
+                  Eigen::OuterStride<>( 2*nbTaps ) );
+}
+
+void MultiChannelFIR::
+compute( const Vector& in,Vector& out )
+{
+  const Windows windows = push( in );
+  out.resize( nbChannels );
+  if( 0==nbTaps ) { out.setZero(); return; }
+
+  /* All the outputs in one matrix-vector product. */
+  out.noalias() = windows.transpose()*coefs.col( 0 );
+}
+
+void MultiChannelFIR::
+compute( const Vector& in,Matrix& out )
+{
+  const Windows windows = push( in );
+  out.resize( nbChannels,coefs.cols() );
+  if( 0==nbTaps ) { out.setZero(); return; }
+
+  out.noalias() = windows.transpose()*coefs;
+}
+
+/*
+ * Local variables:
+ * c-basic-offset: 2
+ * End:
+ */
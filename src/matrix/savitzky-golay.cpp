@@ -0,0 +1,179 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Eigen/QR>
+
+#include <dynamic-graph/all-commands.h>
+#include <dynamic-graph/factory.h>
+
+#include <sot/core/factory.hh>
+#include <sot/core/savitzky-golay.hh>
+#include <sot/core/exception-tools.hh>
+#include <sot/core/debug.hh>
+
+namespace dg = ::dynamicgraph;
+
+namespace dynamicgraph {
+  namespace sot {
+
+
+DYNAMICGRAPH_FACTORY_ENTITY_PLUGIN(SavitzkyGolay,"SavitzkyGolay");
+
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+
+SavitzkyGolay::
+SavitzkyGolay( const std::string& n )
+  :Entity(n)
+   ,SIN(NULL,"SavitzkyGolay("+n+")::input(vector)::sin")
+   ,timestepSIN("SavitzkyGolay("+n+")::input(double)::dt")
+   ,filterSINTERN( boost::bind(&SavitzkyGolay::filter,this,_1,_2),
+                   SIN,"SavitzkyGolay("+n+")::intern(dummy)::filter" )
+   ,valueSOUT( boost::bind(&SavitzkyGolay::getValue,this,_1,_2),
+               filterSINTERN,"SavitzkyGolay("+n+")::output(vector)::value" )
+   ,derivativeSOUT( boost::bind(&SavitzkyGolay::getDerivative,this,_1,_2),
+                    filterSINTERN<<timestepSIN,
+                    "SavitzkyGolay("+n+")::output(vector)::derivative" )
+   ,secondDerivativeSOUT( boost::bind(&SavitzkyGolay::getSecondDerivative,this,_1,_2),
+                          filterSINTERN<<timestepSIN,
+                          "SavitzkyGolay("+n+")::output(vector)::secondDerivative" )
+   ,fir()
+   ,outputs()
+   ,timestep(1.)
+   ,init(false)
+{
+  signalRegistration( SIN<<timestepSIN<<valueSOUT<<derivativeSOUT
+                      <<secondDerivativeSOUT );
+  timestepSIN.setReferenceNonConstant( &timestep );
+  timestepSIN.setKeepReference(true);
+  setWindow( 5,2,0 );
+
+  using namespace dynamicgraph::command;
+  std::string docstring;
+  docstring =
+    "\n"
+    "    Set the window of the polynomial fit, and restart.\n"
+    "\n"
+    "      Input:\n"
+    "        - the number of samples,\n"
+    "        - the order of the polynomial (lower than the number of samples),\n"
+    "        - the delay of the estimate, in samples: 0 for the newest\n"
+    "          sample, (size-1)/2 for the center of the window.\n"
+    "\n";
+  addCommand("setWindow",
+             makeCommandVoid3(*this,&SavitzkyGolay::setWindow,docstring));
+  addCommand("reset",
+             makeCommandVoid0(*this,&SavitzkyGolay::reset,
+                              docCommandVoid0("Restart from the next input, "
+                                              "as if it had always been constant.")));
+}
+
+SavitzkyGolay::~SavitzkyGolay()
+{
+}
+
+/* --- COEFFICIENTS ------------------------------------------------------ */
+/* --- COEFFICIENTS ------------------------------------------------------ */
+/* --- COEFFICIENTS ------------------------------------------------------ */
+
+/* Least-square fit of p(tau) = sum_j c_j (tau/h)^j on the samples, at
+ * tau_k = delay-k: c = A^+ x, with A_kj = (tau_k/h)^j. The value, first
+ * and second derivatives at tau=0 are c_0, c_1/h and 2 c_2/h^2. */
+dg::Matrix SavitzkyGolay::
+coefficients( const int& size,const int& order,const int& delay )
+{
+  if( size<1 || order<0 || order>=size || delay<0 || delay>=size )
+    SOT_THROW ExceptionTools( ExceptionTools::GENERIC,
+                              "Savitzky-Golay window needs 0<=order<size "
+                              "and 0<=delay<size",
+                              " (size %d, order %d, delay %d).",
+                              size,order,delay );
+
+  const double h = ( size>1 ) ? .5*( size-1 ) : 1.;
+  dg::Matrix A( size,order+1 );
+  for( int k=0;k<size;++k )
+    {
+      const double tau = ( delay-k )/h;
+      A( k,0 ) = 1.;
+      for( int j=1;j<=order;++j ) A( k,j ) = A( k,j-1 )*tau;
+    }
+  const dg::Matrix pinv
+    = A.colPivHouseholderQr().solve( dg::Matrix::Identity( size,size ) );
+
+  dg::Matrix coefs = dg::Matrix::Zero( size,3 );
+  coefs.col( 0 ) = pinv.row( 0 ).transpose();
+  if( order>=1 ) coefs.col( 1 ) = pinv.row( 1 ).transpose()/h;
+  if( order>=2 ) coefs.col( 2 ) = 2.*pinv.row( 2 ).transpose()/( h*h );
+  return coefs;
+}
+
+void SavitzkyGolay::
+setWindow( const int& size,const int& order,const int& delay )
+{
+  fir.setCoefficients( coefficients( size,order,delay ) );
+  reset();
+}
+
+void SavitzkyGolay::
+reset( void )
+{
+  init = false;
+}
+
+/* --- COMPUTE ----------------------------------------------------------- */
+/* --- COMPUTE ----------------------------------------------------------- */
+/* --- COMPUTE ----------------------------------------------------------- */
+
+int& SavitzkyGolay::
+filter( int& dummy,const int& time )
+{
+  const dg::Vector& in = SIN( time );
+  if(! init ) { fir.fill( in ); init = true; }
+  fir.compute( in,outputs );
+  return dummy;
+}
+
+dg::Vector& SavitzkyGolay::
+getValue( dg::Vector& res,const int& time )
+{
+  filterSINTERN( time );
+  res = outputs.col( 0 );
+  return res;
+}
+
+dg::Vector& SavitzkyGolay::
+getDerivative( dg::Vector& res,const int& time )
+{
+  filterSINTERN( time );
+  res = ( 1./timestep )*outputs.col( 1 );
+  return res;
+}
+
+dg::Vector& SavitzkyGolay::
+getSecondDerivative( dg::Vector& res,const int& time )
+{
+  filterSINTERN( time );
+  res = ( 1./( timestep*timestep ) )*outputs.col( 2 );
+  return res;
+}
+
+
+
+  } /* namespace sot */
+} /* namespace dynamicgraph */
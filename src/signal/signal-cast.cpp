@@ -29,6 +29,7 @@
 #include <sot/core/trajectory.hh>
 #include <sot/core/flags.hh>
 #include <sot/core/multi-bound.hh>
+#include <sot/core/selection-jacobian.hh>
 #include <dynamic-graph/signal-caster.h>
 #include <dynamic-graph/signal-cast-helper.h>
 
@@ -216,6 +217,15 @@ namespace dynamicgraph
   }
 
 
+  /* --- SELECTION JACOBIAN -------------------------------------------------- */
+  /* --- SELECTION JACOBIAN -------------------------------------------------- */
+  /* --- SELECTION JACOBIAN -------------------------------------------------- */
+  namespace {
+    dynamicgraph::DefaultCastRegisterer <sot::SelectionJacobian>
+    selectionJacobianCastRegisterer;
+  }
+
+
   /* --- MULTI BOUND ---------------------------------------------------------- */
   /* --- MULTI BOUND ---------------------------------------------------------- */
   /* --- MULTI BOUND ---------------------------------------------------------- */
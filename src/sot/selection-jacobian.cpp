@@ -0,0 +1,122 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License
+ * along with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+#include <iostream>
+
+#include <sot/core/selection-jacobian.hh>
+#include <sot/core/debug.hh>
+
+using namespace std;
+using namespace dynamicgraph::sot;
+using namespace dynamicgraph;
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+SelectionJacobian::
+SelectionJacobian( const Index& nbRows,const Index& nbCols_ )
+  : colIndices(nbRows),scales(nbRows),nbCols(nbCols_)
+{
+  colIndices.setZero(); scales.setZero();
+}
+
+void SelectionJacobian::
+resize( const Index& nbRows,const Index& nbCols_ )
+{
+  if( nbRows!=colIndices.size() )
+    {
+      colIndices.resize(nbRows); colIndices.setZero();
+      scales.resize(nbRows); scales.setZero();
+    }
+  nbCols = nbCols_;
+}
+
+Matrix& SelectionJacobian::
+toDense( Matrix& res ) const
+{
+  res.resize( rows(),nbCols );
+  writeRows( res,0 );
+  return res;
+}
+
+void SelectionJacobian::
+writeRows( Matrix& J,const Index& row ) const
+{
+  assert( J.cols()==nbCols );
+  assert( J.rows()>=row+rows() );
+  J.middleRows( row,rows() ).setZero();
+  for( Index i=0;i<rows();++i )
+    { J( row+i,colIndices(i) ) = scales(i); }
+}
+
+Matrix& SelectionJacobian::
+multiply( const Matrix& M,Matrix& res ) const
+{
+  assert( M.rows()==nbCols );
+  res.resize( rows(),M.cols() );
+  for( Index i=0;i<rows();++i )
+    { res.row(i).noalias() = scales(i)*M.row( colIndices(i) ); }
+  return res;
+}
+
+Vector& SelectionJacobian::
+multiply( const Vector& v,Vector& res ) const
+{
+  assert( v.size()==nbCols );
+  res.resize( rows() );
+  for( Index i=0;i<rows();++i )
+    { res(i) = scales(i)*v( colIndices(i) ); }
+  return res;
+}
+
+void SelectionJacobian::
+setRows( const Index& row,const SelectionJacobian& other )
+{
+  assert( other.nbCols==nbCols );
+  colIndices.segment( row,other.rows() ) = other.colIndices;
+  scales.segment( row,other.rows() ) = other.scales;
+}
+
+namespace dynamicgraph {
+  namespace sot {
+
+    std::ostream&
+    operator<<( std::ostream& os,const SelectionJacobian& S )
+    {
+      os << S.rows() << " " << S.cols();
+      for( SelectionJacobian::Index i=0;i<S.rows();++i )
+	{ os << " " << S.colIndices(i) << " " << S.scales(i); }
+      return os;
+    }
+
+    std::istream&
+    operator>>( std::istream& is,SelectionJacobian& S )
+    {
+      SelectionJacobian::Index nbRows,nbCols,j; double s;
+      is >> nbRows >> nbCols;
+      S.resize( nbRows,nbCols );
+      for( SelectionJacobian::Index i=0;i<nbRows;++i )
+	{ is >> j >> s; S.set(i,j,s); }
+      return is;
+    }
+
+  } // namespace sot
+} // namespace dynamicgraph
@@ -177,7 +177,9 @@ Sot( const std::string& name )
   addCommand("list",
 	     new command::classSot::List(*this, docstring));
 
-
+  // Parallel evaluation of the graph
+  executor.addRoot( controlSOUT );
+  executor.addSpecificCommands( *this,commandMap,"executor." );
 }
 
 /* --------------------------------------------------------------------- */
@@ -374,7 +376,8 @@ computeJacobianConstrained( const TaskAbstract& task,
   return computeJacobianConstrained(Jac,K,JK);
 }
 
-static void computeJacobianActivated( Task* taskSpec,
+/* Return true if Jt has been modified by the control selection. */
+static bool computeJacobianActivated( Task* taskSpec,
 				      dynamicgraph::Matrix& Jt,
 				      const int& iterTime )
 {
@@ -392,6 +395,7 @@ static void computeJacobianActivated( Task* taskSpec,
 		  if(! controlSelec(i) )
 		    { Jt.col (i).setZero(); }
 		}
+	      return true;
 	    }
 	  else
 	    {
@@ -402,9 +406,11 @@ static void computeJacobianActivated( Task* taskSpec,
 	{
 	  sotDEBUG(15) << "Task not activated."<<endl;
 	  Jt *= 0;
+	  return true;
 	}
     }
   else { /* No selection specification: nothing to do. */ }
+  return false;
 }
 
 
@@ -477,6 +483,10 @@ computeControlLaw( dynamicgraph::Vector& control,const int& iterTime )
   sotSTART_CHRONO1;
   sotSTARTPARTCOUNTERS;
 
+  /* Evaluate the independent branches of the graph in parallel, when the
+   * executor is started: the tasks are then up to date below. */
+  executor.run( iterTime );
+
   const double &th = inversionThresholdSIN(iterTime);
   const Matrix &K = constraintSOUT(iterTime);
   const Matrix::Index mJ = K.cols(); // number dofs - number constraints
@@ -562,11 +572,21 @@ computeControlLaw( dynamicgraph::Vector& control,const int& iterTime )
 	/***/sotCOUNTER(2,3); // compute JK
 
 	/* --- COMPUTE S --- */
-	computeJacobianActivated( dynamic_cast<Task*>( &task ),JK,iterTime );
+	Task* taskSpec = dynamic_cast<Task*>( &task );
+	const bool masked = computeJacobianActivated( taskSpec,JK,iterTime );
 	/***/sotCOUNTER(3,4); // compute JK*S
 
 	/* --- COMPUTE Jt --- */
-	if( 0<iterTask ) Jt.noalias() = JK*(*PrevProj); else { Jt = JK; }
+	/* A selection Jacobian (without constraint) turns the projection
+	 * into a gather of the rows of the previous projector. */
+	if( 0<iterTask )
+	  {
+	    if( (!masked) && (Jac.cols()==mJ)
+		&& (NULL!=taskSpec) && taskSpec->withSelectionJacobian() )
+	      taskSpec->jacobianSelectionSOUT(iterTime).multiply(*PrevProj,Jt);
+	    else Jt.noalias() = JK*(*PrevProj);
+	  }
+	else { Jt = JK; }
 	/***/sotCOUNTER(4,5); // compute Jt
 
 	/* --- PINV --- */
@@ -58,6 +58,9 @@ Task( const std::string& n )
    ,errorTimeDerivativeSOUT( boost::bind(&Task::computeErrorTimeDerivative,this,_1,_2),
 	       errorSOUT,
 	       "sotTask("+n+")::output(vector)::errorTimeDerivative" )
+   ,jacobianSelectionSOUT( boost::bind(&Task::computeJacobianSelection,this,_1,_2),
+	       sotNOSIGNAL,
+	       "sotTask("+n+")::output(selection)::jacobianSelection" )
 {
   taskSOUT.setFunction( boost::bind(&Task::computeTaskExponentialDecrease,this,_1,_2) );
   jacobianSOUT.setFunction( boost::bind(&Task::computeJacobian,this,_1,_2) );
@@ -71,7 +74,8 @@ Task( const std::string& n )
   controlSelectionSIN = true;
 
   signalRegistration( controlGainSIN<<dampingGainSINOUT
-		      <<controlSelectionSIN<<errorSOUT<<errorTimeDerivativeSOUT );
+		      <<controlSelectionSIN<<errorSOUT<<errorTimeDerivativeSOUT
+		      <<jacobianSelectionSOUT );
 
 
   initCommands();
@@ -122,7 +126,12 @@ void Task::
 addFeature( FeatureAbstract& s )
 {
   featureList.push_back(&s);
-  jacobianSOUT.addDependency( s.jacobianSOUT );
+  if( s.withSelectionJacobian() )
+    {
+      jacobianSOUT.addDependency( s.jacobianSelectionSOUT );
+      jacobianSelectionSOUT.addDependency( s.jacobianSelectionSOUT );
+    }
+  else jacobianSOUT.addDependency( s.jacobianSOUT );
   errorSOUT.addDependency( s.errorSOUT );
   errorTimeDerivativeSOUT.addDependency (s.getErrorDot());
 }
@@ -143,7 +152,12 @@ clearFeatureList( void )
 	 iter!=featureList.end(); ++iter )
     {
       FeatureAbstract & s = **iter;
-      jacobianSOUT.removeDependency( s.jacobianSOUT );
+      if( s.withSelectionJacobian() )
+	{
+	  jacobianSOUT.removeDependency( s.jacobianSelectionSOUT );
+	  jacobianSelectionSOUT.removeDependency( s.jacobianSelectionSOUT );
+	}
+      else jacobianSOUT.removeDependency( s.jacobianSOUT );
       errorSOUT.removeDependency( s.errorSOUT );
       errorTimeDerivativeSOUT.removeDependency (s.getErrorDot());
     }
@@ -305,6 +319,26 @@ computeJacobian( dynamicgraph::Matrix& J,int time )
 	FeatureAbstract &feature = ** iter;
 	sotDEBUG(25) << "Feature <" << feature.getName() <<">"<< endl;
 
+	/* Selection Jacobians are scattered directly in J, without going
+	 * through their dense form. */
+	if( feature.withSelectionJacobian() )
+	  {
+	    const SelectionJacobian& partialSelection
+	      = feature.jacobianSelectionSOUT(time);
+	    const dynamicgraph::Matrix::Index nbr = partialSelection.rows();
+
+	    if( 0==nbc ) { nbc = partialSelection.cols(); J.resize(dimJ,nbc); }
+	    else if( partialSelection.cols() != nbc )
+	      throw ExceptionTask(ExceptionTask::NON_ADEQUATE_FEATURES,
+				  "Features from the list don't have compatible-size jacobians.");
+
+	    while( cursorJ+nbr>=dimJ )
+	      { dimJ *= 2; J.conservativeResize(dimJ,nbc); }
+	    partialSelection.writeRows(J,cursorJ);
+	    cursorJ += nbr;
+	    continue;
+	  }
+
 	/* Get s, and store it in the s vector. */
 	const dynamicgraph::Matrix& partialJacobian = feature.jacobianSOUT(time);
 	const dynamicgraph::Matrix::Index nbr = partialJacobian.rows();
@@ -340,6 +374,51 @@ computeJacobian( dynamicgraph::Matrix& J,int time )
   return J;
 }
 
+bool Task::
+withSelectionJacobian( void ) const
+{
+  if( featureList.empty()) return false;
+  for(   std::list< FeatureAbstract* >::const_iterator iter = featureList.begin();
+	 iter!=featureList.end(); ++iter )
+    { if(! (*iter)->withSelectionJacobian() ) return false; }
+  return true;
+}
+
+SelectionJacobian& Task::
+computeJacobianSelection( SelectionJacobian& J,int time )
+{
+  sotDEBUG(15) << "# In {" << endl;
+
+  if(! withSelectionJacobian() )
+    { throw( ExceptionTask(ExceptionTask::NON_ADEQUATE_FEATURES,
+			   "Not all the features provide a selection Jacobian.") ) ; }
+
+  dynamicgraph::Matrix::Index nbr = 0;
+  for(   std::list< FeatureAbstract* >::iterator iter = featureList.begin();
+	 iter!=featureList.end(); ++iter )
+    { nbr += (*iter)->jacobianSelectionSOUT(time).rows(); }
+
+  const dynamicgraph::Matrix::Index nbc
+    = featureList.front()->jacobianSelectionSOUT(time).cols();
+  J.resize(nbr,nbc);
+
+  dynamicgraph::Matrix::Index cursorJ = 0;
+  for(   std::list< FeatureAbstract* >::iterator iter = featureList.begin();
+	 iter!=featureList.end(); ++iter )
+    {
+      const SelectionJacobian& partialSelection
+	= (*iter)->jacobianSelectionSOUT(time);
+      if( partialSelection.cols() != nbc )
+	throw ExceptionTask(ExceptionTask::NON_ADEQUATE_FEATURES,
+			    "Features from the list don't have compatible-size jacobians.");
+      J.setRows(cursorJ,partialSelection);
+      cursorJ += partialSelection.rows();
+    }
+
+  sotDEBUG(15) << "# Out }" << endl;
+  return J;
+}
+
 /* --- DISPLAY ------------------------------------------------------------ */
 /* --- DISPLAY ------------------------------------------------------------ */
 /* --- DISPLAY ------------------------------------------------------------ */
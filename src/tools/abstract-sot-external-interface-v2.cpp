@@ -0,0 +1,129 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sot/core/abstract-sot-external-interface-v2.hh>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace dynamicgraph::sot;
+
+/* --- EXCHANGE BUFFER ------------------------------------------------------ */
+
+ExchangeBuffer::Handle ExchangeBuffer::
+add(const std::string & name, const std::size_t & size)
+{
+  const Handle h = find(name);
+  if (h >= 0)
+  {
+    if (sizes_[h] != size)
+      throw std::invalid_argument ("Block " + name +
+                                   " already added with another size.");
+    return h;
+  }
+  names_.push_back(name);
+  offsets_.push_back(values_.size());
+  sizes_.push_back(size);
+  values_.resize(values_.size() + size, 0.);
+  return static_cast<Handle>(names_.size() - 1);
+}
+
+ExchangeBuffer::Handle ExchangeBuffer::
+find(const std::string & name) const
+{
+  std::vector<std::string>::const_iterator it =
+      std::find(names_.begin(), names_.end(), name);
+  if (it == names_.end()) return -1;
+  return static_cast<Handle>(it - names_.begin());
+}
+
+void ExchangeBuffer::
+clear()
+{
+  names_.clear();
+  offsets_.clear();
+  sizes_.clear();
+  values_.clear();
+}
+
+void ExchangeBuffer::
+fromMap(const std::map<std::string,NamedVector> & in)
+{
+  for (std::map<std::string,NamedVector>::const_iterator it = in.begin();
+       it != in.end(); ++it)
+  {
+    const Handle h = find(it->first);
+    if (h < 0) continue;
+    const std::vector<double> & values = it->second.getValues();
+    const std::size_t n = std::min(values.size(), sizes_[h]);
+    std::copy(values.begin(), values.begin() + n,
+              values_.begin() + offsets_[h]);
+  }
+}
+
+void ExchangeBuffer::
+toMap(std::map<std::string,NamedVector> & out) const
+{
+  for (std::size_t h = 0; h < names_.size(); ++h)
+  {
+    NamedVector & entry = out[names_[h]];
+    entry.setName(names_[h]);
+    entry.setValues(std::vector<double>
+                    (values_.begin() + offsets_[h],
+                     values_.begin() + offsets_[h] + sizes_[h]));
+  }
+}
+
+/* --- MAP-BASED INTERFACE -------------------------------------------------- */
+
+void AbstractSotExternalInterfaceV2::
+registerBuffers()
+{
+  if (registered_) return;
+  registerSensorsAndControls(sensors_, controls_);
+  registered_ = true;
+}
+
+void AbstractSotExternalInterfaceV2::
+setupSetSensors(std::map<std::string,SensorValues> &sensorsIn)
+{
+  registerBuffers();
+  sensors_.fromMap(sensorsIn);
+  setupSetSensors(static_cast<const ExchangeBuffer&>(sensors_));
+}
+
+void AbstractSotExternalInterfaceV2::
+nominalSetSensors(std::map<std::string,SensorValues> &sensorsIn)
+{
+  registerBuffers();
+  sensors_.fromMap(sensorsIn);
+  nominalSetSensors(static_cast<const ExchangeBuffer&>(sensors_));
+}
+
+void AbstractSotExternalInterfaceV2::
+cleanupSetSensors(std::map<std::string,SensorValues> &sensorsIn)
+{
+  registerBuffers();
+  sensors_.fromMap(sensorsIn);
+  cleanupSetSensors(static_cast<const ExchangeBuffer&>(sensors_));
+}
+
+void AbstractSotExternalInterfaceV2::
+getControl(std::map<std::string,ControlValues> &controlOut)
+{
+  registerBuffers();
+  getControl(controls_);
+  controls_.toMap(controlOut);
+}
@@ -0,0 +1,392 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+/* --- SOT --- */
+#include <sot/core/async-periodic-call.hh>
+#include <sot/core/debug.hh>
+#include <dynamic-graph/all-commands.h>
+#include <dynamic-graph/exception-factory.h>
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+
+using namespace std;
+using namespace dynamicgraph;
+using namespace dynamicgraph::sot;
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+AsyncPeriodicCall::
+AsyncPeriodicCall( void )
+  : sources()
+  ,snapshotSignals()
+  ,calls()
+  ,processing( -1 )
+  ,next( 0 )
+  ,nextReady( false )
+  ,thread( NULL )
+  ,stopping( false )
+  ,running( false )
+  ,posted( 0 ),dropped( 0 ),processed( 0 )
+  ,missed( 0 )
+{
+}
+
+AsyncPeriodicCall::
+~AsyncPeriodicCall( void )
+{
+  stop();
+  for( std::size_t k=0;k<snapshotSignals.size();++k ) delete snapshotSignals[k];
+}
+
+AsyncPeriodicCall::VectorSignal& AsyncPeriodicCall::
+addSnapshot( VectorSignal& source,const std::string& signalName )
+{
+  stop();
+  {
+    boost::mutex::scoped_lock lock( mutex );
+    sources.push_back( &source );
+    snapshotSignals.push_back( new VectorSignal( signalName ) );
+    for( int k=0;k<2;++k )
+      snapshots[k].values.resize( sources.size() );
+  }
+  start();
+  return *snapshotSignals.back();
+}
+
+/* --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+void AsyncPeriodicCall::
+changeCalls( const boost::function< void( void ) >& change )
+{
+  stop();
+  try { change(); }
+  catch( ... ) { start(); throw; }
+  start();
+}
+
+void AsyncPeriodicCall::
+addSignal( const std::string& name,SignalBase<int>& sig )
+{
+  void (PeriodicCall::*add)( const std::string&,SignalBase<int>& )
+    = &PeriodicCall::addSignal;
+  changeCalls( boost::bind( add,&calls,name,boost::ref( sig ) ) );
+}
+
+void AsyncPeriodicCall::
+addSignal( const std::string& sigpath )
+{
+  void (PeriodicCall::*add)( const std::string& ) = &PeriodicCall::addSignal;
+  changeCalls( boost::bind( add,&calls,sigpath ) );
+}
+
+void AsyncPeriodicCall::
+addDownsampledSignal( const std::string& sigpath,const unsigned int& downsamplingFactor )
+{
+  void (PeriodicCall::*add)( const std::string&,const unsigned int& )
+    = &PeriodicCall::addDownsampledSignal;
+  changeCalls( boost::bind( add,&calls,sigpath,downsamplingFactor ) );
+}
+
+void AsyncPeriodicCall::
+rmSignal( const std::string& name )
+{
+  changeCalls( boost::bind( &PeriodicCall::rmSignal,&calls,name ) );
+}
+
+void AsyncPeriodicCall::
+clear( void )
+{
+  changeCalls( boost::bind( &PeriodicCall::clear,&calls ) );
+}
+
+void AsyncPeriodicCall::
+setPhase( const std::string& name,const unsigned int& phase )
+{
+  changeCalls( boost::bind( &PeriodicCall::setPhase,&calls,name,phase ) );
+}
+
+void AsyncPeriodicCall::
+setAutoStagger( const bool& stagger )
+{
+  changeCalls( boost::bind( &PeriodicCall::setAutoStagger,&calls,stagger ) );
+}
+
+void AsyncPeriodicCall::
+freeze( void )
+{
+  changeCalls( boost::bind( &PeriodicCall::freeze,&calls ) );
+}
+
+void AsyncPeriodicCall::
+unfreeze( void )
+{
+  changeCalls( boost::bind( &PeriodicCall::unfreeze,&calls ) );
+}
+
+void AsyncPeriodicCall::
+resetStats( void )
+{
+  changeCalls( boost::bind( &PeriodicCall::resetStats,&calls ) );
+}
+
+/* --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+void AsyncPeriodicCall::
+post( const int& time )
+{
+  boost::mutex::scoped_try_lock lock( mutex );
+  if(! lock.owns_lock() ) { ++missed; return; }
+  if(! running ) return;
+
+  posted += 1+missed; dropped += missed; missed = 0;
+  if( nextReady ) { ++dropped; return; }
+
+  /* The buffers keep their size from one snapshot to the next. */
+  next = ( 0==processing ) ? 1 : 0;
+  Snapshot& snapshot = snapshots[next];
+  for( std::size_t k=0;k<sources.size();++k )
+    {
+      try { snapshot.values[k] = sources[k]->accessCopy(); }
+      catch( ... ) { snapshot.values[k].resize( 0 ); }
+    }
+  snapshot.time = time;
+  nextReady = true;
+  lock.unlock();
+  cond.notify_one();
+}
+
+void AsyncPeriodicCall::
+workerLoop( void )
+{
+  for(;;)
+    {
+      {
+	boost::mutex::scoped_lock lock( mutex );
+	if( processing>=0 ) ++processed;
+	processing = -1;
+	while( !stopping && !nextReady ) cond.wait( lock );
+	if( stopping ) return;
+	processing = next;
+	nextReady = false;
+      }
+
+      const Snapshot& snapshot = snapshots[processing];
+      for( std::size_t k=0;k<snapshotSignals.size();++k )
+	{
+	  snapshotSignals[k]->setConstant( snapshot.values[k] );
+	  snapshotSignals[k]->setTime( snapshot.time );
+	}
+      try { calls.run( snapshot.time ); }
+      catch( const std::exception& exc )
+	{ sotDEBUG(5) << "Asynchronous call: " << exc.what() << std::endl; }
+      catch( ... )
+	{ sotDEBUG(5) << "Asynchronous call: unknown exception" << std::endl; }
+    }
+}
+
+void AsyncPeriodicCall::
+start( void )
+{
+  if( NULL!=thread ) return;
+  if( sources.empty() && calls.empty() ) return;
+  boost::mutex::scoped_lock lock( mutex );
+  stopping = false;
+  running = true;
+  thread = new boost::thread( boost::bind( &AsyncPeriodicCall::workerLoop,this ) );
+}
+
+void AsyncPeriodicCall::
+stop( void )
+{
+  if( NULL==thread ) return;
+  {
+    boost::mutex::scoped_lock lock( mutex );
+    stopping = true;
+    running = false;
+  }
+  cond.notify_one();
+  thread->join();
+  delete thread; thread = NULL;
+
+  /* The snapshot waiting for the thread is lost. */
+  boost::mutex::scoped_lock lock( mutex );
+  if( nextReady ) { ++dropped; nextReady = false; }
+}
+
+bool AsyncPeriodicCall::
+isRunning( void ) const
+{
+  boost::mutex::scoped_lock lock( mutex );
+  return running;
+}
+
+unsigned int AsyncPeriodicCall::
+getPostedCount( void ) const
+{
+  boost::mutex::scoped_lock lock( mutex );
+  return posted;
+}
+
+unsigned int AsyncPeriodicCall::
+getDroppedCount( void ) const
+{
+  boost::mutex::scoped_lock lock( mutex );
+  return dropped;
+}
+
+unsigned int AsyncPeriodicCall::
+getProcessedCount( void ) const
+{
+  boost::mutex::scoped_lock lock( mutex );
+  return processed;
+}
+
+void AsyncPeriodicCall::
+resetCounters( void )
+{
+  boost::mutex::scoped_lock lock( mutex );
+  posted = dropped = processed = 0;
+}
+
+/* --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+void AsyncPeriodicCall::
+display( std::ostream& os ) const
+{
+  boost::mutex::scoped_lock lock( mutex );
+  os << " -> ASYNC: " << ( running ? "running" : "stopped" )
+     << ", " << posted << " posted, " << dropped << " dropped, "
+     << processed << " processed" << endl;
+  for( std::size_t k=0;k<sources.size();++k )
+    os << " - " << snapshotSignals[k]->getName() << " <- "
+       << sources[k]->getName() << endl;
+}
+
+#define ADD_COMMAND( name,def )                                     \
+if (commandMap.count(prefix+name) != 0) {                            \
+  DG_THROW ExceptionFactory(ExceptionFactory::OBJECT_CONFLICT,        \
+			    "Command " + prefix+name +	               \
+			    " already registered in Entity.");          \
+ }                                                                       \
+commandMap.insert( std::make_pair( prefix+name,def ) )
+
+
+void AsyncPeriodicCall::addSpecificCommands(Entity& ent,
+					    Entity::CommandMap_t& commandMap,
+					    const std::string& prefix )
+{
+  using namespace dynamicgraph::command;
+
+  /* The commands of the periodic call, changing it with the thread
+   * stopped. Explicit typage to help the compiler. */
+  void (AsyncPeriodicCall::*addSignalPath)( const std::string& )
+    = &AsyncPeriodicCall::addSignal;
+  boost::function< void( const std::string& ) >
+    addSignal  = boost::bind( addSignalPath, this,_1 ),
+    rmSignal = boost::bind( &AsyncPeriodicCall::rmSignal, this,_1 );
+  boost::function< void( const std::string&, const unsigned int& ) >
+    addDownsampledSignal  = boost::bind( &AsyncPeriodicCall::addDownsampledSignal, this,_1,_2),
+    setPhase  = boost::bind( &AsyncPeriodicCall::setPhase, this,_1,_2);
+  boost::function< void( const bool& ) >
+    setAutoStagger  = boost::bind( &AsyncPeriodicCall::setAutoStagger, this,_1 );
+  boost::function< void( void ) >
+    clear  = boost::bind( &AsyncPeriodicCall::clear, this ),
+    freeze  = boost::bind( &AsyncPeriodicCall::freeze, this ),
+    unfreeze  = boost::bind( &AsyncPeriodicCall::unfreeze, this ),
+    resetStats  = boost::bind( &AsyncPeriodicCall::resetStats, this );
+  boost::function< void( std::ostream& ) >
+    disp  = boost::bind( &PeriodicCall::display, &calls,_1 ),
+    stats  = boost::bind( &PeriodicCall::displayStats, &calls,_1 );
+
+  ADD_COMMAND("addSignal",
+	      makeCommandVoid1(ent,addSignal,
+			       docCommandVoid1("Add the signal to the refresh list",
+					       "string (sig name)")));
+  ADD_COMMAND("addDownsampledSignal",
+	      makeCommandVoid2(ent,addDownsampledSignal,
+			       docCommandVoid2("Add the signal to the refresh list",
+					       "string (sig name)",
+					       "unsigned int (downsampling factor, 1 means every time, 2 means every other time, etc...")));
+  ADD_COMMAND("rmSignal",
+	      makeCommandVoid1(ent,rmSignal,
+			       docCommandVoid1("Remove the signal to the refresh list",
+					       "string (sig name)")));
+  ADD_COMMAND("clear",
+	      makeCommandVoid0(ent,clear,
+			       docCommandVoid0("Clear all signals and commands from the refresh list.")));
+  ADD_COMMAND("setPhase",
+	      makeCommandVoid2(ent,setPhase,
+			       docCommandVoid2("Call the signal at the times t such that t%factor==phase",
+					       "string (sig name)",
+					       "unsigned int (phase)")));
+  ADD_COMMAND("setAutoStagger",
+	      makeCommandVoid1(ent,setAutoStagger,
+			       docCommandVoid1("Spread the downsampled signals without explicit phase over the ticks",
+					       "bool")));
+  ADD_COMMAND("freeze",
+	      makeCommandVoid0(ent,freeze,
+			       docCommandVoid0("Evaluate the dependencies of the signals from a flat schedule.")));
+  ADD_COMMAND("unfreeze",
+	      makeCommandVoid0(ent,unfreeze,
+			       docCommandVoid0("Go back to the recursive evaluation of the signals.")));
+  ADD_COMMAND("disp",
+	      makeCommandVerbose(ent,disp,
+				 docCommandVerbose("Print the list of to-refresh signals and commands.")));
+  ADD_COMMAND("stats",
+	      makeCommandVerbose(ent,stats,
+				 docCommandVerbose("Print the execution time of the signals.")));
+  ADD_COMMAND("resetStats",
+	      makeCommandVoid0(ent,resetStats,
+			       docCommandVoid0("Reset the execution times of the signals.")));
+
+  boost::function< void( void ) >
+    start  = boost::bind( &AsyncPeriodicCall::start, this ),
+    stop  = boost::bind( &AsyncPeriodicCall::stop, this ),
+    resetCounters  = boost::bind( &AsyncPeriodicCall::resetCounters, this );
+  boost::function< void( std::ostream& ) >
+    status  = boost::bind( &AsyncPeriodicCall::display, this,_1 );
+
+  ADD_COMMAND("start",
+	      makeCommandVoid0(ent,start,
+			       docCommandVoid0("Launch the background thread, once the signals to call are added.")));
+  ADD_COMMAND("stop",
+	      makeCommandVoid0(ent,stop,
+			       docCommandVoid0("Stop the background thread, before changing the signals to call.")));
+  ADD_COMMAND("status",
+	      makeCommandVerbose(ent,status,
+				 docCommandVerbose("Print the snapshot signals and the number of posted, dropped and processed samples.")));
+  ADD_COMMAND("resetCounters",
+	      makeCommandVoid0(ent,resetCounters,
+			       docCommandVoid0("Reset the sample counters.")));
+}
+
+/*
+ * Local variables:
+ * c-basic-offset: 2
+ * End:
+ */
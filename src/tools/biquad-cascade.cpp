@@ -0,0 +1,255 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+
+#include <dynamic-graph/all-commands.h>
+#include <dynamic-graph/factory.h>
+
+#include <sot/core/factory.hh>
+#include <sot/core/biquad-cascade.hh>
+#include <sot/core/exception-tools.hh>
+#include <sot/core/debug.hh>
+
+namespace dg = ::dynamicgraph;
+
+/* ---------------------------------------------------------------------------*/
+/* ------- GENERIC HELPERS -------------------------------------------------- */
+/* ---------------------------------------------------------------------------*/
+
+namespace {
+  enum FilterType { LOW_PASS, HIGH_PASS };
+
+  /* Butterworth sections by the bilinear transform, the cutoff being
+   * prewarped: K = tan( pi fc T ). A pair of poles of angle theta (from the
+   * negative real axis) gives a section of quality factor 1/(2 cos theta);
+   * an odd order adds a first order section. */
+  dg::Matrix butterworth( const FilterType& type,const int& order,
+                          const double& cutoff,const double& samplingPeriod )
+  {
+    using dynamicgraph::sot::ExceptionTools;
+    if( order<1 || samplingPeriod<=0. || cutoff<=0. || cutoff*samplingPeriod>=.5 )
+      SOT_THROW ExceptionTools( ExceptionTools::GENERIC,
+                                "Butterworth filter needs order>=1 and "
+                                "0<cutoff<1/(2 samplingPeriod)",
+                                " (order %d, cutoff %g, period %g).",
+                                order,cutoff,samplingPeriod );
+
+    const double K = std::tan( M_PI*cutoff*samplingPeriod );
+    const int nbPairs = order/2;
+    dg::Matrix sos( nbPairs+order%2,6 );
+    for( int k=0;k<nbPairs;++k )
+      {
+        const double theta = ( 0==order%2 )
+          ? M_PI*( 2*k+1 )/( 2.*order ) : M_PI*( k+1 )/(double)order;
+        const double KQ = 2.*std::cos( theta )*K; // K/Q
+        const double norm = 1./( 1.+KQ+K*K );
+        const double b0 = ( LOW_PASS==type ) ? K*K*norm : norm;
+        sos.row( k ) << b0,( LOW_PASS==type ) ? 2.*b0 : -2.*b0,b0,
+          1.,2.*( K*K-1. )*norm,( 1.-KQ+K*K )*norm;
+      }
+    if( 1==order%2 )
+      {
+        const double norm = 1./( 1.+K );
+        const double b0 = ( LOW_PASS==type ) ? K*norm : norm;
+        sos.row( nbPairs ) << b0,( LOW_PASS==type ) ? b0 : -b0,0.,
+          1.,( K-1. )*norm,0.;
+      }
+    return sos;
+  }
+}
+
+namespace dynamicgraph {
+  namespace sot {
+
+
+DYNAMICGRAPH_FACTORY_ENTITY_PLUGIN(BiquadCascade,"BiquadCascade");
+
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+
+BiquadCascade::
+BiquadCascade( const std::string& n )
+  :Entity(n)
+   ,SIN(NULL,"BiquadCascade("+n+")::input(vector)::sin")
+   ,SOUT( boost::bind(&BiquadCascade::compute,this,_1,_2),
+          SIN,"BiquadCascade("+n+")::output(vector)::sout" )
+   ,sos( 0,6 )
+   ,init(false)
+{
+  signalRegistration( SIN<<SOUT );
+
+  using namespace dynamicgraph::command;
+  std::string docstring;
+  docstring =
+    "\n"
+    "    Load the second order sections.\n"
+    "\n"
+    "      Input:\n"
+    "        - a matrix with one row [ b0 b1 b2 a0 a1 a2 ] per section.\n"
+    "\n";
+  addCommand("setSos",
+             makeCommandVoid1(*this,&BiquadCascade::setSos,docstring));
+  addCommand("getSos",
+             makeDirectGetter(*this,&sos,
+                              docDirectGetter("sections, normalized by a0",
+                                              "matrix")));
+  docstring =
+    "\n"
+    "    Use a Butterworth low-pass filter.\n"
+    "\n"
+    "      Input:\n"
+    "        - the order,\n"
+    "        - the cutoff frequency (Hz),\n"
+    "        - the sampling period (s).\n"
+    "\n";
+  addCommand("setButterworthLowPass",
+             makeCommandVoid3(*this,&BiquadCascade::setButterworthLowPass,
+                              docstring));
+  docstring =
+    "\n"
+    "    Use a Butterworth high-pass filter.\n"
+    "\n"
+    "      Input:\n"
+    "        - the order,\n"
+    "        - the cutoff frequency (Hz),\n"
+    "        - the sampling period (s).\n"
+    "\n";
+  addCommand("setButterworthHighPass",
+             makeCommandVoid3(*this,&BiquadCascade::setButterworthHighPass,
+                              docstring));
+  addCommand("reset",
+             makeCommandVoid0(*this,&BiquadCascade::reset,
+                              docCommandVoid0("Restart from the next input, "
+                                              "as if it had always been constant.")));
+}
+
+BiquadCascade::~BiquadCascade()
+{
+}
+
+/* --- SECTIONS ---------------------------------------------------------- */
+/* --- SECTIONS ---------------------------------------------------------- */
+/* --- SECTIONS ---------------------------------------------------------- */
+
+void BiquadCascade::
+setSos( const dg::Matrix& sections )
+{
+  if( 6!=sections.cols() )
+    SOT_THROW ExceptionTools( ExceptionTools::GENERIC,
+                              "The sections must have 6 coefficients",
+                              " (%d given).",(int)sections.cols() );
+  for( dg::Matrix::Index s=0;s<sections.rows();++s )
+    if( 0.==sections( s,3 ) )
+      SOT_THROW ExceptionTools( ExceptionTools::GENERIC,
+                                "The coefficient a0 of a section is zero",
+                                " (section %d).",(int)s );
+
+  sos = sections;
+  for( dg::Matrix::Index s=0;s<sos.rows();++s )
+    sos.row( s ) /= sections( s,3 );
+  reset();
+}
+
+void BiquadCascade::
+setButterworthLowPass( const int& order,const double& cutoff,
+                       const double& samplingPeriod )
+{
+  setSos( butterworthLowPass( order,cutoff,samplingPeriod ) );
+}
+
+void BiquadCascade::
+setButterworthHighPass( const int& order,const double& cutoff,
+                        const double& samplingPeriod )
+{
+  setSos( butterworthHighPass( order,cutoff,samplingPeriod ) );
+}
+
+dg::Matrix BiquadCascade::
+butterworthLowPass( const int& order,const double& cutoff,
+                    const double& samplingPeriod )
+{
+  return butterworth( LOW_PASS,order,cutoff,samplingPeriod );
+}
+
+dg::Matrix BiquadCascade::
+butterworthHighPass( const int& order,const double& cutoff,
+                     const double& samplingPeriod )
+{
+  return butterworth( HIGH_PASS,order,cutoff,samplingPeriod );
+}
+
+void BiquadCascade::
+reset( void )
+{
+  init = false;
+}
+
+/* --- COMPUTE ----------------------------------------------------------- */
+/* --- COMPUTE ----------------------------------------------------------- */
+/* --- COMPUTE ----------------------------------------------------------- */
+
+/* Steady state of each section for a constant input: y = g x, with g the
+ * static gain of the section. */
+void BiquadCascade::
+initializeStates( const dg::Vector& in )
+{
+  const dg::Matrix::Index nbSections = sos.rows();
+  z1.setZero( in.size(),nbSections );
+  z2.setZero( in.size(),nbSections );
+  y.resize( in.size() );
+
+  Eigen::ArrayXd x = in.array();
+  for( dg::Matrix::Index s=0;s<nbSections;++s )
+    {
+      const double den = 1.+sos( s,4 )+sos( s,5 );
+      if( std::fabs( den )<1e-12 ) break; // Pole at 0 Hz: start from rest.
+      y = ( ( sos( s,0 )+sos( s,1 )+sos( s,2 ) )/den )*x;
+      z1.col( s ) = y-sos( s,0 )*x;
+      z2.col( s ) = sos( s,2 )*x-sos( s,5 )*y;
+      x = y;
+    }
+  init = true;
+}
+
+dg::Vector& BiquadCascade::
+compute( dg::Vector& res,const int& time )
+{
+  const dg::Vector& in = SIN( time );
+  if(! init || z1.rows()!=in.size() ) initializeStates( in );
+
+  /* Transposed direct form II, section after section, on all the channels. */
+  res = in;
+  Eigen::Map<Eigen::ArrayXd> x( res.data(),res.size() );
+  for( dg::Matrix::Index s=0;s<sos.rows();++s )
+    {
+      const double b0 = sos( s,0 ),b1 = sos( s,1 ),b2 = sos( s,2 );
+      const double a1 = sos( s,4 ),a2 = sos( s,5 );
+      y = b0*x+z1.col( s );
+      z1.col( s ) = b1*x-a1*y+z2.col( s );
+      z2.col( s ) = b2*x-a2*y;
+      x = y;
+    }
+  return res;
+}
+
+
+
+  } /* namespace sot */
+} /* namespace dynamicgraph */
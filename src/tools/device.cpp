@@ -31,9 +31,14 @@ using namespace std;
 #include <dynamic-graph/factory.h>
 #include <dynamic-graph/real-time-logger.h>
 #include <dynamic-graph/all-commands.h>
+#include <dynamic-graph/pool.h>
 #include <Eigen/Geometry>
 #include <dynamic-graph/linear-algebra.h>
 #include <sot/core/matrix-geometry.hh>
+#include <sot/core/exception-tools.hh>
+#include <sstream>
+#include <algorithm>
+#include <cmath>
 
 #include <pinocchio/multibody/liegroup/special-euclidean.hpp>
 using namespace dynamicgraph::sot;
@@ -45,21 +50,33 @@ const std::string Device::CLASS_NAME = "Device";
 /* --- CLASS ----------------------------------------------------------- */
 /* --------------------------------------------------------------------- */
 
+namespace {
+  typedef se3::SpecialEuclideanOperation<3> SE3;
+  typedef Eigen::Matrix<double, 7, 1> Vector7d;
+  typedef Eigen::Matrix<double, 6, 1> Vector6d;
+
+  // Position and quaternion of the freeflyer from position and roll pitch yaw.
+  inline void freeFlyerConfiguration (const Vector& state, Vector7d& q)
+  {
+    using Eigen::AngleAxisd;
+    using Eigen::Vector3d;
+    using Eigen::QuaternionMapd;
+
+    q.head<3>() = state.head<3>();
+    QuaternionMapd quat (q.tail<4>().data());
+    quat = AngleAxisd(state(5), Vector3d::UnitZ())
+         * AngleAxisd(state(4), Vector3d::UnitY())
+         * AngleAxisd(state(3), Vector3d::UnitX());
+  }
+}
+
 void Device::integrateRollPitchYaw(Vector& state, const Vector& control,
                                    double dt)
 {
-  using Eigen::AngleAxisd;
-  using Eigen::Vector3d;
   using Eigen::QuaternionMapd;
 
-  typedef se3::SpecialEuclideanOperation<3> SE3;
-  Eigen::Matrix<double, 7, 1> qin, qout;
-  qin.head<3>() = state.head<3>();
-
-  QuaternionMapd quat (qin.tail<4>().data());
-  quat = AngleAxisd(state(5), Vector3d::UnitZ())
-       * AngleAxisd(state(4), Vector3d::UnitY())
-       * AngleAxisd(state(3), Vector3d::UnitX());
+  Vector7d qin, qout;
+  freeFlyerConfiguration (state, qin);
 
   SE3().integrate (qin, control.head<6>()*dt, qout);
 
@@ -71,6 +88,24 @@ void Device::integrateRollPitchYaw(Vector& state, const Vector& control,
   state.segment<3>(3) = ffPose_.linear().eulerAngles(2,1,0).reverse();
 }
 
+void Device::integrateRollPitchYaw(Vector& state, const Vector6d& first,
+                                   const Vector6d& second, double dt)
+{
+  using Eigen::QuaternionMapd;
+
+  Vector7d qin, qmid, qout;
+  freeFlyerConfiguration (state, qin);
+
+  SE3().integrate (qin, first*dt, qmid);
+  SE3().integrate (qmid, second*dt, qout);
+
+  ffPose_.translation() = qout.head<3>();
+  state.head<3>() = qout.head<3>();
+
+  ffPose_.linear() = QuaternionMapd(qout.tail<4>().data()).toRotationMatrix();
+  state.segment<3>(3) = ffPose_.linear().eulerAngles(2,1,0).reverse();
+}
+
 const MatrixHomogeneous& Device::freeFlyerPose() const
 {
   return ffPose_;
@@ -90,6 +125,9 @@ Device( const std::string& n )
   ,state_(6)
   ,sanityCheck_(true)
   ,controlInputType_(CONTROL_INPUT_ONE_INTEGRATION)
+  ,integrator_(INTEGRATOR_EULER)
+  ,realTime_(false)
+  ,nanControls_(0)
   ,controlSIN( NULL,"Device("+n+")::input(double)::control" )   
   ,attitudeSIN(NULL,"Device("+ n +")::input(vector3)::attitudeIN")
   ,zmpSIN(NULL,"Device("+n+")::input(vector3)::zmp")
@@ -107,8 +145,10 @@ Device( const std::string& n )
 
   ,ffPose_()
   ,forceZero6 (6)
+  ,zmpZero3 (3)
 {
   forceZero6.fill (0);
+  zmpZero3.fill (0);
   /* --- SIGNALS --- */
   for( int i=0;i<4;++i ){ withForceSignals[i] = false; }
   forcesSOUT[0] =
@@ -125,10 +165,13 @@ Device( const std::string& n )
                       <<attitudeSIN<<zmpSIN <<*forcesSOUT[0]<<*forcesSOUT[1]
                       <<*forcesSOUT[2]<<*forcesSOUT[3] <<previousControlSOUT
                       <<pseudoTorqueSOUT << motorcontrolSOUT << ZMPPreviousControllerSOUT );
+  controlSchedule_.addRoot( controlSIN );
+
   state_.fill(.0); stateSOUT.setConstant( state_ );
 
   velocity_.resize(state_.size()); velocity_.setZero();
   velocitySOUT.setConstant( velocity_ );
+  vel_control_ = Vector::Zero(state_.size());
 
   /* --- Commands --- */
   {
@@ -187,6 +230,19 @@ Device( const std::string& n )
                new command::Setter<Device,string>
                (*this, &Device::setControlInputType, docstring));
 
+    docstring =
+        "\n"
+        "    Set the integration scheme of the second order control input,\n"
+        "    which can be euler, semiImplicitEuler, rk2 or rk4\n"
+        "\n"
+        "    The schemes differ on the free flyer: rk4 allows for larger\n"
+        "    time steps when the free flyer rotates.\n"
+        "\n";
+
+    addCommand("setIntegrator",
+               new command::Setter<Device,string>
+               (*this, &Device::setIntegrator, docstring));
+
     docstring =
         "\n"
         "    Enable/Disable sanity checks\n"
@@ -214,9 +270,48 @@ Device( const std::string& n )
 	       command::makeDirectGetter (*this, &this->timestep_,
 		command::docDirectGetter ("Time step", "double")));
     
+    addCommand("freeze",
+               command::makeCommandVoid0(*this,&Device::freeze,
+                 command::docCommandVoid0 ("Evaluate the control graph and the periodic calls from flat schedules.\n"
+                                           "The schedules are rebuilt when the graph changes, which is checked every 100 ticks.")
+                 ));
+
+    addCommand("unfreeze",
+               command::makeCommandVoid0(*this,&Device::unfreeze,
+                 command::docCommandVoid0 ("Go back to the recursive evaluation of the graph.")
+                 ));
+
+    docstring =
+        "\n"
+        "    Enable/Disable the real-time mode\n"
+        "\n"
+        "    In real-time mode, the bound violations are saturated and counted\n"
+        "    without being logged. Read the counters with boundViolations.\n"
+        "\n";
+    addCommand("setRealTime",
+               new command::Setter<Device, bool>
+               (*this, &Device::setRealTime, docstring));
+
+    addCommand("boundViolations",
+               command::makeCommandVerbose(*this,&Device::displayBoundViolations,
+                 command::docCommandVerbose ("Print the number of bound violations of each DoF, and of NaN controls.")
+                 ));
+
+    addCommand("resetBoundViolations",
+               command::makeCommandVoid0(*this,&Device::resetBoundViolations,
+                 command::docCommandVoid0 ("Reset the counters of bound violations.")
+                 ));
+
     // Handle commands and signals called in a synchronous way.
     periodicCallBefore_.addSpecificCommands(*this, commandMap, "before.");
     periodicCallAfter_.addSpecificCommands(*this, commandMap, "after.");
+    periodicCallAsync_.addSpecificCommands(*this, commandMap, "async.");
+
+    addCommand("async.addSnapshot",
+               command::makeCommandVoid2(*this,&Device::addSnapshot,
+                 command::docCommandVoid2 ("Add an output signal copying a vector signal at each tick, for the asynchronous lane",
+                                           "string (sig path)", "string (name of the output)")
+                 ));
 
   }
 }
@@ -232,8 +327,10 @@ setStateSize( const unsigned int& size )
 
   Device::setVelocitySize(size);
 
-  Vector zmp(3); zmp.fill( .0 );
-  ZMPPreviousControllerSOUT .setConstant( zmp );
+  // The buffers of the tick are allocated here, once.
+  vel_control_ = Vector::Zero(size);
+  positionViolations_ = Eigen::VectorXi::Zero(size);
+  ZMPPreviousControllerSOUT .setConstant( zmpZero3 );
 }
 
 void Device::
@@ -242,6 +339,7 @@ setVelocitySize( const unsigned int& size )
   velocity_.resize(size);
   velocity_.fill(.0);
   velocitySOUT.setConstant( velocity_ );
+  velocityViolations_ = Eigen::VectorXi::Zero(size);
 }
 
 void Device::
@@ -334,6 +432,21 @@ setControlInputType(const std::string& cit)
   sotDEBUG(25)<<"Unrecognized control input type: "<<cit<<endl;
 }
 
+void Device::
+setIntegrator(const std::string& integrator)
+{
+  for(int i=0; i<INTEGRATOR_SIZE; i++)
+    if(integrator==Integrator_s[i])
+    {
+      integrator_ = (Integrator)i;
+      sotDEBUG(25)<<"Integrator: "<<Integrator_s[i]<<endl;
+      return;
+    }
+  SOT_THROW ExceptionTools( ExceptionTools::GENERIC,
+                            "Unrecognized integrator",
+                            " ('%s').", integrator.c_str() );
+}
+
 void Device::
 setSanityCheck(const bool & enableCheck)
 {
@@ -381,6 +494,8 @@ setPositionBounds(const Vector& lower, const Vector& upper)
   }
   lowerPosition_ = lower;
   upperPosition_ = upper;
+  if (positionViolations_.size() != lower.size())
+    positionViolations_ = Eigen::VectorXi::Zero(lower.size());
 }
 
 void Device::
@@ -397,6 +512,8 @@ setVelocityBounds(const Vector& lower, const Vector& upper)
   }
   lowerVelocity_ = lower;
   upperVelocity_ = upper;
+  if (velocityViolations_.size() != lower.size())
+    velocityViolations_ = Eigen::VectorXi::Zero(lower.size());
 }
 
 void Device::
@@ -416,6 +533,63 @@ setTorqueBounds  (const Vector& lower, const Vector& upper)
   upperTorque_ = upper;
 }
 
+void Device::
+setRealTime(const bool & realTime)
+{
+  realTime_ = realTime;
+}
+
+void Device::
+displayBoundViolations(std::ostream& os)
+{
+  os << "NaN controls: " << nanControls_ << endl;
+  for (Vector::Index i = 0; i < positionViolations_.size(); ++i)
+    if (0 != positionViolations_(i))
+      os << "position, DoF " << i << ": " << positionViolations_(i) << endl;
+  for (Vector::Index i = 0; i < velocityViolations_.size(); ++i)
+    if (0 != velocityViolations_(i))
+      os << "velocity, DoF " << i << ": " << velocityViolations_(i) << endl;
+}
+
+void Device::
+resetBoundViolations()
+{
+  positionViolations_.setZero();
+  velocityViolations_.setZero();
+  nanControls_ = 0;
+}
+
+void Device::
+freeze()
+{
+  controlSchedule_.freeze();
+  periodicCallBefore_.freeze();
+  periodicCallAfter_.freeze();
+}
+
+void Device::
+unfreeze()
+{
+  controlSchedule_.unfreeze();
+  periodicCallBefore_.unfreeze();
+  periodicCallAfter_.unfreeze();
+}
+
+void Device::
+addSnapshot(const std::string& sigpath, const std::string& name)
+{
+  std::istringstream sigISS( sigpath );
+  SignalBase<int>& sig = PoolStorage::getInstance()->getSignal( sigISS );
+  AsyncPeriodicCall::VectorSignal* source =
+      dynamic_cast<AsyncPeriodicCall::VectorSignal*>( &sig );
+  if( NULL==source )
+    SOT_THROW ExceptionTools( ExceptionTools::GENERIC,
+                              "Only vector signals can be snapshot",
+                              " ('%s').", sigpath.c_str() );
+  signalRegistration( periodicCallAsync_.addSnapshot
+                      ( *source,"Device("+getName()+")::output(vector)::"+name ) );
+}
+
 void Device::
 increment( const double & dt )
 {
@@ -424,32 +598,11 @@ increment( const double & dt )
 
   // Run Synchronous commands and evaluate signals outside the main
   // connected component of the graph.
-  try
-  {
-    periodicCallBefore_.run(time+1);
-  }
-  catch (std::exception& e)
-  {
-    dgRTLOG()
-        << "exception caught while running periodical commands (before): "
-        << e.what () << std::endl;
-  }
-  catch (const char* str)
-  {
-    dgRTLOG()
-        << "exception caught while running periodical commands (before): "
-        << str << std::endl;
-  }
-  catch (...)
-  {
-    dgRTLOG()
-        << "unknown exception caught while"
-        << " running periodical commands (before)" << std::endl;
-  }
+  runPeriodicCall(periodicCallBefore_, time+1, "before");
 
-
-  /* Force the recomputation of the control. */
-  controlSIN( time );
+  /* Force the recomputation of the control: the pull of controlSIN,
+   * preceded by the evaluation of the schedule when the graph is frozen. */
+  controlSchedule_.run( time );
   sotDEBUG(25) << "u" <<time<<" = " << controlSIN.accessCopy() << endl;
 
   /* Integration of numerical values. This function is virtual. */
@@ -472,112 +625,170 @@ increment( const double & dt )
   for( int i=0;i<4;++i ){
     if(  !withForceSignals[i] ) forcesSOUT[i]->setConstant(forceZero6);
   }
-  Vector zmp(3); zmp.fill( .0 );
-  ZMPPreviousControllerSOUT .setConstant( zmp );
+  ZMPPreviousControllerSOUT .setConstant( zmpZero3 );
 
   // Run Synchronous commands and evaluate signals outside the main
   // connected component of the graph.
+  runPeriodicCall(periodicCallAfter_, time+1, "after");
+
+  // Others signals.
+  motorcontrolSOUT .setConstant( state_ );
+
+  // Hand the values of the tick over to the asynchronous lane.
+  periodicCallAsync_.post(time+1);
+}
+
+void Device::
+runPeriodicCall(PeriodicCall& calls, const int& time, const char* which)
+{
   try
   {
-    periodicCallAfter_.run(time+1);
+    calls.run(time);
   }
   catch (std::exception& e)
   {
     dgRTLOG()
-        << "exception caught while running periodical commands (after): "
-        << e.what () << std::endl;
+        << "exception caught while running periodical commands ("
+        << which << "): " << e.what () << std::endl;
   }
   catch (const char* str)
   {
     dgRTLOG()
-        << "exception caught while running periodical commands (after): "
-        << str << std::endl;
+        << "exception caught while running periodical commands ("
+        << which << "): " << str << std::endl;
   }
   catch (...)
   {
     dgRTLOG()
         << "unknown exception caught while"
-        << " running periodical commands (after)" << std::endl;
+        << " running periodical commands (" << which << ")" << std::endl;
   }
-
-
-  // Others signals.
-  motorcontrolSOUT .setConstant( state_ );
 }
 
-// Return true if it saturates.
-inline bool
-saturateBounds (double& val, const double& lower, const double& upper)
+Vector::Index Device::
+checkBounds(Vector& val, const Vector& lower, const Vector& upper,
+            Eigen::VectorXi& violations, const char* what)
 {
-  assert (lower <= upper);
-  if (val < lower) { val = lower; return true; }
-  if (upper < val) { val = upper; return true; }
-  return false;
+  if (   lower.size() != val.size() || upper.size() != val.size()
+      || violations.size() != val.size())
+    return 0;
+
+  // Nothing is written in the usual case, where val is within bounds.
+  const Vector::Index n =
+      ((val.array() < lower.array()) || (upper.array() < val.array())).count();
+  if (0 == n) return 0;
+
+  if (!realTime_)
+    for (Vector::Index i = 0; i < val.size(); ++i)
+      if (val(i) < lower(i) || upper(i) < val(i))
+        dgRTLOG () << "Robot " << what << " bound violation at DoF " << i
+                   << ": requested " << val(i) << " but set "
+                   << std::min(std::max(val(i), lower(i)), upper(i)) << '\n';
+
+  violations.array() +=
+      ((val.array() < lower.array()) || (upper.array() < val.array()))
+      .cast<int>();
+  val = val.cwiseMax(lower).cwiseMin(upper);
+  return n;
 }
 
-#define CHECK_BOUNDS(val, lower, upper, what)                                  \
-  for (int i = 0; i < val.size(); ++i) {                                       \
-    double old = val(i);                                                       \
-    if (saturateBounds (val(i), lower(i), upper(i)))                           \
-      dgRTLOG () << "Robot "what" bound violation at DoF " << i <<             \
-      ": requested " << old << " but set " << val(i) << '\n';                  \
-  }
-
 void Device::integrate( const double & dt )
 {
   const Vector & controlIN = controlSIN.accessCopy();
 
+  const Vector::Index n = controlIN.size();
+
   if (sanityCheck_ && controlIN.hasNaN())
   {
-    dgRTLOG () << "Device::integrate: Control has NaN values: " << '\n'
-               << controlIN.transpose() << '\n';
+    ++nanControls_;
+    if (!realTime_)
+      dgRTLOG () << "Device::integrate: Control has NaN values: " << '\n'
+                 << controlIN.transpose() << '\n';
     return;
   }
 
   if (controlInputType_==CONTROL_INPUT_NO_INTEGRATION)
   {
-    assert(state_.size()==controlIN.size()+6);
-    state_.tail(controlIN.size()) = controlIN;
-    CHECK_BOUNDS(state_, lowerPosition_, upperPosition_, "position");
+    assert(state_.size()==n+6);
+    state_.tail(n) = controlIN;
+    checkBounds(state_, lowerPosition_, upperPosition_,
+                positionViolations_, "position");
     return;
   }
 
-  if( vel_control_.size() == 0 )
-    vel_control_ = Vector::Zero(controlIN.size());
+  // vel_control_ is allocated by setStateSize, with the size of the state.
+  if( vel_control_.size() < n )
+    vel_control_ = Vector::Zero(n);
+  Eigen::VectorBlock<Vector> velControl = vel_control_.head(n);
 
   // If control size is state size - 6, integrate joint angles,
   // if control and state are of same size, integrate 6 first degrees of
   // freedom as a translation and roll pitch yaw.
 
+  // Free flyer twist at the beginning of the step.
+  const bool withFreeFlyer = (n == state_.size());
+  Vector6d twist;
+  if (withFreeFlyer) twist = velocity_.head<6>();
+
   if (controlInputType_==CONTROL_INPUT_TWO_INTEGRATION)
   {
     // TODO check acceleration
-    // Position increment
-    vel_control_ = velocity_.tail(controlIN.size()) + (0.5*dt)*controlIN;
-    // Velocity integration.
-    velocity_.tail(controlIN.size()) += controlIN*dt;
+    if (integrator_==INTEGRATOR_SEMI_IMPLICIT_EULER)
+    {
+      // Velocity integration, then position increment at the new velocity.
+      velocity_.tail(n) += controlIN*dt;
+      velControl = velocity_.tail(n);
+    }
+    else
+    {
+      // Position increment, exact for a constant acceleration.
+      velControl = velocity_.tail(n) + (0.5*dt)*controlIN;
+      // Velocity integration.
+      velocity_.tail(n) += controlIN*dt;
+    }
   }
   else
   {
-    vel_control_ = controlIN;
+    velControl = controlIN;
   }
 
   // Velocity bounds check
   if (sanityCheck_) {
-    CHECK_BOUNDS(velocity_, lowerVelocity_, upperVelocity_, "velocity");
+    checkBounds(velocity_, lowerVelocity_, upperVelocity_,
+                velocityViolations_, "velocity");
   }
 
   // Freeflyer integration
-  if (vel_control_.size() == state_.size()) {
-    integrateRollPitchYaw(state_, vel_control_, dt);
+  Vector::Index nJoints = n;
+  if (withFreeFlyer) {
+    nJoints = n-6;
+    if (controlInputType_==CONTROL_INPUT_TWO_INTEGRATION
+        && integrator_==INTEGRATOR_RK2)
+    {
+      // Half a step at the initial twist, half a step at the final twist.
+      const Vector6d twistEnd = twist + controlIN.head<6>()*dt;
+      integrateRollPitchYaw(state_, .5*twist, .5*twistEnd, dt);
+    }
+    else if (controlInputType_==CONTROL_INPUT_TWO_INTEGRATION
+             && integrator_==INTEGRATOR_RK4)
+    {
+      // Twists at the two Gauss points of the step.
+      const double s = std::sqrt(3.)/6, a1 = .25+s, a2 = .25-s;
+      const Vector6d t1 = twist + controlIN.head<6>()*((.5-s)*dt);
+      const Vector6d t2 = twist + controlIN.head<6>()*((.5+s)*dt);
+      integrateRollPitchYaw(state_, a1*t1+a2*t2, a2*t1+a1*t2, dt);
+    }
+    else
+      integrateRollPitchYaw(state_, vel_control_, dt);
   }
 
   // Position integration
-  state_.tail(controlIN.size()) += vel_control_ * dt;
+  state_.tail(nJoints) += velControl.tail(nJoints) * dt;
 
   // Position bounds check
   if (sanityCheck_) {
-    CHECK_BOUNDS(state_, lowerPosition_, upperPosition_, "position");
+    checkBounds(state_, lowerPosition_, upperPosition_,
+                positionViolations_, "position");
   }
 }
 
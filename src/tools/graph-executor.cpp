@@ -0,0 +1,524 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+/* --- SOT --- */
+#include <sot/core/graph-executor.hh>
+#include <sot/core/debug.hh>
+#include <sot/core/exception-tools.hh>
+#include <dynamic-graph/all-commands.h>
+#include <dynamic-graph/exception-factory.h>
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <sstream>
+
+#if defined (__linux__)
+# include <pthread.h>
+# include <sched.h>
+#endif
+
+using namespace std;
+using namespace dynamicgraph;
+using namespace dynamicgraph::sot;
+
+/* --------------------------------------------------------------------- */
+/* --- PARTITION ------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+namespace {
+  /* Signals are named "Class(entity)::io(type)::name": the name between
+   * the parentheses identifies the entity owning the signal, whatever the
+   * class declaring the signal (sotTaskAbstract or sotTask). */
+  std::string ownerKey( const std::string& signalName )
+  {
+    const std::string::size_type open = signalName.find( '(' );
+    const std::string::size_type close = signalName.find( ')',open );
+    if( std::string::npos==open || std::string::npos==close )
+      return signalName;
+    return signalName.substr( open+1,close-open-1 );
+  }
+
+  /* Strongly connected components of a graph (Tarjan). */
+  struct Components
+  {
+    const std::vector< std::set<std::size_t> >& successors;
+    std::vector<int> index,lowlink;
+    std::vector<bool> onStack;
+    std::vector<std::size_t> stack;
+    std::vector<std::size_t> component;
+    int counter;
+    std::size_t nbComponents;
+
+    Components( const std::vector< std::set<std::size_t> >& succ )
+      : successors( succ )
+      ,index( succ.size(),-1 ),lowlink( succ.size(),0 )
+      ,onStack( succ.size(),false ),stack()
+      ,component( succ.size(),0 )
+      ,counter( 0 ),nbComponents( 0 )
+    {
+      for( std::size_t v=0;v<succ.size();++v )
+	if( index[v]<0 ) connect( v );
+    }
+
+    void connect( const std::size_t v )
+    {
+      index[v] = lowlink[v] = counter++;
+      stack.push_back( v ); onStack[v] = true;
+      for( std::set<std::size_t>::const_iterator iter = successors[v].begin();
+	   successors[v].end()!=iter; ++iter )
+	{
+	  if( index[*iter]<0 )
+	    { connect( *iter ); lowlink[v] = std::min( lowlink[v],lowlink[*iter] ); }
+	  else if( onStack[*iter] )
+	    { lowlink[v] = std::min( lowlink[v],index[*iter] ); }
+	}
+      if( lowlink[v]==index[v] )
+	{
+	  std::size_t w;
+	  do
+	    {
+	      w = stack.back(); stack.pop_back(); onStack[w] = false;
+	      component[w] = nbComponents;
+	    } while( w!=v );
+	  ++nbComponents;
+	}
+    }
+  };
+}
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+GraphExecutor::
+GraphExecutor( void )
+  : schedule()
+  ,tasks()
+  ,partitionCount( 0 )
+  ,workerCount( 1 )
+  ,cpus()
+  ,deterministic( false )
+  ,started( false )
+  ,threads()
+  ,queues()
+  ,pending()
+  ,remaining( 0 )
+  ,queued( 0 )
+  ,generation( 0 )
+  ,stopping( false )
+  ,runTime( 0 )
+{
+}
+
+GraphExecutor::
+~GraphExecutor( void )
+{
+  joinWorkers();
+}
+
+void GraphExecutor::
+partition( void )
+{
+  sotDEBUGIN(15);
+
+  const std::vector<SignalType*>& signals = schedule.getSchedule();
+  const std::vector< std::vector<std::size_t> >& predecessors
+    = schedule.getPredecessors();
+  const std::size_t nbSignals = signals.size();
+
+  /* Group the signals by entity. */
+  std::map<std::string,std::size_t> groups;
+  std::vector<std::size_t> group( nbSignals );
+  for( std::size_t i=0;i<nbSignals;++i )
+    {
+      const std::string key = ownerKey( signals[i]->getName() );
+      std::map<std::string,std::size_t>::iterator
+	found = groups.insert( std::make_pair( key,groups.size() ) ).first;
+      group[i] = found->second;
+    }
+
+  /* Entities depending on each other are merged. */
+  std::vector< std::set<std::size_t> > groupSuccessors( groups.size() );
+  for( std::size_t i=0;i<nbSignals;++i )
+    for( std::size_t k=0;k<predecessors[i].size();++k )
+      {
+	const std::size_t from = group[ predecessors[i][k] ];
+	if( from!=group[i] ) groupSuccessors[from].insert( group[i] );
+      }
+  const Components components( groupSuccessors );
+
+  tasks.assign( components.nbComponents,Task() );
+  std::vector< std::set<std::size_t> > successors( tasks.size() );
+  for( std::size_t i=0;i<nbSignals;++i )
+    {
+      const std::size_t to = components.component[ group[i] ];
+      tasks[to].signals.push_back( i );
+      for( std::size_t k=0;k<predecessors[i].size();++k )
+	{
+	  const std::size_t from
+	    = components.component[ group[ predecessors[i][k] ] ];
+	  if( from!=to ) successors[from].insert( to );
+	}
+    }
+  for( std::size_t t=0;t<tasks.size();++t )
+    {
+      tasks[t].nbPredecessors = 0;
+      tasks[t].successors.assign( successors[t].begin(),successors[t].end() );
+    }
+  for( std::size_t t=0;t<tasks.size();++t )
+    for( std::size_t k=0;k<tasks[t].successors.size();++k )
+      ++tasks[ tasks[t].successors[k] ].nbPredecessors;
+
+  /* The update test of a signal that its task does not evaluate would be
+   * run by each task reading it, concurrently when there are several:
+   * such a signal is evaluated by its own task. */
+  std::vector< std::set<std::size_t> > readers( nbSignals );
+  for( std::size_t i=0;i<nbSignals;++i )
+    {
+      const std::size_t to = components.component[ group[i] ];
+      for( std::size_t k=0;k<predecessors[i].size();++k )
+	{
+	  const std::size_t p = predecessors[i][k];
+	  if( components.component[ group[p] ]!=to ) readers[p].insert( to );
+	}
+    }
+  for( std::size_t i=0;i<nbSignals;++i )
+    if( readers[i].size()>1 ) schedule.force( i );
+
+  pending.resize( tasks.size() );
+  partitionCount = schedule.getRebuildCount();
+  sotDEBUG(15) << nbSignals << " signals in " << tasks.size()
+	       << " tasks" << std::endl;
+  sotDEBUGOUT(15);
+}
+
+/* --------------------------------------------------------------------- */
+/* --- WORKERS --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+void GraphExecutor::
+launchWorkers( void )
+{
+  unsigned int seen;
+  {
+    boost::mutex::scoped_lock lock( stateMutex );
+    stopping = false;
+    seen = generation;
+  }
+  for( unsigned int id=0;id<workerCount;++id )
+    queues.push_back( new WorkerQueue() );
+  for( unsigned int id=1;id<workerCount;++id )
+    threads.push_back
+      ( new boost::thread( boost::bind( &GraphExecutor::workerLoop,this,id,seen ) ) );
+}
+
+void GraphExecutor::
+joinWorkers( void )
+{
+  {
+    boost::mutex::scoped_lock lock( stateMutex );
+    stopping = true;
+  }
+  stateCond.notify_all();
+  for( std::size_t k=0;k<threads.size();++k )
+    { threads[k]->join(); delete threads[k]; }
+  threads.clear();
+  for( std::size_t k=0;k<queues.size();++k ) delete queues[k];
+  queues.clear();
+}
+
+void GraphExecutor::
+workerLoop( const unsigned int id,unsigned int seen )
+{
+#if defined (__linux__)
+  if(! cpus.empty() )
+    {
+      cpu_set_t set;
+      CPU_ZERO( &set );
+      CPU_SET( cpus[ (id-1)%cpus.size() ],&set );
+      if( 0!=pthread_setaffinity_np( pthread_self(),sizeof(set),&set ) )
+	{ sotDEBUG(5) << "Cannot pin worker " << id << " on CPU "
+		      << cpus[ (id-1)%cpus.size() ] << std::endl; }
+    }
+#endif
+
+  for(;;)
+    {
+      {
+	boost::mutex::scoped_lock lock( stateMutex );
+	while( !stopping && generation==seen ) stateCond.wait( lock );
+	if( stopping ) return;
+	seen = generation;
+      }
+      work( id );
+    }
+}
+
+/* The owner takes its most recent task, thieves take the oldest one. */
+bool GraphExecutor::
+popTask( const unsigned int id,std::size_t& task )
+{
+  const std::size_t nbQueues = queues.size();
+  for( std::size_t k=0;k<nbQueues;++k )
+    {
+      WorkerQueue& queue = *queues[ (id+k)%nbQueues ];
+      boost::mutex::scoped_lock lock( queue.mutex );
+      if( queue.tasks.empty() ) continue;
+      if( 0==k ) { task = queue.tasks.back(); queue.tasks.pop_back(); }
+      else { task = queue.tasks.front(); queue.tasks.pop_front(); }
+      return true;
+    }
+  return false;
+}
+
+void GraphExecutor::
+pushTask( const unsigned int id,const std::size_t task )
+{
+  {
+    boost::mutex::scoped_lock lock( stateMutex );
+    {
+      boost::mutex::scoped_lock lockQueue( queues[id]->mutex );
+      queues[id]->tasks.push_back( task );
+    }
+    ++queued;
+  }
+  stateCond.notify_all();
+}
+
+void GraphExecutor::
+execute( const std::size_t task )
+{
+  const std::vector<std::size_t>& indices = tasks[task].signals;
+  for( std::size_t k=0;k<indices.size();++k )
+    {
+      if( schedule.isActive( indices[k] ) )
+	schedule.evaluate( indices[k],runTime );
+    }
+}
+
+void GraphExecutor::
+work( const unsigned int id )
+{
+  std::vector<std::size_t> ready;
+  for(;;)
+    {
+      std::size_t task;
+      if( popTask( id,task ) )
+	{
+	  {
+	    boost::mutex::scoped_lock lock( stateMutex );
+	    --queued;
+	  }
+	  execute( task );
+
+	  ready.clear();
+	  bool done;
+	  {
+	    boost::mutex::scoped_lock lock( stateMutex );
+	    const std::vector<std::size_t>& successors = tasks[task].successors;
+	    for( std::size_t k=0;k<successors.size();++k )
+	      if( 0==--pending[ successors[k] ] ) ready.push_back( successors[k] );
+	    done = ( 0==--remaining );
+	  }
+	  for( std::size_t k=0;k<ready.size();++k ) pushTask( id,ready[k] );
+	  if( done ) stateCond.notify_all();
+	  continue;
+	}
+
+      boost::mutex::scoped_lock lock( stateMutex );
+      if( 0==remaining ) return;
+      if( 0==queued ) stateCond.wait( lock );
+    }
+}
+
+/* --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+void GraphExecutor::
+start( void )
+{
+  if( started ) stop();
+  schedule.freeze();
+  partition();
+  launchWorkers();
+  started = true;
+}
+
+void GraphExecutor::
+stop( void )
+{
+  joinWorkers();
+  schedule.unfreeze();
+  tasks.clear();
+  started = false;
+}
+
+void GraphExecutor::
+setWorkerCount( const unsigned int& nb )
+{
+  if( started ) joinWorkers();
+  workerCount = std::max( nb,1u );
+  if( started ) launchWorkers();
+}
+
+void GraphExecutor::
+setAffinity( const std::string& list )
+{
+  std::vector<int> res;
+  std::istringstream iss( list );
+  int cpu;
+  while( iss >> cpu ) res.push_back( cpu );
+  if(! iss.eof() )
+    { SOT_THROW ExceptionTools( ExceptionTools::GENERIC,
+				"The affinity should be a list of integers",
+				" (got '%s').",list.c_str() ); }
+
+  if( started ) joinWorkers();
+  cpus = res;
+  if( started ) launchWorkers();
+}
+
+void GraphExecutor::
+setDeterministic( const bool& det )
+{
+  deterministic = det;
+}
+
+void GraphExecutor::
+run( const int& time )
+{
+  if(! started ) return;
+
+  if( deterministic || workerCount<=1 )
+    {
+      schedule.runDependencies( time );
+      return;
+    }
+
+  if( schedule.prepare( time ) || partitionCount!=schedule.getRebuildCount() )
+    partition();
+  if( tasks.empty() ) return;
+
+  {
+    boost::mutex::scoped_lock lock( stateMutex );
+    runTime = time;
+    remaining = tasks.size();
+    queued = 0;
+    for( std::size_t t=0;t<tasks.size();++t )
+      pending[t] = tasks[t].nbPredecessors;
+  }
+
+  /* Spread the ready tasks over the workers, then wake them up. */
+  unsigned int worker = 0;
+  for( std::size_t t=0;t<tasks.size();++t )
+    if( 0==tasks[t].nbPredecessors )
+      { pushTask( worker,t ); worker = (worker+1)%workerCount; }
+  {
+    boost::mutex::scoped_lock lock( stateMutex );
+    ++generation;
+  }
+  stateCond.notify_all();
+
+  /* Join. */
+  work( 0 );
+}
+
+/* --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+void GraphExecutor::
+display( std::ostream& os ) const
+{
+  os << " -> EXECUTOR: " << ( started ? "started" : "stopped" )
+     << ", " << workerCount << " workers"
+     << ( deterministic ? " (deterministic)" : "" ) << endl;
+  if(! started ) return;
+
+  const std::vector<SignalType*>& signals = schedule.getSchedule();
+  for( std::size_t t=0;t<tasks.size();++t )
+    {
+      os << " - task " << t << " (" << tasks[t].nbPredecessors
+	 << " predecessors):";
+      for( std::size_t k=0;k<tasks[t].signals.size();++k )
+	os << " " << signals[ tasks[t].signals[k] ]->getName();
+      os << endl;
+    }
+}
+
+#define ADD_COMMAND( name,def )                                     \
+if (commandMap.count(prefix+name) != 0) {                            \
+  DG_THROW ExceptionFactory(ExceptionFactory::OBJECT_CONFLICT,        \
+			    "Command " + prefix+name +	               \
+			    " already registered in Entity.");          \
+ }                                                                       \
+commandMap.insert( std::make_pair( prefix+name,def ) )
+
+
+void GraphExecutor::addSpecificCommands(Entity& ent,
+					Entity::CommandMap_t& commandMap,
+					const std::string& prefix )
+{
+  using namespace dynamicgraph::command;
+
+  /* Explicit typage to help the compiler. */
+  boost::function< void( void ) >
+    start  = boost::bind( &GraphExecutor::start, this ),
+    stop  = boost::bind( &GraphExecutor::stop, this );
+  boost::function< void( const unsigned int& ) >
+    setWorkerCount  = boost::bind( &GraphExecutor::setWorkerCount, this,_1 );
+  boost::function< void( const std::string& ) >
+    setAffinity  = boost::bind( &GraphExecutor::setAffinity, this,_1 );
+  boost::function< void( const bool& ) >
+    setDeterministic  = boost::bind( &GraphExecutor::setDeterministic, this,_1 );
+  boost::function< void( std::ostream& ) >
+    disp  = boost::bind( &GraphExecutor::display, this,_1 );
+
+  ADD_COMMAND("start",
+	      makeCommandVoid0(ent,start,
+			       docCommandVoid0("Partition the graph and evaluate it in parallel.")));
+  ADD_COMMAND("stop",
+	      makeCommandVoid0(ent,stop,
+			       docCommandVoid0("Stop the workers and go back to the serial evaluation.")));
+  ADD_COMMAND("setWorkerCount",
+	      makeCommandVoid1(ent,setWorkerCount,
+			       docCommandVoid1("Set the number of workers, including the calling thread.",
+					       "unsigned int")));
+  ADD_COMMAND("setAffinity",
+	      makeCommandVoid1(ent,setAffinity,
+			       docCommandVoid1("Pin the workers on the given CPUs.",
+					       "string (list of CPU numbers, empty to unpin)")));
+  ADD_COMMAND("setDeterministic",
+	      makeCommandVoid1(ent,setDeterministic,
+			       docCommandVoid1("Evaluate the graph serially, in a fixed order.",
+					       "bool")));
+  ADD_COMMAND("disp",
+	      makeCommandVerbose(ent,disp,
+				 docCommandVerbose("Print the tasks of the partition.")));
+}
+
+/*
+ * Local variables:
+ * c-basic-offset: 2
+ * End:
+ */
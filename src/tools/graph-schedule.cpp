@@ -0,0 +1,411 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+/* --- SOT --- */
+#include <sot/core/graph-schedule.hh>
+#include <sot/core/debug.hh>
+#include <dynamic-graph/exception-abstract.h>
+#include <algorithm>
+
+using namespace std;
+using namespace dynamicgraph;
+using namespace dynamicgraph::sot;
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+GraphSchedule::
+GraphSchedule( void )
+  : roots()
+  ,nodes()
+  ,schedule()
+  ,predecessors()
+  ,steps()
+  ,children()
+  ,active()
+  ,forced()
+  ,learningState( LEARNING_WAIT )
+  ,learningTime( 0 )
+  ,visited()
+  ,frozen( false )
+  ,rebuildCount( 0 )
+  ,checkPeriod( DEFAULT_CHECK_PERIOD )
+  ,ticksToCheck( 0 )
+{
+}
+
+void GraphSchedule::
+addRoot( SignalType& sig )
+{
+  roots.push_back( &sig );
+  if( frozen ) freeze();
+}
+
+void GraphSchedule::
+clearRoots( void )
+{
+  roots.clear();
+  if( frozen ) freeze();
+}
+
+/* --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+/* The dependency lists are compared as sets: a permutation does not
+ * change the order of evaluation. */
+bool GraphSchedule::
+sameDependencies( const DependencyType& dep,
+		  const std::vector<const SignalType*>& sorted )
+{
+  std::size_t nb = 0;
+  for( DependencyType::Dependencies::const_iterator iter
+	 = dep.dependencies.begin();
+       dep.dependencies.end()!=iter; ++iter,++nb )
+    {
+      if(! std::binary_search( sorted.begin(),sorted.end(),*iter ) )
+	return false;
+    }
+  return nb==sorted.size();
+}
+
+/* Depth-first post-order: the dependencies of a signal are scheduled
+ * before it. A signal met again while in progress closes a loop of the
+ * graph: the edge is ignored, the pull resolves it as before. The roots
+ * themselves are not scheduled, since they are pulled last, unless
+ * another signal depends on them: all their own dependencies are sorted by
+ * then, so they can be appended to the schedule at this point. */
+void GraphSchedule::
+visit( SignalType* sig,const bool isRoot )
+{
+  int& state = visited[ sig ];
+  if( state==3 && !isRoot )
+    { schedule.push_back( sig ); state = 2; }
+  if( state!=0 ) return;
+  state = 1;
+
+  Node node;
+  node.signal = sig;
+  node.dependency = dynamic_cast<const DependencyType*>( sig );
+  node.plugged = sig->getPluged();
+
+  if( NULL!=node.plugged && sig!=node.plugged )
+    { visit( const_cast<SignalType*>( node.plugged ),false ); }
+
+  if( NULL!=node.dependency )
+    {
+      const DependencyType::Dependencies & deps = node.dependency->dependencies;
+      node.dependencies.assign( deps.begin(),deps.end() );
+      std::sort( node.dependencies.begin(),node.dependencies.end() );
+      for( DependencyType::Dependencies::const_iterator iter = deps.begin();
+	   deps.end()!=iter; ++iter )
+	{ visit( const_cast<SignalType*>( *iter ),false ); }
+      if(! isRoot ) schedule.push_back( sig );
+    }
+
+  nodes.push_back( node );
+  visited[ sig ] = ( isRoot&&NULL!=node.dependency ) ? 3 : 2;
+}
+
+/* The children of a signal are its dependencies. A child plugged to a
+ * scheduled signal is replaced by it, since its update test and its time
+ * are the ones of the plugged signal. */
+GraphSchedule::Step GraphSchedule::
+makeStep( SignalType* sig,const std::map<const SignalType*,std::size_t>& index )
+{
+  Step step;
+  step.signal = sig;
+  step.dependency = dynamic_cast<const DependencyType*>( sig );
+  step.begin = children.size();
+  if( NULL!=step.dependency )
+    {
+      const DependencyType::Dependencies & deps = step.dependency->dependencies;
+      for( DependencyType::Dependencies::const_iterator iter = deps.begin();
+	   deps.end()!=iter; ++iter )
+	{
+	  const SignalType* target = *iter;
+	  const SignalType* plugged = target->getPluged();
+	  while( NULL!=plugged && target!=plugged
+		 && index.end()==index.find( target ) )
+	    { target = plugged; plugged = target->getPluged(); }
+
+	  Child child;
+	  std::map<const SignalType*,std::size_t>::const_iterator
+	    found = index.find( target );
+	  child.signal = ( index.end()!=found ) ? target : *iter;
+	  child.index = ( index.end()!=found ) ? found->second : NOT_SCHEDULED;
+	  children.push_back( child );
+	}
+    }
+  step.end = children.size();
+  return step;
+}
+
+/* Scheduled signals reached from sig, crossing the unscheduled ones. */
+void GraphSchedule::
+collectPredecessors( const SignalType* sig,
+		     const std::map<const SignalType*,std::size_t>& index,
+		     std::vector<std::size_t>& res )
+{
+  const SignalType* plugged = sig->getPluged();
+  const DependencyType* dependency = dynamic_cast<const DependencyType*>( sig );
+
+  std::vector<const SignalType*> children;
+  if( NULL!=plugged && sig!=plugged ) children.push_back( plugged );
+  if( NULL!=dependency )
+    children.insert( children.end(),dependency->dependencies.begin(),
+		     dependency->dependencies.end() );
+
+  for( std::vector<const SignalType*>::const_iterator iter = children.begin();
+       children.end()!=iter; ++iter )
+    {
+      if( visited[ *iter ]!=0 ) continue;
+      visited[ *iter ] = 1;
+      std::map<const SignalType*,std::size_t>::const_iterator
+	found = index.find( *iter );
+      if( index.end()!=found ) res.push_back( found->second );
+      else collectPredecessors( *iter,index,res );
+    }
+}
+
+void GraphSchedule::
+freeze( void )
+{
+  sotDEBUGIN(15);
+
+  nodes.clear();
+  schedule.clear();
+  visited.clear();
+  for( std::vector<SignalType*>::iterator iter = roots.begin();
+       roots.end()!=iter; ++iter )
+    { visit( *iter,true ); }
+
+  std::map<const SignalType*,std::size_t> index;
+  for( std::size_t i=0;i<schedule.size();++i ) index[ schedule[i] ] = i;
+  predecessors.assign( schedule.size(),std::vector<std::size_t>() );
+  for( std::size_t i=0;i<schedule.size();++i )
+    {
+      visited.clear();
+      collectPredecessors( schedule[i],index,predecessors[i] );
+    }
+  visited.clear();
+
+  steps.clear();
+  children.clear();
+  for( std::size_t i=0;i<schedule.size();++i )
+    steps.push_back( makeStep( schedule[i],index ) );
+  for( std::vector<SignalType*>::iterator iter = roots.begin();
+       roots.end()!=iter; ++iter )
+    { steps.push_back( makeStep( *iter,index ) ); }
+
+  active.assign( schedule.size(),false );
+  forced.assign( schedule.size(),false );
+  learningState = LEARNING_WAIT;
+  ticksToCheck = checkPeriod;
+  frozen = true;
+  ++rebuildCount;
+  sotDEBUG(15) << schedule.size() << " signals scheduled out of "
+	       << nodes.size() << std::endl;
+  sotDEBUGOUT(15);
+}
+
+void GraphSchedule::
+unfreeze( void )
+{
+  frozen = false;
+  nodes.clear();
+  schedule.clear();
+  predecessors.clear();
+  steps.clear();
+  children.clear();
+  active.clear();
+  forced.clear();
+}
+
+bool GraphSchedule::
+checkTopology( void ) const
+{
+  for( std::vector<Node>::const_iterator iter = nodes.begin();
+       nodes.end()!=iter; ++iter )
+    {
+      if( iter->signal->getPluged()!=iter->plugged ) return false;
+      if( NULL!=iter->dependency
+	  && !sameDependencies( *iter->dependency,iter->dependencies ) )
+	return false;
+    }
+  return true;
+}
+
+bool GraphSchedule::
+update( void )
+{
+  if( checkTopology() ) return false;
+  sotDEBUG(5) << "Topology changed, rebuild the schedule." << std::endl;
+  freeze();
+  return true;
+}
+
+void GraphSchedule::
+setCheckPeriod( const unsigned int& period )
+{
+  checkPeriod = std::max( period,1u );
+  ticksToCheck = std::min( ticksToCheck,checkPeriod );
+}
+
+bool GraphSchedule::
+prepare( const int& time )
+{
+  bool rebuilt = false;
+  if( 0==ticksToCheck )
+    {
+      rebuilt = update();
+      ticksToCheck = checkPeriod;
+    }
+  --ticksToCheck;
+
+  /* The first tick is left to the pull; the signals it evaluated are
+   * active from the next tick on. */
+  switch( learningState )
+    {
+    case LEARNING_WAIT:
+      learningTime = time;
+      learningState = LEARNING_TICK;
+      break;
+    case LEARNING_TICK:
+      if( time==learningTime ) break;
+      for( std::size_t i=0;i<schedule.size();++i )
+	active[i] = ( schedule[i]->getTime()>=learningTime );
+      learningState = LEARNING_DONE;
+      sotDEBUG(15) << std::count( active.begin(),active.end(),true )
+		   << " active signals out of " << schedule.size() << std::endl;
+      break;
+    case LEARNING_DONE:
+      break;
+    }
+  return rebuilt;
+}
+
+/* TimeDependency::needUpdate, without the recursion into the active
+ * children: they are evaluated before the step, so that their time tells
+ * whether they changed. A step is marked ready when it needs an update,
+ * so that its access does not run the test again. */
+bool GraphSchedule::
+needUpdate( const Step& step,const int& time ) const
+{
+  const SignalType& sig = *step.signal;
+  const DependencyType* dep = step.dependency;
+  if( NULL==dep || dep->updateFromAllChildren
+      || DependencyType::TIME_DEPENDENT!=dep->dependencyType )
+    return sig.needUpdate( time );
+
+  if( sig.getReady() ) return true;
+  const int last = sig.getTime();
+  if( time<last+dep->periodTime ) return false;
+  for( std::size_t k=step.begin;k<step.end;++k )
+    {
+      const Child& child = children[k];
+      if( child.signal->getTime()>last ) return true;
+      if( NOT_SCHEDULED!=child.index && isActive( child.index ) )
+	{ if( child.signal->getReady() ) return true; }
+      else if( child.signal->needUpdate( time ) ) return true;
+    }
+  return false;
+}
+
+void GraphSchedule::
+evaluate( const std::size_t& i,const int& time )
+{
+  SignalType* sig = schedule[i];
+  try
+    {
+      if( needUpdate( steps[i],time ) )
+	{ sig->setReady(); sig->recompute( time ); }
+    }
+  catch( const dynamicgraph::ExceptionAbstract& exc )
+    {
+      sotDEBUG(15) << sig->getName() << ": "
+		   << exc.getStringMessage() << std::endl;
+      sig->setReady();
+    }
+  catch( const std::exception& exc )
+    {
+      sotDEBUG(15) << sig->getName() << ": " << exc.what() << std::endl;
+      sig->setReady();
+    }
+}
+
+void GraphSchedule::
+runDependencies( const int& time )
+{
+  if(! frozen ) return;
+  prepare( time );
+  if( LEARNING_DONE!=learningState ) return;
+
+  for( std::size_t i=0;i<schedule.size();++i )
+    { if( isActive( i ) ) evaluate( i,time ); }
+}
+
+/* The roots end the schedule, without catching their errors. A root that
+ * is not time dependent is simply pulled. */
+void GraphSchedule::
+run( const int& time )
+{
+  runDependencies( time );
+  if( !frozen || LEARNING_DONE!=learningState )
+    {
+      for( std::vector<SignalType*>::iterator iter = roots.begin();
+	   roots.end()!=iter; ++iter )
+	{ (*iter)->recompute( time ); }
+      return;
+    }
+
+  for( std::size_t i=schedule.size();i<steps.size();++i )
+    {
+      const Step& step = steps[i];
+      if( NULL==step.dependency ) step.signal->recompute( time );
+      else if( needUpdate( step,time ) )
+	{ step.signal->setReady(); step.signal->recompute( time ); }
+    }
+}
+
+/* --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+void GraphSchedule::
+display( std::ostream& os ) const
+{
+  if(! frozen ) { os << " -> SCHEDULE: not frozen" << endl; return; }
+
+  os << " -> SCHEDULE: " << schedule.size() << " signals ("
+     << rebuildCount << " builds)" << endl;
+  for( std::size_t i=0;i<schedule.size();++i )
+    {
+      os << " - " << schedule[i]->getName()
+	 << ( isActive( i ) ? "" : " (inactive)" ) << endl;
+    }
+}
+
+/*
+ * Local variables:
+ * c-basic-offset: 2
+ * End:
+ */
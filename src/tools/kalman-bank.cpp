@@ -0,0 +1,274 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <dynamic-graph/all-commands.h>
+#include <dynamic-graph/command-getter.h>
+#include <dynamic-graph/factory.h>
+
+#include <sot/core/factory.hh>
+#include <sot/core/kalman-bank.hh>
+#include <sot/core/exception-tools.hh>
+#include <sot/core/debug.hh>
+
+namespace dg = ::dynamicgraph;
+
+namespace dynamicgraph {
+  namespace sot {
+
+
+DYNAMICGRAPH_FACTORY_ENTITY_PLUGIN(KalmanBank,"KalmanBank");
+
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+
+KalmanBank::
+KalmanBank( const std::string& n )
+  :Entity(n)
+   ,measureSIN(NULL,"KalmanBank("+n+")::input(vector)::y")
+   ,measureValiditySIN(NULL,"KalmanBank("+n+")::input(vector)::y_valid")
+   ,modelTransitionSIN(NULL,"KalmanBank("+n+")::input(matrix)::F")
+   ,modelMeasureSIN(NULL,"KalmanBank("+n+")::input(matrix)::H")
+   ,noiseTransitionSIN(NULL,"KalmanBank("+n+")::input(matrix)::Q")
+   ,noiseMeasureSIN(NULL,"KalmanBank("+n+")::input(matrix)::R")
+   ,stateUpdateSOUT( boost::bind(&KalmanBank::computeStateUpdate,this,_1,_2),
+                     measureSIN<<modelTransitionSIN<<modelMeasureSIN
+                     <<noiseTransitionSIN<<noiseMeasureSIN,
+                     "KalmanBank("+n+")::output(vector)::x_est" )
+   ,varianceUpdateSOUT( boost::bind(&KalmanBank::computeVarianceUpdate,this,_1,_2),
+                        stateUpdateSOUT,
+                        "KalmanBank("+n+")::output(vector)::P" )
+   ,init(false)
+{
+  signalRegistration( measureSIN<<measureValiditySIN<<modelTransitionSIN
+                      <<modelMeasureSIN<<noiseTransitionSIN<<noiseMeasureSIN
+                      <<stateUpdateSOUT<<varianceUpdateSOUT );
+
+  using namespace dynamicgraph::command;
+  std::string docstring;
+  docstring =
+    "\n"
+    "    Set the initial states of the filters.\n"
+    "\n"
+    "      Input:\n"
+    "        - a vector: the states, stacked. Its size is the number of\n"
+    "          filters times the size of the state.\n"
+    "\n";
+  addCommand("setInitialState",
+             makeCommandVoid1(*this,&KalmanBank::setInitialState,docstring));
+  docstring =
+    "\n"
+    "    Set the variance of the initial states.\n"
+    "\n"
+    "      Input:\n"
+    "        - a matrix: the variance, the same for all the filters.\n"
+    "\n";
+  addCommand("setInitialVariance",
+             makeCommandVoid1(*this,&KalmanBank::setInitialVariance,docstring));
+  docstring =
+    "\n"
+    "    Get the number of filters.\n"
+    "\n";
+  addCommand("getNbFilters",
+             new Getter<KalmanBank,unsigned int>
+             (*this,&KalmanBank::getNbFilters,docstring));
+}
+
+KalmanBank::~KalmanBank()
+{
+}
+
+/* --- INIT -------------------------------------------------------------- */
+/* --- INIT -------------------------------------------------------------- */
+/* --- INIT -------------------------------------------------------------- */
+
+void KalmanBank::
+setInitialState( const dg::Vector& x0 )
+{
+  initialState = x0;
+  init = false;
+}
+
+void KalmanBank::
+setInitialVariance( const dg::Matrix& P0 )
+{
+  if( P0.rows()!=P0.cols() )
+    SOT_THROW ExceptionTools( ExceptionTools::GENERIC,
+                              "The initial variance must be square",
+                              " (%dx%d).",(int)P0.rows(),(int)P0.cols() );
+  initialVariance = P0;
+  init = false;
+}
+
+void KalmanBank::
+initializeStates( const dg::Matrix::Index& n )
+{
+  if( initialVariance.rows()!=n || 0==n || 0!=initialState.size()%n )
+    SOT_THROW ExceptionTools( ExceptionTools::GENERIC,
+                              "The initial state and variance do not match F",
+                              " (state %d, variance %d, F %d).",
+                              (int)initialState.size(),
+                              (int)initialVariance.rows(),(int)n );
+
+  const dg::Matrix::Index nbFilters = initialState.size()/n;
+  X = Eigen::Map<const dg::Matrix>( initialState.data(),n,nbFilters )
+    .transpose().array();
+  P.resize( nbFilters,n*n );
+  for( dg::Matrix::Index c=0;c<n*n;++c )
+    P.col( c ).setConstant( initialVariance( c%n,c/n ) );
+  Xp.resize( nbFilters,n );
+  FP.resize( nbFilters,n*n );
+  Ph.resize( nbFilters,n );
+  K.resize( nbFilters,n );
+  C.resize( nbFilters,n );
+  z.resize( nbFilters );
+  s.resize( nbFilters );
+  init = true;
+}
+
+/* --- COMPUTE ----------------------------------------------------------- */
+/* --- COMPUTE ----------------------------------------------------------- */
+/* --- COMPUTE ----------------------------------------------------------- */
+
+dg::Vector& KalmanBank::
+computeStateUpdate( dg::Vector& res,const int& time )
+{
+  typedef dg::Matrix::Index Index;
+  const dg::Vector& y = measureSIN( time );
+  const dg::Matrix& F = modelTransitionSIN( time );
+  const dg::Matrix& H = modelMeasureSIN( time );
+  const dg::Matrix& Q = noiseTransitionSIN( time );
+  const dg::Matrix& R = noiseMeasureSIN( time );
+
+  const Index n = F.rows();
+  if(! init || X.cols()!=n ) initializeStates( n );
+  const Index nbFilters = X.rows(),m = H.rows();
+  if( F.cols()!=n || H.cols()!=n || Q.rows()!=n || Q.cols()!=n
+      || R.rows()!=m || R.cols()!=m || y.size()!=nbFilters*m )
+    SOT_THROW ExceptionTools( ExceptionTools::GENERIC,
+                              "Sizes of the model and of the measures mismatch",
+                              " (%d filters, state %d, measure %d).",
+                              (int)nbFilters,(int)n,(int)m );
+  if(! R.isDiagonal( 0. ) )
+    SOT_THROW ExceptionTools( ExceptionTools::GENERIC,
+                              "The variance of the measures must be diagonal",
+                              "" );
+  const bool masked = measureValiditySIN.isPlugged();
+  const dg::Vector& valid = masked ? measureValiditySIN( time ) : y;
+  if( valid.size()!=y.size() )
+    SOT_THROW ExceptionTools( ExceptionTools::GENERIC,
+                              "Size of the measure validity mismatches y",
+                              " (%d vs %d).",(int)valid.size(),(int)y.size() );
+
+  /* Prediction: X <- F X, P <- F P F^T + Q. The null coefficients of F,
+   * often most of them, are skipped. */
+  for( Index a=0;a<n;++a )
+    {
+      Xp.col( a ).setZero();
+      for( Index c=0;c<n;++c )
+        if( 0.!=F( a,c ) ) Xp.col( a ) += F( a,c )*X.col( c );
+    }
+  X.swap( Xp );
+  for( Index b=0;b<n;++b )
+    for( Index a=0;a<n;++a )
+      {
+        FP.col( a+n*b ).setZero();
+        for( Index c=0;c<n;++c )
+          if( 0.!=F( a,c ) ) FP.col( a+n*b ) += F( a,c )*P.col( c+n*b );
+      }
+  for( Index b=0;b<n;++b )
+    for( Index a=0;a<n;++a )
+      {
+        P.col( a+n*b ).setConstant( Q( a,b ) );
+        for( Index d=0;d<n;++d )
+          if( 0.!=F( b,d ) ) P.col( a+n*b ) += F( b,d )*FP.col( a+n*d );
+      }
+
+  /* Update, one measure at a time (R is diagonal). */
+  typedef Eigen::Map<const Eigen::ArrayXd,0,Eigen::InnerStride<> > Strided;
+  for( Index j=0;j<m;++j )
+    {
+      const double r = R( j,j );
+      for( Index a=0;a<n;++a )
+        {
+          Ph.col( a ).setZero();
+          for( Index b=0;b<n;++b )
+            if( 0.!=H( j,b ) ) Ph.col( a ) += H( j,b )*P.col( a+n*b );
+        }
+      s.setConstant( r );
+      z = Strided( y.data()+j,nbFilters,Eigen::InnerStride<>( m ) );
+      for( Index a=0;a<n;++a )
+        if( 0.!=H( j,a ) )
+          {
+            s += H( j,a )*Ph.col( a );
+            z -= H( j,a )*X.col( a );
+          }
+      if(! ( s>0. ).all() )
+        SOT_THROW ExceptionTools( ExceptionTools::GENERIC,
+                                  "Innovation variance is not positive",
+                                  " (measure %d).",(int)j );
+      /* A skipped measure has a null gain, and its value (maybe missing)
+       * is not used. */
+      s = s.inverse();
+      if( masked )
+        {
+          const Strided v( valid.data()+j,nbFilters,Eigen::InnerStride<>( m ) );
+          s = ( v!=0. ).select( s,0. );
+          z = ( v!=0. ).select( z,0. );
+        }
+
+      for( Index a=0;a<n;++a )
+        {
+          K.col( a ) = Ph.col( a )*s;
+          X.col( a ) += K.col( a )*z;
+        }
+      /* Joseph form, factored as A + (k r - A h^T) k^T with
+       * A = P - k (P h^T)^T, as in Kalman. */
+      for( Index b=0;b<n;++b )
+        for( Index a=0;a<n;++a )
+          P.col( a+n*b ) -= K.col( a )*Ph.col( b );
+      for( Index a=0;a<n;++a )
+        {
+          C.col( a ) = r*K.col( a );
+          for( Index b=0;b<n;++b )
+            if( 0.!=H( j,b ) ) C.col( a ) -= H( j,b )*P.col( a+n*b );
+        }
+      for( Index b=0;b<n;++b )
+        for( Index a=0;a<n;++a )
+          P.col( a+n*b ) += C.col( a )*K.col( b );
+    }
+
+  res.resize( nbFilters*n );
+  Eigen::Map<dg::Matrix>( res.data(),n,nbFilters ) = X.matrix().transpose();
+  return res;
+}
+
+dg::Vector& KalmanBank::
+computeVarianceUpdate( dg::Vector& res,const int& time )
+{
+  stateUpdateSOUT.recompute( time );
+  const dg::Matrix::Index n = X.cols();
+  res.resize( X.rows()*n );
+  Eigen::Map<dg::Matrix> variances( res.data(),n,X.rows() );
+  for( dg::Matrix::Index a=0;a<n;++a )
+    variances.row( a ) = P.col( a*( n+1 ) ).matrix().transpose();
+  return res;
+}
+
+  } /* namespace sot */
+} /* namespace dynamicgraph */
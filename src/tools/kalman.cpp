@@ -28,9 +28,11 @@
 #include <dynamic-graph/factory.h>
 
 #include <dynamic-graph/command-setter.h>
+#include <dynamic-graph/command-getter.h>
 
 namespace dynamicgraph {
   using command::Setter;
+  using command::Getter;
   namespace sot {
 
     DYNAMICGRAPH_FACTORY_ENTITY_PLUGIN(Kalman,"Kalman");
@@ -42,11 +44,13 @@ namespace dynamicgraph {
       ,modelMeasureSIN( NULL,"Kalman("+name+")::input(matrix)::H" )
       ,noiseTransitionSIN( NULL,"Kalman("+name+")::input(matrix)::Q" )
       ,noiseMeasureSIN( NULL,"Kalman("+name+")::input(matrix)::R" )
+      ,measureValiditySIN( NULL,"Kalman("+name+")::input(vector)::y_valid" )
 
       ,statePredictedSIN (0, "Kalman("+name+")::input(vector)::x_pred")
       ,observationPredictedSIN (0, "Kalman("+name+")::input(vector)::y_pred")
       ,varianceUpdateSOUT ("Kalman("+name+")::output(vector)::P")
       ,stateUpdateSOUT ("Kalman("+name+")::output(vector)::x_est"),
+	sequentialUpdate_ (false),
 	stateEstimation_ (),
 	stateVariance_ ()
     {
@@ -60,7 +64,8 @@ namespace dynamicgraph {
       signalRegistration( measureSIN << observationPredictedSIN
 			  << modelTransitionSIN
 			  << modelMeasureSIN << noiseTransitionSIN
-			  << noiseMeasureSIN << statePredictedSIN
+			  << noiseMeasureSIN << measureValiditySIN
+			  << statePredictedSIN
 			  << stateUpdateSOUT << varianceUpdateSOUT );
 
       std::string docstring =
@@ -82,9 +87,53 @@ namespace dynamicgraph {
 		  new Setter <Kalman, Matrix> (*this,
 					       &Kalman::setStateVariance,
 					       docstring));
+
+      docstring =
+	"  Process the measures one at a time when R is diagonal\n"
+	"\n"
+	"  input:\n"
+	"    - a boolean\n";
+      addCommand ("setSequentialUpdate",
+		  new Setter <Kalman, bool> (*this,
+					     &Kalman::setSequentialUpdate,
+					     docstring));
+      docstring =
+	"  Whether the measures are processed one at a time when R is\n"
+	"  diagonal\n";
+      addCommand ("getSequentialUpdate",
+		  new Getter <Kalman, bool> (*this,
+					     &Kalman::getSequentialUpdate,
+					     docstring));
       sotDEBUGOUT(15);
     }
 
+    const Vector& Kalman::
+    measureValidity (const int& time)
+    {
+      if (!measureValiditySIN.isPlugged ()) return noMask_;
+      const Vector& mask = measureValiditySIN (time);
+      const Matrix& H = modelMeasureSIN (time);
+      if (mask.size () != H.rows ())
+	SOT_THROW ExceptionTools (ExceptionTools::GENERIC,
+				  "Size of the measure validity mismatches H",
+				  " (%d vs %d).", (int) mask.size (),
+				  (int) H.rows ());
+      return mask;
+    }
+
+    template<int N>
+    void Kalman::
+    updateVariance (KalmanVarianceUpdate<N>& update,
+		    const Matrix& F, const Matrix& Q,
+		    const Matrix& H, const Matrix& R, const Vector& mask)
+    {
+      if (sequentialUpdate_ && R.isDiagonal (0.))
+	update.computeSequential (F, Q, H, R, mask,
+				  stateVariance_, Pk_k_1_, K_);
+      else
+	update.compute (F, Q, H, R, mask, stateVariance_, Pk_k_1_, S_, K_);
+    }
+
     Matrix & Kalman::
     computeVarianceUpdate (Matrix& Pk_k,const int& time)
     {
@@ -101,34 +150,29 @@ namespace dynamicgraph {
 	const Matrix& R = noiseMeasureSIN (time);
 	const Matrix &F = modelTransitionSIN( time );
 	const Matrix& H = modelMeasureSIN (time);
-	const Matrix &Pk_1_k_1 = stateVariance_;
+	const Vector& mask = measureValidity (time);
 
 	sotDEBUG(15) << "Q=" << Q << std::endl;
 	sotDEBUG(15) << "R=" << R << std::endl;
 	sotDEBUG(15) << "F=" << F << std::endl;
 	sotDEBUG(15) << "H=" << H << std::endl;
-	sotDEBUG(15) << "Pk_1_k_1=" << Pk_1_k_1 << std::endl;
+	sotDEBUG(15) << "Pk_1_k_1=" << stateVariance_ << std::endl;
 
-	FP_ = F * Pk_1_k_1;
-	Pk_k_1_ = FP_*F.transpose();
-	Pk_k_1_ += Q;
+	switch (F.rows ()) {
+	case 3: updateVariance (varianceUpdate3_, F, Q, H, R, mask); break;
+	case 6: updateVariance (varianceUpdate6_, F, Q, H, R, mask); break;
+	case 9: updateVariance (varianceUpdate9_, F, Q, H, R, mask); break;
+	case 12: updateVariance (varianceUpdate12_, F, Q, H, R, mask); break;
+	default: updateVariance (varianceUpdate_, F, Q, H, R, mask);
+	}
+	Pk_k = stateVariance_;
 
-	sotDEBUG(15) << "F " <<std::endl << F << std::endl;
-	sotDEBUG(15) << "P_{k-1|k-1} " <<std::endl<< Pk_1_k_1 << std::endl;
-	sotDEBUG(15) << "F^T " <<std::endl<< F.transpose() << std::endl;
 	sotDEBUG(15) << "P_{k|k-1} " << std::endl << Pk_k_1_ << std::endl;
-
-	S_ = H * Pk_k_1_ * H.transpose () + R;
-	K_ = Pk_k_1_ * H.transpose () * S_.inverse ();
-	Pk_k = Pk_k_1_ - K_ * H * Pk_k_1_;
-
 	sotDEBUG (15) << "S_{k} " << std::endl << S_ << std::endl;
 	sotDEBUG (15) << "K_{k} " << std::endl << K_ << std::endl;
 	sotDEBUG (15) << "P_{k|k} " << std::endl << Pk_k << std::endl;
 
 	sotDEBUGOUT(15);
-
-	stateVariance_ = Pk_k;
       }
       return Pk_k;
     }
@@ -149,8 +193,9 @@ namespace dynamicgraph {
     //   K = P      H  S
     //    k   k|k-1  k  k
     //
-    //   P   = (I - K  H ) P
-    //    k|k        k  k   k|k-1
+    //                                          T      T
+    //   P   = (I - K  H ) P      (I - K  H )  + K R K
+    //    k|k        k  k   k|k-1       k  k      k k k
 
     Vector& Kalman::
     computeStateUpdate (Vector& x_est,const int& time )
@@ -180,8 +225,13 @@ namespace dynamicgraph {
 
 	// Innovation: z_ = y - Hx
 	z_ = y - y_pred;
+	// A skipped measure may be missing: its value is not used.
+	const Vector& mask = measureValidity (time);
+	for (Vector::Index i = 0; i < mask.size (); ++i)
+	  if (mask (i) == 0) z_ (i) = 0;
 	//x_est = x_pred + (K*(y-(H*x_pred)));
-	x_est = x_pred + K_ * z_;
+	x_est = x_pred;
+	x_est.noalias () += K_ * z_;
 
 	sotDEBUG(25) << "z_{k} = " << z_ << std::endl;
 	sotDEBUG(25) << "x_{k|k} = " << x_est << std::endl;
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* --- SOT PLUGIN  --- */
+#include <dynamic-graph/linear-algebra.h>
+#include <sot/core/debug.hh>
+#include <sot/core/factory.hh>
+#include <sot/core/mailbox.hxx>
+#include <sot/core/mailbox-matrix-homogeneous.hh>
+
+using namespace dynamicgraph::sot;
+using namespace dynamicgraph;
+
+// Explicit template specialization
+#ifdef WIN32
+MailboxMatrixHomogeneous::MailboxMatrixHomogeneous( const std::string& name): Mailbox<MatrixHomogeneous> (name){}
+#else
+MAILBOX_TEMPLATE_SPE(dynamicgraph::sot::MatrixHomogeneous)
+#endif
+
+template<>DYNAMICGRAPH_FACTORY_ENTITY_PLUGIN(MailboxMatrixHomogeneous,"Mailbox<MatrixHomo>");
+
@@ -28,6 +28,12 @@
 #include <sot/core/debug.hh>
 #include <sot/core/exception-tools.hh>
 #include <algorithm>
+#include <climits>
+#ifndef WIN32
+#include <sys/time.h>
+#else  /*WIN32*/
+#include <sot/core/utils-windows.hh>
+#endif /*WIN32*/
 #include <dynamic-graph/all-commands.h>
 #include <dynamic-graph/exception-factory.h>
 
@@ -44,7 +50,11 @@ using namespace dynamicgraph::sot;
 PeriodicCall::
 PeriodicCall( void )
   : signalMap()
+    ,callList()
     ,innerTime( 0 )
+    ,frozen( false )
+    ,autoStagger( false )
+    ,staggerPending( false )
 {
 
 }
@@ -52,10 +62,19 @@ PeriodicCall( void )
 /* --------------------------------------------------------------------- */
 /* --------------------------------------------------------------------- */
 /* --------------------------------------------------------------------- */
+void PeriodicCall::
+addSignalToCall( const std::string &name,const SignalToCall& sig )
+{
+  SignalToCall & added = signalMap[ name ];
+  added = sig;
+  if( frozen ) added.schedule.freeze();
+  updateCallList();
+}
+
 void PeriodicCall::
 addSignal( const std::string &name, SignalBase<int>& sig )
 {
-  signalMap[ name ] = SignalToCall(&sig);
+  addSignalToCall( name,SignalToCall(&sig) );
   return ;
 }
 
@@ -71,7 +90,7 @@ addSignal( const std::string& sigpath )
 void PeriodicCall::
 addDownsampledSignal( const std::string &name, SignalBase<int>& sig, const unsigned int& downsamplingFactor )
 {
-  signalMap[ name ] = SignalToCall(&sig,downsamplingFactor);
+  addSignalToCall( name,SignalToCall(&sig,downsamplingFactor) );
   return ;
 }
 
@@ -88,29 +107,211 @@ void PeriodicCall::
 rmSignal( const std::string &name )
 {
   signalMap.erase( name );
+  updateCallList();
   return ;
 }
 
+void PeriodicCall::
+setPhase( const std::string &name,const unsigned int& phase )
+{
+  SignalMapType::iterator iter = signalMap.find( name );
+  if( signalMap.end()==iter )
+    { SOT_THROW ExceptionTools( ExceptionTools::GENERIC,
+				"No signal of this name in the refresh list",
+				" ('%s').",name.c_str() ); }
+  iter->second.phase = phase%iter->second.downsamplingFactor;
+  iter->second.autoPhase = false;
+  updateCallList();
+}
+
+void PeriodicCall::
+setAutoStagger( const bool& stagger )
+{
+  autoStagger = stagger;
+  updateCallList();
+}
 
+void PeriodicCall::
+resetStats( void )
+{
+  for( SignalMapType::iterator iter = signalMap.begin();
+       signalMap.end()!=iter; ++iter )
+    { iter->second.resetStats(); }
+  staggerPending = autoStagger;
+}
 
 /* --------------------------------------------------------------------- */
 /* --------------------------------------------------------------------- */
 /* --------------------------------------------------------------------- */
+
+namespace {
+  unsigned int gcd( unsigned int a,unsigned int b )
+  {
+    while( b!=0 ) { const unsigned int r = a%b; a = b; b = r; }
+    return a;
+  }
+
+  template< class T >
+  bool heavierFirst( const std::pair<double,T>& a,const std::pair<double,T>& b )
+  { return a.first>b.first; }
+
+  /* Smallest time t'>=t such that t'%factor==phase. */
+  int alignedTime( const int t,const unsigned int factor,const unsigned int phase )
+  {
+    const int f = static_cast<int>( factor );
+    const int r = ( ( t-static_cast<int>(phase) )%f+f )%f;
+    return ( 0==r ) ? t : t+f-r;
+  }
+}
+
 void PeriodicCall::
-runSignals( const int& t )
+updateCallList( void )
 {
+  callList.clear();
   for( SignalMapType::iterator iter = signalMap.begin();
        signalMap.end()!=iter; ++iter )
     {
-      if(t%iter->second.downsamplingFactor == 0)
-        (*iter).second.signal->recompute( t );
+      SignalToCall& sig = iter->second;
+      if( sig.autoPhase ) sig.phase = 0;
+      /* Aligned again at the next call. */
+      sig.nextTime = INT_MIN;
+      callList.push_back( &sig );
+    }
+  if( autoStagger ) staggerPhases();
+  staggerPending = autoStagger;
+}
+
+void PeriodicCall::
+staggerMeasured( void )
+{
+  for( std::vector<SignalToCall*>::const_iterator iter = callList.begin();
+       callList.end()!=iter; ++iter )
+    {
+      const SignalToCall& sig = **iter;
+      if( sig.autoPhase && sig.downsamplingFactor>1
+	  && sig.nbCalls<STAGGER_CALLS )
+	return;
+    }
+  staggerPending = false;
+  staggerPhases();
+  for( std::vector<SignalToCall*>::iterator iter = callList.begin();
+       callList.end()!=iter; ++iter )
+    { if( (*iter)->autoPhase ) (*iter)->nextTime = INT_MIN; }
+}
+
+/* Greedy balancing: the heaviest signals first, each on the phase that
+ * minimizes the largest load of the ticks where it is called, over a
+ * window covering the downsampling factors. The load of a signal is its
+ * mean execution time, counted at least 1us (the time of the signals not
+ * measured yet). */
+void PeriodicCall::
+staggerPhases( void )
+{
+  static const unsigned int MAX_WINDOW = 4096;
+
+  unsigned int window = 1;
+  std::vector< std::pair<double,SignalToCall*> > toPlace;
+  for( std::vector<SignalToCall*>::iterator iter = callList.begin();
+       callList.end()!=iter; ++iter )
+    {
+      const unsigned int f = (*iter)->downsamplingFactor;
+      if( f<=1 ) continue;
+      if( window<MAX_WINDOW ) window = std::min( window/gcd(window,f)*f,MAX_WINDOW );
+      if( (*iter)->autoPhase )
+	{
+	  toPlace.push_back
+	    ( std::make_pair( std::max( (*iter)->meanDuration(),1. ),*iter ) );
+	}
+    }
+  if( toPlace.empty() ) return;
+
+  /* Load of the explicit phases. */
+  std::vector<double> load( window,0. );
+  for( std::vector<SignalToCall*>::iterator iter = callList.begin();
+       callList.end()!=iter; ++iter )
+    {
+      const SignalToCall& sig = **iter;
+      if( sig.downsamplingFactor<=1 || sig.autoPhase ) continue;
+      const double w = std::max( sig.meanDuration(),1. );
+      for( unsigned int t=sig.phase;t<window;t+=sig.downsamplingFactor )
+	load[t] += w;
+    }
+
+  std::stable_sort( toPlace.begin(),toPlace.end(),heavierFirst<SignalToCall*> );
+  for( std::size_t k=0;k<toPlace.size();++k )
+    {
+      SignalToCall& sig = *toPlace[k].second;
+      const unsigned int f = sig.downsamplingFactor;
+      unsigned int best = 0; double bestLoad = -1;
+      for( unsigned int p=0;p<f && p<window;++p )
+	{
+	  double worst = 0;
+	  for( unsigned int t=p;t<window;t+=f ) worst = std::max( worst,load[t] );
+	  if( bestLoad<0 || worst<bestLoad ) { best = p; bestLoad = worst; }
+	}
+      sig.phase = best;
+      for( unsigned int t=best;t<window;t+=f ) load[t] += toPlace[k].first;
+    }
+}
+
+
+
+/* --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+void PeriodicCall::
+runSignals( const int& t )
+{
+  /* The end of a call is the start of the next one. */
+  struct timeval t0,t1;
+  bool started = false;
+  for( std::vector<SignalToCall*>::iterator iter = callList.begin();
+       callList.end()!=iter; ++iter )
+    {
+      SignalToCall& sig = **iter;
+      const int f = static_cast<int>( sig.downsamplingFactor );
+      if( t<sig.nextTime && sig.nextTime-t<f ) continue;
+      /* First call, or jump of the time: align on the phase. */
+      if( t!=sig.nextTime ) sig.nextTime = alignedTime( t,sig.downsamplingFactor,sig.phase );
+      if( t!=sig.nextTime ) continue;
+      sig.nextTime = t+f;
+
+      if(! started ) { gettimeofday( &t0,NULL ); started = true; }
+      sig.schedule.run( t );
+      gettimeofday( &t1,NULL );
+
+      sig.lastDuration = (double)(t1.tv_sec-t0.tv_sec)*1000.*1000.
+	+ (double)(t1.tv_usec-t0.tv_usec);
+      t0 = t1;
+      sig.totalDuration += sig.lastDuration;
+      sig.maxDuration = std::max( sig.maxDuration,sig.lastDuration );
+      ++sig.nbCalls;
     }
   return ;
 }
 
+void PeriodicCall::
+freeze( void )
+{
+  for( SignalMapType::iterator iter = signalMap.begin();
+       signalMap.end()!=iter; ++iter )
+    { iter->second.schedule.freeze(); }
+  frozen = true;
+}
+
+void PeriodicCall::
+unfreeze( void )
+{
+  for( SignalMapType::iterator iter = signalMap.begin();
+       signalMap.end()!=iter; ++iter )
+    { iter->second.schedule.unfreeze(); }
+  frozen = false;
+}
+
 void PeriodicCall::
 run( const int & t )
 {
+  if( staggerPending ) staggerMeasured();
   runSignals( t );
   return ;
 }
@@ -129,11 +330,31 @@ display( std::ostream& os ) const
   for( SignalMapType::const_iterator iter = signalMap.begin();
        signalMap.end()!=iter; ++iter )
     {
-      os << " - " << (*iter).first << endl;
+      const SignalToCall& sig = iter->second;
+      os << " - " << (*iter).first;
+      if( sig.downsamplingFactor>1 )
+	os << " (1/" << sig.downsamplingFactor << ", phase " << sig.phase << ")";
+      if( sig.nbCalls>0 ) os << " " << sig.meanDuration() << "us";
+      os << endl;
+      if( frozen ) sig.schedule.display( os );
     }
 
 }
 
+void PeriodicCall::
+displayStats( std::ostream& os ) const
+{
+  os << " -> STATS (us): calls, last, mean, max" << endl;
+  for( SignalMapType::const_iterator iter = signalMap.begin();
+       signalMap.end()!=iter; ++iter )
+    {
+      const SignalToCall& sig = iter->second;
+      os << " - " << iter->first << ": " << sig.nbCalls
+	 << ", " << sig.lastDuration << ", " << sig.meanDuration()
+	 << ", " << sig.maxDuration << endl;
+    }
+}
+
 /*
 static std::string readLineStr( istringstream& args )
 {
@@ -168,11 +389,18 @@ void PeriodicCall::addSpecificCommands(Entity& ent,
     addSignal  = boost::bind( &PeriodicCall::addSignal, this,_1 ),
     rmSignal = boost::bind( &PeriodicCall::rmSignal, this,_1 );
   boost::function< void( const std::string&, const unsigned int& ) >
-    addDownsampledSignal  = boost::bind( &PeriodicCall::addDownsampledSignal, this,_1,_2);
+    addDownsampledSignal  = boost::bind( &PeriodicCall::addDownsampledSignal, this,_1,_2),
+    setPhase  = boost::bind( &PeriodicCall::setPhase, this,_1,_2);
+  boost::function< void( const bool& ) >
+    setAutoStagger  = boost::bind( &PeriodicCall::setAutoStagger, this,_1 );
   boost::function< void( void ) >
-    clear  = boost::bind( &PeriodicCall::clear, this );
+    clear  = boost::bind( &PeriodicCall::clear, this ),
+    freeze  = boost::bind( &PeriodicCall::freeze, this ),
+    unfreeze  = boost::bind( &PeriodicCall::unfreeze, this ),
+    resetStats  = boost::bind( &PeriodicCall::resetStats, this );
   boost::function< void( std::ostream& ) >
-    disp  = boost::bind( &PeriodicCall::display, this,_1 );
+    disp  = boost::bind( &PeriodicCall::display, this,_1 ),
+    stats  = boost::bind( &PeriodicCall::displayStats, this,_1 );
 
    ADD_COMMAND("addSignal",
    	      makeCommandVoid1(ent,addSignal,
@@ -191,9 +419,32 @@ void PeriodicCall::addSpecificCommands(Entity& ent,
 	       makeCommandVoid0(ent,clear,
 				docCommandVoid0("Clear all signals and commands from the refresh list.")));
 
+   ADD_COMMAND("setPhase",
+	       makeCommandVoid2(ent,setPhase,
+				docCommandVoid2("Call the signal at the times t such that t%factor==phase",
+						"string (sig name)",
+						"unsigned int (phase)")));
+   ADD_COMMAND("setAutoStagger",
+	       makeCommandVoid1(ent,setAutoStagger,
+				docCommandVoid1("Spread the downsampled signals without explicit phase over the ticks",
+						"bool")));
+
+   ADD_COMMAND("freeze",
+	       makeCommandVoid0(ent,freeze,
+				docCommandVoid0("Evaluate the dependencies of the signals from a flat schedule.")));
+   ADD_COMMAND("unfreeze",
+	       makeCommandVoid0(ent,unfreeze,
+				docCommandVoid0("Go back to the recursive evaluation of the signals.")));
+
    ADD_COMMAND("disp",
 	       makeCommandVerbose(ent,disp,
 				  docCommandVerbose("Print the list of to-refresh signals and commands.")));
+   ADD_COMMAND("stats",
+	       makeCommandVerbose(ent,stats,
+				  docCommandVerbose("Print the execution time of the signals.")));
+   ADD_COMMAND("resetStats",
+	       makeCommandVoid0(ent,resetStats,
+				docCommandVoid0("Reset the execution times of the signals.")));
 
 }
 
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Stand-in for the hardware process of a robot, talking to sot-shm-server.
+ *
+ * At each cycle of the given rate, the fake robot writes sine waves in
+ * all the sensor values, pushes the sensor frame, and waits until the end
+ * of the period for the control frame of the same sequence number. It
+ * then reports the round-trip latency, the cycles without control
+ * (missed), and the controls received after their cycle (late).
+ */
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+#include <sot/core/shm-ring.hh>
+#include <dynamic-graph/exception-abstract.h>
+
+#include <boost/program_options.hpp>
+
+// POSIX.1-2001
+#include <sched.h>
+#include <time.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dynamicgraph::sot;
+namespace po = boost::program_options;
+
+static double elapsed( const struct timespec& t0,const struct timespec& t1 )
+{
+  return (double)( t1.tv_sec-t0.tv_sec ) + (double)( t1.tv_nsec-t0.tv_nsec )*1e-9;
+}
+
+static bool before( const struct timespec& t0,const struct timespec& t1 )
+{
+  return t0.tv_sec<t1.tv_sec || ( t0.tv_sec==t1.tv_sec && t0.tv_nsec<t1.tv_nsec );
+}
+
+static void addPeriod( struct timespec& t,const long& period )
+{
+  t.tv_nsec += period;
+  while( t.tv_nsec>=1000000000L ) { t.tv_nsec -= 1000000000L; ++t.tv_sec; }
+}
+
+static double percentile( const std::vector<double>& sorted,const double& p )
+{
+  const std::size_t k = static_cast<std::size_t>( p*( (double)sorted.size()-1 )+.5 );
+  return sorted[ k ];
+}
+
+int main( int argc,char* argv[] )
+{
+  po::options_description desc( "Allowed options" );
+  desc.add_options()
+    ( "help","produce help message" )
+    ( "name",po::value<string>()->default_value( "/sot" ),"prefix of the rings" )
+    ( "rate",po::value<double>()->default_value( 1000 ),"cycles per second" )
+    ( "cycles",po::value<unsigned int>()->default_value( 10000 ),"number of cycles" )
+    ( "timeout",po::value<double>()->default_value( 5 ),
+      "seconds to wait for the server" )
+    ;
+  po::variables_map vm;
+  try
+    {
+      po::store( po::parse_command_line( argc,argv,desc ),vm );
+      po::notify( vm );
+    }
+  catch( const std::exception& exc )
+    { cerr << exc.what() << "\n" << desc << "\n"; return 1; }
+  if( vm.count( "help" ) ) { cout << desc << "\n"; return 0; }
+
+  const std::string name = vm["name"].as<string>();
+  const unsigned int nbCycles = vm["cycles"].as<unsigned int>();
+  const long period = static_cast<long>( 1e9/vm["rate"].as<double>() );
+
+  /* --- Connection --- */
+  ShmRing sensorRing,controlRing;
+  struct timespec start,now;
+  clock_gettime( CLOCK_MONOTONIC,&start );
+  while(! ( sensorRing.open( name+"-sensors" )
+            && controlRing.open( name+"-controls" ) ) )
+    {
+      clock_gettime( CLOCK_MONOTONIC,&now );
+      if( elapsed( start,now )>vm["timeout"].as<double>() )
+        { cerr << "No server on " << name << endl; return 1; }
+      struct timespec pause = { 0,10000000L };
+      nanosleep( &pause,NULL );
+    }
+  ExchangeBuffer sensors,controls;
+  sensorRing.readLayout( sensors );
+  controlRing.readLayout( controls );
+
+  /* --- Cycles --- */
+  std::vector<double> latencies; latencies.reserve( nbCycles );
+  unsigned int missed = 0,late = 0;
+  struct timespec deadline,sent,received;
+  clock_gettime( CLOCK_MONOTONIC,&deadline );
+  for( unsigned int cycle=0;cycle<nbCycles;++cycle )
+    {
+      const uint64_t seq = cycle;
+      for( std::size_t i=0;i<sensors.size();++i )
+        sensors.data()[i] = std::sin( 1e-3*cycle+(double)i );
+
+      clock_gettime( CLOCK_MONOTONIC,&sent );
+      sensorRing.push( sensors,seq );
+      addPeriod( deadline,period );
+
+      /* Wait for the control of this cycle until the next one. */
+      bool answered = false;
+      uint64_t controlSeq;
+      for(;;)
+        {
+          if( controlRing.pop( controls,controlSeq ) )
+            {
+              if( controlSeq==seq ) { answered = true; break; }
+              ++late; continue;
+            }
+          clock_gettime( CLOCK_MONOTONIC,&received );
+          if(! before( received,deadline ) ) break;
+          sched_yield();
+        }
+      if( answered )
+        {
+          clock_gettime( CLOCK_MONOTONIC,&received );
+          latencies.push_back( elapsed( sent,received ) );
+          clock_nanosleep( CLOCK_MONOTONIC,TIMER_ABSTIME,&deadline,NULL );
+        }
+      else ++missed;
+    }
+
+  /* --- Report --- */
+  cout << nbCycles << " cycles: " << missed << " missed, " << late << " late, "
+       << sensorRing.getOverflowCount() << " sensor frames dropped" << endl;
+  if(! latencies.empty() )
+    {
+      std::sort( latencies.begin(),latencies.end() );
+      cout << "round trip (us): min " << latencies.front()*1e6
+           << ", p50 " << percentile( latencies,.5 )*1e6
+           << ", p90 " << percentile( latencies,.9 )*1e6
+           << ", p99 " << percentile( latencies,.99 )*1e6
+           << ", p99.9 " << percentile( latencies,.999 )*1e6
+           << ", max " << latencies.back()*1e6 << endl;
+    }
+  return 0;
+}
+
+/*
+ * Local variables:
+ * c-basic-offset: 2
+ * End:
+ */
@@ -0,0 +1,239 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+/* --- SOT --- */
+#include <sot/core/shm-ring.hh>
+#include <sot/core/exception-tools.hh>
+#include <sot/core/debug.hh>
+
+/* --- POSIX --- */
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+using namespace std;
+using namespace dynamicgraph::sot;
+
+/* The frames follow the header: a sequence number, then the values. */
+
+ShmRing::
+ShmRing( void )
+  : name()
+  ,header( NULL )
+  ,mappedSize( 0 )
+  ,owner( false )
+  ,overflows( 0 ),skipped( 0 )
+{
+}
+
+ShmRing::
+~ShmRing( void )
+{
+  close();
+}
+
+void ShmRing::
+create( const std::string& segmentName,const ExchangeBuffer& layout,
+        const unsigned int& capacity )
+{
+  close();
+
+  std::ostringstream oss;
+  for( std::size_t h=0;h<layout.getNbBlocks();++h )
+    oss << layout.getName( h ) << " " << layout.getSize( h ) << "\n";
+  if( oss.str().size()>=LAYOUT_SIZE )
+    SOT_THROW ExceptionTools( ExceptionTools::GENERIC,
+                              "Too many blocks in the layout of the ring",
+                              " ('%s').",segmentName.c_str() );
+
+  uint32_t cap = 1;
+  while( cap<capacity ) cap <<= 1;
+  const std::size_t frameSize = layout.size();
+  const std::size_t size
+    = sizeof( Header )+cap*( frameSize+1 )*sizeof( double );
+
+  shm_unlink( segmentName.c_str() );
+  const int fd = shm_open( segmentName.c_str(),O_CREAT|O_EXCL|O_RDWR,0600 );
+  if( fd<0 || 0!=ftruncate( fd,size ) )
+    {
+      if( fd>=0 ) ::close( fd );
+      SOT_THROW ExceptionTools( ExceptionTools::GENERIC,
+                                "Cannot create the shared memory segment",
+                                " ('%s': %s).",segmentName.c_str(),
+                                strerror( errno ) );
+    }
+  void* addr = mmap( NULL,size,PROT_READ|PROT_WRITE,MAP_SHARED,fd,0 );
+  ::close( fd );
+  if( MAP_FAILED==addr )
+    {
+      shm_unlink( segmentName.c_str() );
+      SOT_THROW ExceptionTools( ExceptionTools::GENERIC,
+                                "Cannot map the shared memory segment",
+                                " ('%s').",segmentName.c_str() );
+    }
+
+  name = segmentName; owner = true; mappedSize = size;
+  header = static_cast<Header*>( addr );
+  header->frameSize = static_cast<uint32_t>( frameSize );
+  header->capacity = cap;
+  std::memset( header->layout,0,LAYOUT_SIZE );
+  std::strncpy( header->layout,oss.str().c_str(),LAYOUT_SIZE-1 );
+  header->head = 0; header->tail = 0;
+  overflows = skipped = 0;
+
+  /* The other process only reads the header once the magic is set. */
+  __sync_synchronize();
+  header->magic = MAGIC;
+}
+
+bool ShmRing::
+open( const std::string& segmentName )
+{
+  close();
+  const int fd = shm_open( segmentName.c_str(),O_RDWR,0600 );
+  if( fd<0 ) return false;
+  struct stat st;
+  if( 0!=fstat( fd,&st ) || (std::size_t)st.st_size<sizeof( Header ) )
+    { ::close( fd ); return false; }
+  void* addr = mmap( NULL,st.st_size,PROT_READ|PROT_WRITE,MAP_SHARED,fd,0 );
+  ::close( fd );
+  if( MAP_FAILED==addr ) return false;
+
+  Header* h = static_cast<Header*>( addr );
+  if( MAGIC!=h->magic ) { munmap( addr,st.st_size ); return false; }
+  __sync_synchronize();
+
+  name = segmentName; owner = false; mappedSize = st.st_size;
+  header = h;
+  overflows = skipped = 0;
+  return true;
+}
+
+void ShmRing::
+close( void )
+{
+  if( NULL==header ) return;
+  if( owner ) header->magic = 0;
+  munmap( header,mappedSize );
+  if( owner ) shm_unlink( name.c_str() );
+  header = NULL; mappedSize = 0; owner = false;
+}
+
+/* --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+double* ShmRing::
+frame( const uint64_t& index )
+{
+  double* frames = reinterpret_cast<double*>( header+1 );
+  return frames + ( index&( header->capacity-1 ) )*( header->frameSize+1 );
+}
+
+bool ShmRing::
+push( const ExchangeBuffer& buffer,const uint64_t& seq )
+{
+  const uint64_t head = header->head;
+  const uint64_t tail = header->tail;
+  if( head-tail>=header->capacity || buffer.size()!=header->frameSize )
+    { ++overflows; return false; }
+
+  double* f = frame( head );
+  std::memcpy( f,&seq,sizeof( uint64_t ) );
+  if( buffer.size()>0 )
+    std::memcpy( f+1,buffer.data(),buffer.size()*sizeof( double ) );
+
+  /* The frame is written before it is published. */
+  __sync_synchronize();
+  header->head = head+1;
+  return true;
+}
+
+void ShmRing::
+readFrame( const uint64_t& index,ExchangeBuffer& buffer,uint64_t& seq )
+{
+  const double* f = frame( index );
+  std::memcpy( &seq,f,sizeof( uint64_t ) );
+  const std::size_t n = std::min( buffer.size(),(std::size_t)header->frameSize );
+  if( n>0 ) std::memcpy( buffer.data(),f+1,n*sizeof( double ) );
+}
+
+bool ShmRing::
+pop( ExchangeBuffer& buffer,uint64_t& seq )
+{
+  const uint64_t tail = header->tail;
+  const uint64_t head = header->head;
+  if( tail==head ) return false;
+
+  /* The frame is read after its publication, and released after. */
+  __sync_synchronize();
+  readFrame( tail,buffer,seq );
+  __sync_synchronize();
+  header->tail = tail+1;
+  return true;
+}
+
+bool ShmRing::
+popLatest( ExchangeBuffer& buffer,uint64_t& seq )
+{
+  const uint64_t tail = header->tail;
+  const uint64_t head = header->head;
+  if( tail==head ) return false;
+
+  __sync_synchronize();
+  skipped += static_cast<unsigned int>( head-1-tail );
+  readFrame( head-1,buffer,seq );
+  __sync_synchronize();
+  header->tail = head;
+  return true;
+}
+
+void ShmRing::
+readLayout( ExchangeBuffer& buffer ) const
+{
+  buffer.clear();
+  std::istringstream iss( std::string( header->layout ) );
+  std::string blockName; std::size_t size;
+  while( iss >> blockName >> size ) buffer.add( blockName,size );
+}
+
+unsigned int ShmRing::
+getCapacity( void ) const
+{
+  return ( NULL==header ) ? 0 : header->capacity;
+}
+
+unsigned int ShmRing::
+getFrameSize( void ) const
+{
+  return ( NULL==header ) ? 0 : header->frameSize;
+}
+
+/*
+ * Local variables:
+ * c-basic-offset: 2
+ * End:
+ */
@@ -0,0 +1,184 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Run a controller in its own process, behind two shared memory rings.
+ *
+ * The controller is loaded from a library exporting
+ * createSotExternalInterface, and must implement
+ * AbstractSotExternalInterfaceV2. The server creates the rings
+ * <name>-sensors and <name>-controls with the layouts declared by the
+ * controller, then, for each sensor frame, runs the controller and
+ * answers with a control frame of the same sequence number. When the
+ * controller is late, only the most recent sensor frame is used.
+ *
+ * With --echo N, a built-in controller copies the N values of the sensor
+ * "joints" into the control "control": this is the reference to measure
+ * the cost of the transport with sot-shm-fake-robot.
+ */
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+#include <sot/core/shm-ring.hh>
+#include <sot/core/abstract-sot-external-interface-v2.hh>
+#include <dynamic-graph/exception-abstract.h>
+
+#include <boost/program_options.hpp>
+
+// POSIX.1-2001
+#include <dlfcn.h>
+#include <sched.h>
+#include <signal.h>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+using namespace dynamicgraph::sot;
+namespace po = boost::program_options;
+
+static volatile sig_atomic_t stopping = 0;
+static void requestStop( int ) { stopping = 1; }
+
+class EchoController: public AbstractSotExternalInterfaceV2
+{
+public:
+  EchoController( const std::size_t& size ) : size_( size ) {}
+
+  void registerSensorsAndControls( ExchangeBuffer& sensors,
+                                   ExchangeBuffer& controls )
+  {
+    joints_ = sensors.add( "joints",size_ );
+    control_ = controls.add( "control",size_ );
+  }
+  void setupSetSensors( const ExchangeBuffer& sensors ) { nominalSetSensors( sensors ); }
+  void nominalSetSensors( const ExchangeBuffer& sensors ) { sensors_ = &sensors; }
+  void cleanupSetSensors( const ExchangeBuffer& ) {}
+  void getControl( ExchangeBuffer& controls )
+  { controls.get( control_ ) = sensors_->get( joints_ ); }
+  void setSecondOrderIntegration( void ) {}
+  void setNoIntegration( void ) {}
+
+protected:
+  std::size_t size_;
+  ExchangeBuffer::Handle joints_,control_;
+  const ExchangeBuffer* sensors_;
+};
+
+static AbstractSotExternalInterfaceV2* loadController( const std::string& library )
+{
+  void* handle = dlopen( library.c_str(),RTLD_GLOBAL|RTLD_NOW );
+  if( NULL==handle )
+    throw std::runtime_error( std::string( "Cannot load library: " ) + dlerror() );
+  dlerror();
+  createSotExternalInterface_t* create = (createSotExternalInterface_t*)
+    dlsym( handle,"createSotExternalInterface" );
+  const char* error = dlerror();
+  if( NULL!=error )
+    throw std::runtime_error( std::string( "Cannot load symbol create: " ) + error );
+
+  AbstractSotExternalInterface* controller = create();
+  AbstractSotExternalInterfaceV2* controllerV2
+    = dynamic_cast<AbstractSotExternalInterfaceV2*>( controller );
+  if( NULL==controllerV2 )
+    throw std::runtime_error( "The controller of " + library
+                              + " does not implement AbstractSotExternalInterfaceV2" );
+  return controllerV2;
+}
+
+int main( int argc,char* argv[] )
+{
+  po::options_description desc( "Allowed options" );
+  desc.add_options()
+    ( "help","produce help message" )
+    ( "controller",po::value<string>(),"library of the controller" )
+    ( "echo",po::value<unsigned int>(),"use the echo controller, of the given size" )
+    ( "name",po::value<string>()->default_value( "/sot" ),"prefix of the rings" )
+    ( "capacity",po::value<unsigned int>()->default_value( 16 ),
+      "number of frames of each ring" )
+    ;
+  po::variables_map vm;
+  try
+    {
+      po::store( po::parse_command_line( argc,argv,desc ),vm );
+      po::notify( vm );
+    }
+  catch( const std::exception& exc )
+    { cerr << exc.what() << "\n" << desc << "\n"; return 1; }
+  if( vm.count( "help" ) ) { cout << desc << "\n"; return 0; }
+  if( vm.count( "controller" )==vm.count( "echo" ) )
+    { cerr << "Give either a controller or --echo\n" << desc << "\n"; return 1; }
+
+  const std::string name = vm["name"].as<string>();
+  ExchangeBuffer sensors,controls;
+  ShmRing sensorRing,controlRing;
+  AbstractSotExternalInterfaceV2* controller = NULL;
+  try
+    {
+      if( vm.count( "echo" ) )
+        controller = new EchoController( vm["echo"].as<unsigned int>() );
+      else
+        controller = loadController( vm["controller"].as<string>() );
+      controller->registerSensorsAndControls( sensors,controls );
+
+      const unsigned int capacity = vm["capacity"].as<unsigned int>();
+      sensorRing.create( name+"-sensors",sensors,capacity );
+      controlRing.create( name+"-controls",controls,capacity );
+    }
+  catch( const dynamicgraph::ExceptionAbstract& exc )
+    { cerr << exc.getStringMessage() << endl; return 1; }
+  catch( const std::exception& exc )
+    { cerr << exc.what() << endl; return 1; }
+
+  signal( SIGINT,requestStop );
+  signal( SIGTERM,requestStop );
+  cout << "Serving " << name << "-sensors (" << sensors.size() << " values) and "
+       << name << "-controls (" << controls.size() << " values)" << endl;
+
+  /* --- Cycles --- */
+  bool started = false;
+  uint64_t seq; unsigned long nbCycles = 0;
+  try
+    {
+      while(! stopping )
+        {
+          if(! sensorRing.popLatest( sensors,seq ) ) { sched_yield(); continue; }
+          if( started ) controller->nominalSetSensors( sensors );
+          else { controller->setupSetSensors( sensors ); started = true; }
+          controller->getControl( controls );
+          controlRing.push( controls,seq );
+          ++nbCycles;
+        }
+      if( started ) controller->cleanupSetSensors( sensors );
+    }
+  catch( const dynamicgraph::ExceptionAbstract& exc )
+    { cerr << exc.getStringMessage() << endl; return 1; }
+  catch( const std::exception& exc )
+    { cerr << exc.what() << endl; return 1; }
+
+  cout << nbCycles << " cycles, " << sensorRing.getSkippedCount()
+       << " sensor frames skipped, " << controlRing.getOverflowCount()
+       << " control frames dropped" << endl;
+  return 0;
+}
+
+/*
+ * Local variables:
+ * c-basic-offset: 2
+ * End:
+ */
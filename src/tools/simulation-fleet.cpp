@@ -0,0 +1,164 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+/* --- SOT --- */
+#include <sot/core/simulation-fleet.hh>
+#include <sot/core/device.hh>
+#include <sot/core/debug.hh>
+#include <dynamic-graph/exception-abstract.h>
+
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+
+// POSIX.1-2001
+#include <time.h>
+
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+using namespace dynamicgraph;
+using namespace dynamicgraph::sot;
+
+static double elapsed( const struct timespec& t0,const struct timespec& t1 )
+{
+  return (double)( t1.tv_sec-t0.tv_sec ) + (double)( t1.tv_nsec-t0.tv_nsec )*1e-9;
+}
+
+static void addPeriod( struct timespec& t,const long& period )
+{
+  t.tv_nsec += period;
+  while( t.tv_nsec>=1000000000L ) { t.tv_nsec -= 1000000000L; ++t.tv_sec; }
+}
+
+/* --------------------------------------------------------------------- */
+/* --- CLASS ----------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+SimulationFleet::
+SimulationFleet( const std::vector<Device*>& devices,const unsigned int& nbTicks,
+                 const double& dt,const double& rate )
+  : durations( devices.size()*nbTicks,0. )
+  ,failed( devices.size(),false )
+  ,states()
+  ,overruns( 0 ),failures( 0 )
+  ,devices_( devices ),nbTicks_( nbTicks ),dt_( dt )
+  ,period_( ( rate>0 ) ? static_cast<long>( 1e9/rate ) : 0 )
+  ,nextCopy_( 0 )
+{}
+
+void SimulationFleet::
+run( const unsigned int& nbThreads )
+{
+  nextCopy_ = 0;
+  boost::thread_group threads;
+  for( unsigned int k=1;k<nbThreads;++k )
+    threads.create_thread( boost::bind( &SimulationFleet::work,this ) );
+  work();
+  threads.join_all();
+
+  /* Final states, one column per copy. */
+  const std::size_t nbCopies = devices_.size();
+  if( 0==nbCopies ) { states.resize( 0,0 ); return; }
+  const Vector::Index size = devices_[0]->stateSOUT.accessCopy().size();
+  states = Matrix::Zero( size,nbCopies );
+  for( std::size_t k=0;k<nbCopies;++k )
+    {
+      const Vector& state = devices_[k]->stateSOUT.accessCopy();
+      if( state.size()==size ) states.col( k ) = state;
+    }
+}
+
+std::vector<double> SimulationFleet::
+sortedDurations( void ) const
+{
+  std::vector<double> res;
+  res.reserve( durations.size() );
+  for( std::size_t copy=0;copy<failed.size();++copy )
+    if(! failed[copy] )
+      res.insert( res.end(),durations.begin()+copy*nbTicks_,
+                  durations.begin()+( copy+1 )*nbTicks_ );
+  std::sort( res.begin(),res.end() );
+  return res;
+}
+
+double SimulationFleet::
+percentile( const std::vector<double>& sorted,const double& p )
+{
+  const std::size_t k = static_cast<std::size_t>( p*( (double)sorted.size()-1 )+.5 );
+  return sorted[ k ];
+}
+
+void SimulationFleet::
+work( void )
+{
+  for(;;)
+    {
+      std::size_t copy;
+      {
+        boost::mutex::scoped_lock lock( mutex_ );
+        if( nextCopy_>=devices_.size() ) return;
+        copy = nextCopy_++;
+      }
+      unsigned int copyOverruns = 0;
+      const bool ok = simulate( copy,copyOverruns );
+      boost::mutex::scoped_lock lock( mutex_ );
+      overruns += copyOverruns;
+      if(! ok ) { failed[copy] = true; ++failures; }
+    }
+}
+
+bool SimulationFleet::
+simulate( const std::size_t& copy,unsigned int& copyOverruns )
+{
+  Device& device = *devices_[copy];
+  double* copyDurations = &durations[copy*nbTicks_];
+  struct timespec t0,t1,deadline;
+  clock_gettime( CLOCK_MONOTONIC,&deadline );
+  try
+    {
+      for( unsigned int tick=0;tick<nbTicks_;++tick )
+        {
+          if( period_>0 )
+            {
+              addPeriod( deadline,period_ );
+              clock_nanosleep( CLOCK_MONOTONIC,TIMER_ABSTIME,&deadline,NULL );
+            }
+          clock_gettime( CLOCK_MONOTONIC,&t0 );
+          device.increment( dt_ );
+          clock_gettime( CLOCK_MONOTONIC,&t1 );
+          copyDurations[tick] = elapsed( t0,t1 );
+          if( period_>0 && copyDurations[tick]*1e9>period_ ) ++copyOverruns;
+        }
+    }
+  catch( const dynamicgraph::ExceptionAbstract& exc )
+    {
+      boost::mutex::scoped_lock lock( mutex_ );
+      cerr << device.getName() << ": " << exc.getStringMessage() << endl;
+      return false;
+    }
+  catch( const std::exception& exc )
+    {
+      boost::mutex::scoped_lock lock( mutex_ );
+      cerr << device.getName() << ": " << exc.what() << endl;
+      return false;
+    }
+  return true;
+}
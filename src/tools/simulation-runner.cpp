@@ -0,0 +1,363 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Headless simulation runner.
+ *
+ * Build a graph from a command script, then call Device::increment a given
+ * number of times, either as fast as possible or at a fixed rate, and
+ * report the throughput, the distribution of the tick durations and the
+ * final state of the device. No Python interpreter is involved.
+ *
+ * The script contains one statement per line ('#' starts a comment):
+ *   loadPlugin <library>         load a plugin (name without extension, or
+ *                                path of the library)
+ *   new <Class> <name>           create an entity
+ *   plug <ent.sigout> <ent.sigin>
+ *   set <ent.sig> <value>        set a constant signal value
+ *   <ent>.<command> <args>...    run a command of an entity
+ * Vectors are written [3](1,2,3), matrices [2,2]((1,0),(0,1)).
+ *
+ * With --copies K, the script is loaded K times, to build K independent
+ * graphs: in copy i, "$ns" is replaced by the namespace of the copy
+ * ("copy<i>_", or nothing when there is a single copy) and "$i" by i. The
+ * script should thus prefix all the names of entities with $ns, and may
+ * use $i to pick a different initial state for each copy. The copies share
+ * no signal, and are stepped in parallel by --threads threads; their
+ * final states are gathered into the columns of one matrix.
+ */
+
+/* --------------------------------------------------------------------- */
+/* --- INCLUDE --------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+#include <sot/core/device.hh>
+#include <sot/core/simulation-fleet.hh>
+#include <sot/core/debug.hh>
+#include <dynamic-graph/factory.h>
+#include <dynamic-graph/pool.h>
+#include <dynamic-graph/command.h>
+#include <dynamic-graph/value.h>
+#include <dynamic-graph/eigen-io.h>
+#include <dynamic-graph/exception-abstract.h>
+
+#include <boost/program_options.hpp>
+#include <boost/thread/thread.hpp>
+
+// POSIX.1-2001
+#include <dlfcn.h>
+#include <time.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dynamicgraph;
+using namespace dynamicgraph::sot;
+namespace po = boost::program_options;
+
+#ifndef SOT_PLUGIN_DIR
+# define SOT_PLUGIN_DIR ""
+#endif
+
+/* --------------------------------------------------------------------- */
+/* --- SCRIPT ---------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+class ScriptLoader
+{
+public:
+  ScriptLoader( const std::string& pluginDir ) : pluginDir_( pluginDir ) {}
+
+  /// Replace the word key by value in the next scripts.
+  void setVariable( const std::string& key,const std::string& value )
+  { variables_.push_back( std::make_pair( key,value ) ); }
+
+  void loadFile( const std::string& filename )
+  {
+    std::ifstream file( filename.c_str() );
+    if(! file.good() )
+      throw std::runtime_error( "Cannot open the script " + filename );
+
+    std::string line; unsigned int lineNumber = 0;
+    while( std::getline( file,line ) )
+      {
+        ++lineNumber;
+        const std::string::size_type comment = line.find( '#' );
+        if( std::string::npos!=comment ) line.erase( comment );
+        substitute( line );
+        try { runStatement( line ); }
+        catch( const dynamicgraph::ExceptionAbstract& exc )
+          { throw std::runtime_error( location( filename,lineNumber )
+                                      + exc.getStringMessage() ); }
+        catch( const std::exception& exc )
+          { throw std::runtime_error( location( filename,lineNumber )
+                                      + exc.what() ); }
+      }
+  }
+
+protected:
+  std::string pluginDir_;
+  std::vector< std::pair<std::string,std::string> > variables_;
+
+  void substitute( std::string& line ) const
+  {
+    for( std::size_t k=0;k<variables_.size();++k )
+      {
+        const std::string& key = variables_[k].first;
+        const std::string& value = variables_[k].second;
+        for( std::string::size_type pos = line.find( key );
+             std::string::npos!=pos; pos = line.find( key,pos+value.size() ) )
+          line.replace( pos,key.size(),value );
+      }
+  }
+
+  static std::string location( const std::string& filename,
+                               const unsigned int& lineNumber )
+  {
+    std::ostringstream oss; oss << filename << ":" << lineNumber << ": ";
+    return oss.str();
+  }
+
+  void runStatement( const std::string& line )
+  {
+    std::istringstream iss( line );
+    std::string statement;
+    if(! ( iss >> statement ) ) return;
+
+    if( "loadPlugin"==statement )
+      {
+        std::string name; iss >> name;
+        loadPlugin( name );
+      }
+    else if( "new"==statement )
+      {
+        std::string className,name; iss >> className >> name;
+        FactoryStorage::getInstance()->newEntity( className,name );
+      }
+    else if( "plug"==statement )
+      {
+        std::string out,in; iss >> out >> in;
+        std::istringstream outISS( out ),inISS( in );
+        SignalBase<int>& sigout = PoolStorage::getInstance()->getSignal( outISS );
+        SignalBase<int>& sigin = PoolStorage::getInstance()->getSignal( inISS );
+        sigin.plug( &sigout );
+      }
+    else if( "set"==statement )
+      {
+        std::string name; iss >> name;
+        std::istringstream nameISS( name );
+        SignalBase<int>& sig = PoolStorage::getInstance()->getSignal( nameISS );
+        std::string value; std::getline( iss,value );
+        std::istringstream valueISS( value );
+        sig.set( valueISS );
+      }
+    else runCommand( statement,iss );
+  }
+
+  void loadPlugin( const std::string& name )
+  {
+    std::string path = name;
+    if( std::string::npos==name.find( '/' ) )
+      path = pluginDir_ + "/" + name + ".so";
+    if( NULL==dlopen( path.c_str(),RTLD_NOW|RTLD_GLOBAL ) )
+      throw std::runtime_error( std::string( "Cannot load plugin: " ) + dlerror() );
+  }
+
+  void runCommand( const std::string& statement,std::istringstream& iss )
+  {
+    const std::string::size_type dot = statement.find( '.' );
+    if( std::string::npos==dot )
+      throw std::runtime_error( "Unknown statement " + statement );
+    Entity& entity
+      = PoolStorage::getInstance()->getEntity( statement.substr( 0,dot ) );
+    command::Command* cmd
+      = entity.getNewStyleCommand( statement.substr( dot+1 ) );
+
+    const std::vector<command::Value::Type>& types = cmd->valueTypes();
+    std::vector<command::Value> values;
+    for( std::size_t i=0;i<types.size();++i )
+      values.push_back( readValue( types[i],iss ) );
+    cmd->setParameterValues( values );
+    const command::Value res = cmd->execute();
+    if( command::Value::NONE!=res.type() )
+      cout << statement << ": " << res << endl;
+  }
+
+  static command::Value readValue( const command::Value::Type& type,
+                                   std::istringstream& iss )
+  {
+    using command::Value;
+    switch( type )
+      {
+      case Value::BOOL:
+        {
+          std::string v; iss >> v;
+          if( !iss ) break;
+          return Value( v=="true" || v=="True" || v=="1" );
+        }
+      case Value::UNSIGNED: { unsigned v; if( iss >> v ) return Value( v ); break; }
+      case Value::INT: { int v; if( iss >> v ) return Value( v ); break; }
+      case Value::FLOAT: { float v; if( iss >> v ) return Value( v ); break; }
+      case Value::DOUBLE: { double v; if( iss >> v ) return Value( v ); break; }
+      case Value::STRING: { std::string v; if( iss >> v ) return Value( v ); break; }
+      case Value::VECTOR: { Vector v; if( iss >> v ) return Value( v ); break; }
+      case Value::MATRIX: { Eigen::MatrixXd v; if( iss >> v ) return Value( v ); break; }
+      default:
+        throw std::runtime_error( "Unsupported argument type "
+                                  + Value::typeName( type ) );
+      }
+    throw std::runtime_error( "Cannot read an argument of type "
+                              + Value::typeName( type ) );
+  }
+};
+
+/* --------------------------------------------------------------------- */
+/* --- RUNNER ---------------------------------------------------------- */
+/* --------------------------------------------------------------------- */
+
+static double elapsed( const struct timespec& t0,const struct timespec& t1 )
+{
+  return (double)( t1.tv_sec-t0.tv_sec ) + (double)( t1.tv_nsec-t0.tv_nsec )*1e-9;
+}
+
+int main( int argc,char* argv[] )
+{
+  po::options_description desc( "Allowed options" );
+  desc.add_options()
+    ( "help","produce help message" )
+    ( "script",po::value<string>(),"command script building the graph" )
+    ( "device",po::value<string>()->default_value( "robot" ),
+      "name of the device entity" )
+    ( "ticks",po::value<unsigned int>()->default_value( 1000 ),
+      "number of calls to increment" )
+    ( "dt",po::value<double>()->default_value( 5e-3 ),"time step" )
+    ( "rate",po::value<double>()->default_value( 0 ),
+      "ticks per second (0: as fast as possible)" )
+    ( "plugin-dir",po::value<string>()->default_value( SOT_PLUGIN_DIR ),
+      "directory of the plugins" )
+    ( "copies",po::value<unsigned int>()->default_value( 1 ),
+      "number of copies of the graph" )
+    ( "threads",po::value<unsigned int>()
+      ->default_value( std::max( 1u,boost::thread::hardware_concurrency() ) ),
+      "number of threads stepping the copies" )
+    ( "output",po::value<string>(),
+      "file receiving the final states, one line per copy" )
+    ;
+  po::positional_options_description positional;
+  positional.add( "script",1 );
+
+  po::variables_map vm;
+  try
+    {
+      po::store( po::command_line_parser( argc,argv ).options( desc )
+                 .positional( positional ).run(),vm );
+      po::notify( vm );
+    }
+  catch( const std::exception& exc )
+    {
+      cerr << exc.what() << "\n" << desc << "\n";
+      return 1;
+    }
+  if( vm.count( "help" ) ) { cout << desc << "\n"; return 0; }
+  if(! vm.count( "script" ) ) { cerr << "No script specified\n" << desc << "\n"; return 1; }
+
+  const unsigned int nbTicks = vm["ticks"].as<unsigned int>();
+  const double dt = vm["dt"].as<double>();
+  const double rate = vm["rate"].as<double>();
+  const unsigned int nbCopies = std::max( 1u,vm["copies"].as<unsigned int>() );
+  const unsigned int nbThreads
+    = std::max( 1u,std::min( nbCopies,vm["threads"].as<unsigned int>() ) );
+
+  /* --- Graphs --- */
+  std::vector<Device*> devices;
+  try
+    {
+      for( unsigned int k=0;k<nbCopies;++k )
+        {
+          std::ostringstream ns,index;
+          if( nbCopies>1 ) ns << "copy" << k << "_";
+          index << k;
+
+          ScriptLoader loader( vm["plugin-dir"].as<string>() );
+          loader.setVariable( "$ns",ns.str() );
+          loader.setVariable( "$i",index.str() );
+          loader.loadFile( vm["script"].as<string>() );
+          Entity& entity = PoolStorage::getInstance()->getEntity
+            ( ns.str()+vm["device"].as<string>() );
+          Device* device = dynamic_cast<Device*>( &entity );
+          if( NULL==device )
+            throw std::runtime_error( "Entity " + entity.getName() + " is not a Device" );
+          devices.push_back( device );
+        }
+    }
+  catch( const dynamicgraph::ExceptionAbstract& exc )
+    { cerr << exc.getStringMessage() << endl; return 1; }
+  catch( const std::exception& exc )
+    { cerr << exc.what() << endl; return 1; }
+
+  /* --- Ticks --- */
+  SimulationFleet fleet( devices,nbTicks,dt,rate );
+  struct timespec start,end;
+  clock_gettime( CLOCK_MONOTONIC,&start );
+  fleet.run( nbThreads );
+  clock_gettime( CLOCK_MONOTONIC,&end );
+
+  /* --- Report --- */
+  const double total = elapsed( start,end );
+  const double nbTotalTicks = (double)nbTicks*nbCopies;
+  cout << nbCopies << "x" << nbTicks << " ticks on " << nbThreads
+       << " threads in " << total << " s: "
+       << ( ( total>0 ) ? nbTotalTicks/total : 0. ) << " ticks/s" << endl;
+  /* The ticks of the failed copies are left out. */
+  const std::vector<double> durations = fleet.sortedDurations();
+  if(! durations.empty() )
+    {
+      cout << "tick duration (us): min " << durations.front()*1e6
+           << ", p50 " << SimulationFleet::percentile( durations,.5 )*1e6
+           << ", p90 " << SimulationFleet::percentile( durations,.9 )*1e6
+           << ", p99 " << SimulationFleet::percentile( durations,.99 )*1e6
+           << ", p99.9 " << SimulationFleet::percentile( durations,.999 )*1e6
+           << ", max " << durations.back()*1e6 << endl;
+    }
+  if( rate>0 )
+    cout << fleet.overruns << " ticks longer than the period" << endl;
+
+  if( vm.count( "output" ) )
+    {
+      std::ofstream file( vm["output"].as<string>().c_str() );
+      file << fleet.states.transpose() << endl;
+    }
+  if( 1==nbCopies )
+    cout << "final state: " << fleet.states.col( 0 ).transpose() << endl;
+  else if(! vm.count( "output" ) )
+    cout << "final states (one column per copy):" << endl
+         << fleet.states << endl;
+
+  if( fleet.failures>0 )
+    { cerr << fleet.failures << " copies failed" << endl; return 1; }
+  return 0;
+}
+
+/*
+ * Local variables:
+ * c-basic-offset: 2
+ * End:
+ */
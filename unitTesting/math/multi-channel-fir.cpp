@@ -0,0 +1,184 @@
+// Copyright 2026, sot-core contributors.
+//
+// This file is part of sot-core.
+// sot-core is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// sot-core is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public License
+// along with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cmath>
+#include <iostream>
+#include <sys/time.h>
+
+#define BOOST_TEST_MODULE multi_channel_fir
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <sot/core/fir-filter.hh>
+#include <sot/core/multi-channel-fir.hh>
+
+using dynamicgraph::Vector;
+using dynamicgraph::sot::MultiChannelFIR;
+using dynamicgraph::sot::FIRFilter;
+namespace command = dynamicgraph::command;
+
+/* The computation of FIRFilter<sigT,coefT>::compute, on a vector signal. */
+struct ReferenceFIR
+{
+  std::vector<double> coefs;
+  dynamicgraph::sot::detail::circular_buffer<Vector> data;
+
+  void resize( const std::size_t& size )
+  { coefs.assign( size,0. ); data.reset_capacity( size ); }
+
+  void compute( const Vector& in,Vector& res )
+  {
+    res.resize( in.size() ); res.fill( 0 );
+    data.push_front( in );
+    const std::size_t SIZE = std::min( data.size(),coefs.size() );
+    for( std::size_t i=0;i<SIZE;++i )
+      res += coefs[i]*data[i];
+  }
+};
+
+static double elapsed( const struct timeval& t0,const struct timeval& t1 )
+{
+  return (double)( t1.tv_sec-t0.tv_sec )*1e6 + (double)( t1.tv_usec-t0.tv_usec );
+}
+
+static Vector sample( const std::size_t& nbChannels,const int& t )
+{
+  Vector in( nbChannels );
+  for( std::size_t c=0;c<nbChannels;++c )
+    in( c ) = std::sin( .01*t*( (double)c+1. ) );
+  return in;
+}
+
+BOOST_AUTO_TEST_CASE (same_output)
+{
+  const std::size_t nbTaps = 7,nbChannels = 5;
+  ReferenceFIR reference; reference.resize( nbTaps );
+  MultiChannelFIR filter; filter.resize( nbTaps );
+  for( std::size_t i=0;i<nbTaps;++i )
+    {
+      reference.coefs[i] = 1./(double)( i+1 );
+      filter.setCoefficient( i,1./(double)( i+1 ) );
+    }
+
+  /* Also during the warm-up, before nbTaps samples. */
+  Vector expected,res;
+  for( int t=0;t<50;++t )
+    {
+      const Vector in = sample( nbChannels,t );
+      reference.compute( in,expected );
+      filter.compute( in,res );
+      BOOST_REQUIRE_EQUAL( res.size(),expected.size() );
+      for( std::size_t c=0;c<nbChannels;++c )
+	BOOST_CHECK_SMALL( res( c )-expected( c ),1e-12 );
+    }
+
+  /* A new number of channels restarts the history. */
+  filter.compute( sample( 3,0 ),res );
+  BOOST_CHECK_EQUAL( filter.getNbChannels(),3u );
+  BOOST_CHECK_SMALL( res( 1 )-sample( 3,0 )( 1 ),1e-12 );
+}
+
+/* Run the command name of entity with the given arguments. */
+static command::Value run( dynamicgraph::Entity& entity,const std::string& name,
+			   const std::vector<command::Value>& values )
+{
+  command::Command* cmd = entity.getNewStyleCommand( name );
+  cmd->setParameterValues( values );
+  return cmd->execute();
+}
+
+static void setElement( dynamicgraph::Entity& entity,const unsigned int& rank,
+			const double& coef )
+{
+  std::vector<command::Value> values;
+  values.push_back( command::Value( rank ) );
+  values.push_back( command::Value( coef ) );
+  run( entity,"setElement",values );
+}
+
+static void setSize( dynamicgraph::Entity& entity,const unsigned int& size )
+{ run( entity,"setSize",std::vector<command::Value>( 1,command::Value( size ) ) ); }
+
+BOOST_AUTO_TEST_CASE (entity)
+{
+  const std::size_t nbChannels = 4;
+  FIRFilter<Vector,double> filter( "fir" );
+  ReferenceFIR reference; reference.resize( 3 );
+  setSize( filter,3 );
+  for( unsigned int i=0;i<3;++i )
+    { setElement( filter,i,.5/( i+1. ) ); reference.coefs[i] = .5/( i+1. ); }
+
+  Vector expected;
+  int t = 0;
+  for( ;t<20;++t )
+    {
+      const Vector in = sample( nbChannels,t );
+      filter.SIN.setConstant( in );
+      reference.compute( in,expected );
+      BOOST_CHECK_SMALL( ( filter.SOUT( t )-expected ).norm(),1e-12 );
+    }
+
+  /* More coefficients: the first ones are kept, the new ones are zero,
+     and the history restarts. */
+  setSize( filter,5 );
+  reference.coefs.resize( 5,0. ); reference.data.reset_capacity( 5 );
+  BOOST_CHECK_EQUAL( filter.getElement( 1 ),.25 );
+  BOOST_CHECK_EQUAL( filter.getElement( 4 ),0. );
+  setElement( filter,4,.1 ); reference.coefs[4] = .1;
+  for( ;t<40;++t )
+    {
+      const Vector in = sample( nbChannels,t );
+      filter.SIN.setConstant( in );
+      reference.compute( in,expected );
+      BOOST_CHECK_SMALL( ( filter.SOUT( t )-expected ).norm(),1e-12 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE (benchmark)
+{
+  const std::size_t channels[] = { 30,60 };
+  const std::size_t taps[] = { 32,256 };
+  const int nbTicks = 2000;
+
+  for( int ic=0;ic<2;++ic )
+    for( int it=0;it<2;++it )
+      {
+	const std::size_t nbChannels = channels[ic],nbTaps = taps[it];
+	ReferenceFIR reference; reference.resize( nbTaps );
+	MultiChannelFIR filter; filter.resize( nbTaps );
+	for( std::size_t i=0;i<nbTaps;++i )
+	  {
+	    reference.coefs[i] = 1./(double)nbTaps;
+	    filter.setCoefficient( i,1./(double)nbTaps );
+	  }
+	std::vector<Vector> inputs;
+	for( int t=0;t<nbTicks;++t ) inputs.push_back( sample( nbChannels,t ) );
+
+	Vector expected,res;
+	struct timeval t0,t1,t2;
+	gettimeofday( &t0,NULL );
+	for( int t=0;t<nbTicks;++t ) reference.compute( inputs[t],expected );
+	gettimeofday( &t1,NULL );
+	for( int t=0;t<nbTicks;++t ) filter.compute( inputs[t],res );
+	gettimeofday( &t2,NULL );
+
+	for( std::size_t c=0;c<nbChannels;++c )
+	  BOOST_CHECK_SMALL( res( c )-expected( c ),1e-9 );
+	std::cout << nbChannels << " channels, " << nbTaps << " taps: "
+		  << elapsed( t0,t1 )/nbTicks << " us per sample (template), "
+		  << elapsed( t1,t2 )/nbTicks << " us (channel-major)" << std::endl;
+      }
+}
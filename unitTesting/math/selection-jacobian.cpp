@@ -0,0 +1,84 @@
+// Copyright 2026, sot-core contributors.
+//
+// This file is part of sot-core.
+// sot-core is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// sot-core is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public License
+// along with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <sstream>
+
+#define BOOST_TEST_MODULE selection_jacobian
+
+#include <boost/test/unit_test.hpp>
+
+#include <sot/core/selection-jacobian.hh>
+
+using dynamicgraph::sot::SelectionJacobian;
+namespace dg = dynamicgraph;
+
+BOOST_AUTO_TEST_CASE (dense_form)
+{
+  SelectionJacobian S (3, 5);
+  S.set (0, 1, 2.);
+  S.set (1, 3);
+  S.set (2, 4, -.5);
+
+  dg::Matrix J;
+  S.toDense (J);
+  BOOST_CHECK_EQUAL (J.rows (), 3);
+  BOOST_CHECK_EQUAL (J.cols (), 5);
+  BOOST_CHECK_EQUAL (J.sum (), 2.5);
+  BOOST_CHECK_EQUAL (J (0, 1), 2.);
+  BOOST_CHECK_EQUAL (J (1, 3), 1.);
+  BOOST_CHECK_EQUAL (J (2, 4), -.5);
+}
+
+BOOST_AUTO_TEST_CASE (gather_product)
+{
+  SelectionJacobian S (3, 5);
+  S.set (0, 1, 2.);
+  S.set (1, 3);
+  S.set (2, 0, -.5);
+
+  dg::Matrix J; S.toDense (J);
+  dg::Matrix P = dg::Matrix::Random (5, 4);
+  dg::Matrix SP;
+  S.multiply (P, SP);
+  BOOST_CHECK (SP.isApprox (J*P));
+
+  dg::Vector v = dg::Vector::Random (5);
+  dg::Vector Sv;
+  S.multiply (v, Sv);
+  BOOST_CHECK (Sv.isApprox (J*v));
+}
+
+BOOST_AUTO_TEST_CASE (stacking)
+{
+  SelectionJacobian S1 (1, 4), S2 (2, 4);
+  S1.set (0, 2, 3.);
+  S2.set (0, 0); S2.set (1, 3, 4.);
+
+  SelectionJacobian S (3, 4);
+  S.setRows (0, S1);
+  S.setRows (1, S2);
+
+  dg::Matrix J (3, 4);
+  S1.writeRows (J, 0);
+  S2.writeRows (J, 1);
+  dg::Matrix Jdense;
+  BOOST_CHECK (S.toDense (Jdense) == J);
+
+  std::ostringstream oss; oss << S;
+  std::istringstream iss (oss.str ());
+  SelectionJacobian Sread;
+  iss >> Sread;
+  BOOST_CHECK (Sread.toDense (Jdense) == J);
+}
@@ -178,6 +178,27 @@ class OpPointModifierTest(unittest.TestCase):
         # Check w_M_s == w_M_s_ref
         self.assertEqual(np.equal(J, J_ref).all(), True)
 
+    def test_batch(self):
+        tx = 11.; ty = 22.; tz = 33.
+
+        T = ((0., 0., 1., tx),
+             (0.,-1., 0., ty),
+             (1., 0., 0., tz),
+             (0., 0., 0., 1.))
+
+        op = OpPointModifier('op5')
+        op.setTransformation(T)
+        op.jacobianIN.value = Jgaze
+        op.jacobiansIN.value = Jgaze + Jgaze
+        op.jacobian.recompute(1)
+        op.jacobians.recompute(1)
+
+        J = np.asmatrix(op.jacobian.value)
+        Js = np.asmatrix(op.jacobians.value)
+        self.assertEqual(Js.shape, (12, 6))
+        self.assertEqual(np.equal(Js[0:6,:], J).all(), True)
+        self.assertEqual(np.equal(Js[6:12,:], J).all(), True)
+
 
 if __name__ == '__main__':
     unittest.main()
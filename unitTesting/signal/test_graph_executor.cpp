@@ -0,0 +1,184 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* -------------------------------------------------------------------------- */
+/* --- INCLUDES ------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+#include <boost/test/unit_test.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <dynamic-graph/all-signals.h>
+#include <sot/core/graph-executor.hh>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace dynamicgraph::sot;
+namespace dg = dynamicgraph;
+
+typedef dg::SignalTimeDependent<double,int> SignalDouble;
+
+/* Count the evaluations, and check that the dependency read by a signal
+ * is up to date when it is evaluated. */
+struct Counter
+{
+  boost::mutex mutex;
+  int calls;
+  int errors;
+
+  Counter( void ) : calls(0),errors(0) {}
+
+  double& fun( dg::Signal<double,int>* dep,double& res,int t )
+  {
+    {
+      boost::mutex::scoped_lock lock( mutex );
+      ++calls;
+      if( dep->getTime()!=t ) ++errors;
+    }
+    return res = (*dep)( t );
+  }
+
+  double& sum( const std::vector<SignalDouble*>* deps,double& res,int t )
+  {
+    res = 0;
+    for( std::size_t k=0;k<deps->size();++k ) res += (*(*deps)[k])( t );
+    return res;
+  }
+};
+
+/* Input of the graph, as the state of the device. */
+struct Clock : public dg::Signal<double,int>
+{
+  Clock( void ) : dg::Signal<double,int>( "clock" ) { setConstant( 0 ); }
+  void tick( const int& t ) { setConstant( t ); setTime( t ); }
+};
+
+BOOST_AUTO_TEST_CASE (parallel_branches)
+{
+  const int NB_BRANCHES = 6;
+  Counter counter;
+  Clock clock;
+  std::vector<SignalDouble*> signals,tasks;
+  SignalDouble root( boost::bind(&Counter::sum,&counter,&tasks,_1,_2),
+		     dg::sotNOSIGNAL,"sotSOT(s)::output(vector)::control" );
+
+  /* One feature and one task per branch. The time derivative of the error
+   * is declared by the abstract class of the feature, and not read. */
+  for( int k=0;k<NB_BRANCHES;++k )
+    {
+      std::ostringstream feature,derivative,task;
+      feature << "sotFeaturePoint6d(f" << k << ")::output(vector)::error";
+      derivative << "sotFeatureAbstract(f" << k << ")::output(vector)::errordot";
+      task << "sotTask(t" << k << ")::output(vector)::task";
+      SignalDouble* error = new SignalDouble
+	( boost::bind(&Counter::fun,&counter,&clock,_1,_2),clock,feature.str() );
+      SignalDouble* errordot = new SignalDouble
+	( boost::bind(&Counter::fun,&counter,&clock,_1,_2),clock,derivative.str() );
+      SignalDouble* out = new SignalDouble
+	( boost::bind(&Counter::fun,&counter,error,_1,_2),
+	  (*error)<<(*errordot),task.str() );
+      root.addDependency( *out );
+      signals.push_back( error ); signals.push_back( errordot );
+      signals.push_back( out ); tasks.push_back( out );
+    }
+
+  GraphExecutor executor;
+  executor.addRoot( root );
+  executor.setWorkerCount( 3 );
+  executor.start();
+  /* The signals of a feature are grouped, whatever their class prefix. */
+  BOOST_CHECK_EQUAL (executor.getTaskCount(), 2u*NB_BRANCHES);
+
+  /* The executor runs before the pull of the root, as in the Sot. */
+  for( int t=1;t<=100;++t )
+    {
+      clock.tick( t );
+      executor.run( t );
+      if( t>1 )
+	for( std::size_t k=0;k<tasks.size();++k )
+	  BOOST_CHECK_EQUAL (tasks[k]->getTime(), t);
+      root( t );
+      /* The first tick is a pull: the tasks read their errors before they
+       * are up to date. */
+      if( 1==t ) counter.errors = 0;
+    }
+  BOOST_CHECK_EQUAL (counter.calls, 100*2*NB_BRANCHES);
+  BOOST_CHECK_EQUAL (counter.errors, 0);
+  BOOST_CHECK_EQUAL (root.accessCopy(), 100*NB_BRANCHES);
+
+  /* The deterministic mode gives the same evaluations. */
+  executor.setDeterministic( true );
+  clock.tick( 101 );
+  executor.run( 101 );
+  root( 101 );
+  BOOST_CHECK_EQUAL (counter.calls, 101*2*NB_BRANCHES);
+  BOOST_CHECK_EQUAL (counter.errors, 0);
+
+  executor.stop();
+  for( std::size_t k=0;k<signals.size();++k ) delete signals[k];
+}
+
+BOOST_AUTO_TEST_CASE (shared_dependency)
+{
+  /* Two tasks declare the same time derivative, which nothing reads. */
+  Counter counter,derivatives;
+  Clock clock;
+  std::vector<SignalDouble*> signals,tasks;
+  SignalDouble root( boost::bind(&Counter::sum,&counter,&tasks,_1,_2),
+		     dg::sotNOSIGNAL,"sotSOT(s)::output(vector)::control" );
+  SignalDouble errordot( boost::bind(&Counter::fun,&derivatives,&clock,_1,_2),
+			 clock,"sotFeatureAbstract(f)::output(vector)::errordot" );
+  for( int k=0;k<2;++k )
+    {
+      std::ostringstream feature,task;
+      feature << "sotFeaturePoint6d(f" << k << ")::output(vector)::error";
+      task << "sotTask(t" << k << ")::output(vector)::task";
+      SignalDouble* error = new SignalDouble
+	( boost::bind(&Counter::fun,&counter,&clock,_1,_2),clock,feature.str() );
+      SignalDouble* out = new SignalDouble
+	( boost::bind(&Counter::fun,&counter,error,_1,_2),
+	  (*error)<<errordot,task.str() );
+      root.addDependency( *out );
+      signals.push_back( error ); signals.push_back( out );
+      tasks.push_back( out );
+    }
+
+  GraphExecutor executor;
+  executor.addRoot( root );
+  executor.setWorkerCount( 3 );
+  executor.start();
+  BOOST_CHECK_EQUAL (executor.getTaskCount(), 5u);
+
+  /* The derivative is evaluated by its own task once the active signals
+   * are known, instead of being tested by both tasks at once. */
+  for( int t=1;t<=50;++t )
+    {
+      clock.tick( t );
+      executor.run( t );
+      root( t );
+      if( 1==t ) counter.errors = 0;
+    }
+  BOOST_CHECK_EQUAL (derivatives.calls, 49);
+  BOOST_CHECK_EQUAL (derivatives.errors, 0);
+  BOOST_CHECK_EQUAL (counter.calls, 50*4);
+  BOOST_CHECK_EQUAL (counter.errors, 0);
+  BOOST_CHECK_EQUAL (root.accessCopy(), 2*50);
+
+  executor.stop();
+  for( std::size_t k=0;k<signals.size();++k ) delete signals[k];
+}
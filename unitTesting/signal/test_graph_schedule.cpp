@@ -0,0 +1,313 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* -------------------------------------------------------------------------- */
+/* --- INCLUDES ------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+#include <boost/test/unit_test.hpp>
+#include <boost/bind.hpp>
+
+#include <dynamic-graph/all-signals.h>
+#include <sot/core/graph-schedule.hh>
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <sys/time.h>
+
+using namespace dynamicgraph::sot;
+namespace dg = dynamicgraph;
+
+typedef dg::SignalTimeDependent<double,int> SignalDouble;
+typedef std::vector< dg::Signal<double,int>* > Reads;
+
+/* Record the order of the evaluations. A signal reads the signals of its
+ * list only, whatever its dependencies. */
+struct Recorder
+{
+  std::vector<std::string> calls;
+  bool failing;
+
+  Recorder( void ) : failing( false ) {}
+
+  double& fun( const std::string& name,const Reads& reads,double& res,int t )
+  {
+    res = t;
+    for( std::size_t k=0;k<reads.size();++k ) res += (*reads[k])( t );
+    calls.push_back( name );
+    return res;
+  }
+
+  double& fail( const std::string& name,double& res,int t )
+  {
+    if( failing ) throw std::runtime_error( name );
+    calls.push_back( name );
+    return res = t;
+  }
+
+  int count( const std::string& name ) const
+  { return (int)std::count( calls.begin(),calls.end(),name ); }
+};
+
+/* Value of a chain element, without recording. */
+static double& chain( const Reads& reads,double& res,int t )
+{
+  res = t + (*reads[0])( t );
+  return res;
+}
+
+static Reads reads( dg::Signal<double,int>& a )
+{ return Reads( 1,&a ); }
+static Reads reads( dg::Signal<double,int>& a,dg::Signal<double,int>& b )
+{ Reads res( 1,&a ); res.push_back( &b ); return res; }
+
+/* Input of the graph, as the state of the device: a new value at each
+ * tick. */
+struct Clock : public dg::Signal<double,int>
+{
+  Clock( void ) : dg::Signal<double,int>( "clock" ) { setConstant( 0 ); }
+  void tick( const int& t ) { setConstant( t ); setTime( t ); }
+};
+
+BOOST_AUTO_TEST_CASE (schedule_order)
+{
+  Recorder rec;
+  Clock clock;
+  SignalDouble a( boost::bind(&Recorder::fun,&rec,std::string("a"),reads(clock),_1,_2),
+		  clock,"a" );
+  SignalDouble b( boost::bind(&Recorder::fun,&rec,std::string("b"),reads(a),_1,_2),
+		  a,"b" );
+  dg::SignalPtr<double,int> p( NULL,"p" );
+  p.plug( &b );
+  SignalDouble root( boost::bind(&Recorder::fun,&rec,std::string("root"),reads(p),_1,_2),
+		     p,"root" );
+
+  GraphSchedule schedule;
+  schedule.addRoot( root );
+  schedule.freeze();
+
+  BOOST_REQUIRE_EQUAL (schedule.getSchedule().size(), 2u);
+  BOOST_CHECK_EQUAL (schedule.getSchedule()[0], &a);
+  BOOST_CHECK_EQUAL (schedule.getSchedule()[1], &b);
+
+  /* The first tick is a pull, which activates the signals it reads. */
+  clock.tick( 1 );
+  schedule.run( 1 );
+  BOOST_CHECK_EQUAL (rec.calls.size(), 3u);
+  BOOST_CHECK (! schedule.isActive( 0 ));
+
+  /* The dependencies are up to date when the root is pulled. */
+  rec.calls.clear();
+  clock.tick( 2 );
+  schedule.run( 2 );
+  BOOST_CHECK (schedule.isActive( 0 ));
+  BOOST_CHECK (schedule.isActive( 1 ));
+  BOOST_REQUIRE_EQUAL (rec.calls.size(), 3u);
+  BOOST_CHECK_EQUAL (rec.calls[0], "a");
+  BOOST_CHECK_EQUAL (rec.calls[1], "b");
+  BOOST_CHECK_EQUAL (rec.calls[2], "root");
+  BOOST_CHECK_EQUAL (root.accessCopy(), 4*2);
+  BOOST_CHECK_EQUAL (schedule.getRebuildCount(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE (schedule_need)
+{
+  /* The root reads a fast signal and a signal of period 3, but not the
+   * signal standing for a time derivative. */
+  Recorder rec;
+  Clock clock;
+  SignalDouble fast( boost::bind(&Recorder::fun,&rec,std::string("fast"),reads(clock),_1,_2),
+		     clock,"fast" );
+  SignalDouble slow( boost::bind(&Recorder::fun,&rec,std::string("slow"),reads(clock),_1,_2),
+		     clock,"slow" );
+  slow.setPeriodTime( 3 );
+  SignalDouble derivative( boost::bind(&Recorder::fun,&rec,std::string("derivative"),
+				       reads(clock),_1,_2),clock,"derivative" );
+  SignalDouble root( boost::bind(&Recorder::fun,&rec,std::string("root"),
+				 reads(fast,slow),_1,_2),
+		     fast<<slow<<derivative,"root" );
+
+  GraphSchedule schedule;
+  schedule.addRoot( root );
+  schedule.freeze();
+  BOOST_CHECK_EQUAL (schedule.getSchedule().size(), 3u);
+
+  std::vector<double> values;
+  for( int t=1;t<=12;++t )
+    {
+      clock.tick( t );
+      schedule.run( t );
+      values.push_back( root.accessCopy() );
+    }
+  BOOST_CHECK_EQUAL (rec.count( "root" ), 12);
+  BOOST_CHECK_EQUAL (rec.count( "fast" ), 12);
+  BOOST_CHECK_EQUAL (rec.count( "slow" ), 4);
+  BOOST_CHECK_EQUAL (rec.count( "derivative" ), 0);
+
+  /* Same values as the pull. */
+  schedule.unfreeze();
+  for( int t=13;t<=15;++t ) { clock.tick( t ); schedule.run( t ); }
+  BOOST_CHECK_EQUAL (rec.count( "slow" ), 5);
+  BOOST_CHECK_EQUAL (rec.count( "derivative" ), 0);
+  BOOST_CHECK_EQUAL (values[11], 12+2*12+2*10);
+  BOOST_CHECK_EQUAL (root.accessCopy(), 15+2*15+2*13);
+}
+
+BOOST_AUTO_TEST_CASE (schedule_errors)
+{
+  /* A signal failing during the evaluation of the schedule is reported
+   * by the pull of the root. */
+  Recorder rec;
+  Clock clock;
+  SignalDouble a( boost::bind(&Recorder::fail,&rec,std::string("a"),_1,_2),clock,"a" );
+  SignalDouble root( boost::bind(&Recorder::fun,&rec,std::string("root"),reads(a),_1,_2),
+		     a,"root" );
+
+  GraphSchedule schedule;
+  schedule.addRoot( root );
+  schedule.freeze();
+  for( int t=1;t<=3;++t ) { clock.tick( t ); schedule.run( t ); }
+  BOOST_CHECK_EQUAL (rec.count( "a" ), 3);
+
+  rec.failing = true;
+  clock.tick( 4 );
+  BOOST_CHECK_THROW (schedule.run( 4 ), std::runtime_error);
+  rec.failing = false;
+  clock.tick( 5 );
+  schedule.run( 5 );
+  BOOST_CHECK_EQUAL (root.accessCopy(), 5+5);
+}
+
+BOOST_AUTO_TEST_CASE (schedule_rebuild)
+{
+  Recorder rec;
+  Clock clock;
+  SignalDouble a( boost::bind(&Recorder::fun,&rec,std::string("a"),reads(clock),_1,_2),
+		  clock,"a" );
+  SignalDouble c( boost::bind(&Recorder::fun,&rec,std::string("c"),reads(clock),_1,_2),
+		  clock,"c" );
+  SignalDouble root( boost::bind(&Recorder::fun,&rec,std::string("root"),reads(a),_1,_2),
+		     a,"root" );
+
+  GraphSchedule schedule;
+  schedule.addRoot( root );
+  schedule.setCheckPeriod( 3 );
+  schedule.freeze();
+  clock.tick( 1 );
+  schedule.run( 1 );
+  BOOST_CHECK (schedule.checkTopology());
+  BOOST_CHECK_EQUAL (schedule.getRebuildCount(), 1u);
+
+  /* A new dependency is detected at the next check of the topology. */
+  root.addDependency( c );
+  BOOST_CHECK (! schedule.checkTopology());
+  for( int t=2;t<=3;++t ) { clock.tick( t ); schedule.run( t ); }
+  BOOST_CHECK_EQUAL (schedule.getRebuildCount(), 1u);
+  clock.tick( 4 );
+  schedule.run( 4 );
+  BOOST_CHECK_EQUAL (schedule.getRebuildCount(), 2u);
+  const std::vector<GraphSchedule::SignalType*>& signals = schedule.getSchedule();
+  BOOST_REQUIRE_EQUAL (signals.size(), 2u);
+  BOOST_CHECK (signals.end() != std::find( signals.begin(),signals.end(),&c ));
+
+  /* A dependency replaced by another one changes the topology as well. */
+  root.removeDependency( c );
+  root.addDependency( clock );
+  BOOST_CHECK (! schedule.checkTopology());
+  root.removeDependency( clock );
+  root.addDependency( c );
+  BOOST_CHECK (schedule.checkTopology());
+
+  /* invalidate checks the topology at the next run. */
+  root.removeDependency( c );
+  schedule.invalidate();
+  clock.tick( 5 );
+  schedule.run( 5 );
+  BOOST_CHECK_EQUAL (schedule.getRebuildCount(), 3u);
+  BOOST_CHECK_EQUAL (schedule.getSchedule().size(), 1u);
+
+  /* Unfrozen, the schedule only pulls the root. */
+  schedule.unfreeze();
+  rec.calls.clear();
+  clock.tick( 6 );
+  schedule.run( 6 );
+  BOOST_REQUIRE_EQUAL (rec.calls.size(), 2u);
+  BOOST_CHECK_EQUAL (rec.calls[1], "root");
+}
+
+static double elapsed( const struct timeval& t0,const struct timeval& t1 )
+{
+  return (double)( t1.tv_sec-t0.tv_sec )*1e6 + (double)( t1.tv_usec-t0.tv_usec );
+}
+
+BOOST_AUTO_TEST_CASE (benchmark)
+{
+  /* Chains of signals, as the features and tasks of a stack: each level
+   * reads the previous one, and declares a time derivative that is not
+   * read. */
+  const int NB_BRANCHES = 20,DEPTH = 30,NB_TICKS = 1000;
+  Recorder rec;
+  Clock clock;
+  std::vector<SignalDouble*> signals;
+  Reads tips;
+  for( int k=0;k<NB_BRANCHES;++k )
+    {
+      dg::Signal<double,int>* previous = &clock;
+      for( int d=0;d<DEPTH;++d )
+	{
+	  std::ostringstream name; name << "s" << k << "_" << d;
+	  SignalDouble* derivative = new SignalDouble
+	    ( boost::bind(&Recorder::fun,&rec,std::string("derivative"),
+			  reads(*previous),_1,_2),*previous,name.str()+"dot" );
+	  SignalDouble* sig = new SignalDouble
+	    ( boost::bind(&chain,reads(*previous),_1,_2),*previous,name.str() );
+	  sig->addDependency( *derivative );
+	  signals.push_back( derivative ); signals.push_back( sig );
+	  previous = sig;
+	}
+      tips.push_back( previous );
+    }
+  Recorder sum;
+  SignalDouble root( boost::bind(&Recorder::fun,&sum,std::string("root"),tips,_1,_2),
+		     dg::sotNOSIGNAL,"root" );
+  for( std::size_t k=0;k<tips.size();++k ) root.addDependency( *tips[k] );
+
+  GraphSchedule pull,flat;
+  pull.addRoot( root );
+  flat.addRoot( root );
+  flat.freeze();
+
+  struct timeval t0,t1,t2;
+  int t = 0;
+  gettimeofday( &t0,NULL );
+  for( int i=0;i<NB_TICKS;++i ) { clock.tick( ++t ); pull.run( t ); }
+  gettimeofday( &t1,NULL );
+  const double pulled = root.accessCopy();
+  for( int i=0;i<NB_TICKS;++i ) { clock.tick( ++t ); flat.run( t ); }
+  gettimeofday( &t2,NULL );
+
+  BOOST_CHECK_EQUAL (rec.count( "derivative" ), 0);
+  BOOST_CHECK_EQUAL (root.accessCopy()-pulled, NB_TICKS*( 1+NB_BRANCHES*( DEPTH+1 ) ));
+  /* The flat schedule avoids the recursive update tests of the pull. */
+  BOOST_WARN_LT (elapsed( t1,t2 ), elapsed( t0,t1 ));
+  std::cout << NB_BRANCHES*DEPTH << " signals: "
+	    << elapsed( t0,t1 )/NB_TICKS << " us per tick (pull), "
+	    << elapsed( t1,t2 )/NB_TICKS << " us (schedule)" << std::endl;
+  for( std::size_t k=0;k<signals.size();++k ) delete signals[k];
+}
@@ -0,0 +1,90 @@
+// Copyright 2026, sot-core contributors.
+//
+// This file is part of sot-core.
+// sot-core is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// sot-core is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public License
+// along with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+
+#define BOOST_TEST_MODULE compute_all
+
+#include <boost/test/unit_test.hpp>
+
+#include <sot/core/feature-visual-point.hh>
+#include <sot/core/exception-feature.hh>
+
+using namespace dynamicgraph::sot;
+namespace dg = dynamicgraph;
+
+BOOST_AUTO_TEST_CASE (shared_result)
+{
+  FeatureVisualPoint p ("p_compute_all");
+  FeatureVisualPoint pdes ("pd_compute_all");
+
+  dg::Vector xy (2); xy << .1, -.2;
+  dg::Matrix Jq (6, 4); Jq.setRandom ();
+  p.xySIN = xy;
+  p.ZSIN = 2.;
+  p.articularJacobianSIN = Jq;
+  pdes.xySIN = dg::Vector::Zero (2);
+  p.setReference (&pdes);
+
+  BOOST_CHECK (p.errorSOUT (1).isApprox (xy));
+  dg::Matrix L (2, 6);
+  L << -.5, 0, .05, -.02, -1.01, -.2,
+       0, -.5, -.1, 1.04, .02, -.1;
+  BOOST_CHECK (p.jacobianSOUT (1).isApprox (L*Jq));
+
+  /* An output forced to recompute at the same time, e.g. after a change
+     of the inputs, evaluates the shared result again. */
+  xy << .3, .4;
+  p.xySIN = xy;
+  p.errorSOUT.setReady ();
+  p.errorSOUT.recompute (1);
+  BOOST_CHECK (p.errorSOUT.accessCopy ().isApprox (xy));
+  L << -.5, 0, .15, .12, -1.09, .4,
+       0, -.5, .2, 1.16, -.12, -.3;
+  p.jacobianSOUT.setReady ();
+  p.jacobianSOUT.recompute (1);
+  BOOST_CHECK (p.jacobianSOUT.accessCopy ().isApprox (L*Jq));
+
+  /* The outputs at the next time share a new evaluation. */
+  xy << .1, -.2;
+  p.xySIN = xy;
+  BOOST_CHECK (p.errorSOUT (2).isApprox (xy));
+  BOOST_CHECK (! p.jacobianSOUT (2).isApprox (L*Jq));
+
+  /* Without reference, the error reports the failure, while the Jacobian
+     is still available. */
+  p.setReference (NULL);
+  p.xySIN = xy;
+  BOOST_CHECK_THROW (p.errorSOUT (3), ExceptionFeature);
+  BOOST_CHECK_NO_THROW (p.jacobianSOUT (3));
+
+  /* With the articular Jacobian unplugged, only the error is shared. */
+  FeatureVisualPoint q ("q_compute_all");
+  q.xySIN = xy;
+  q.setReference (&pdes);
+  BOOST_CHECK (q.errorSOUT (1).isApprox (xy));
+  BOOST_CHECK_THROW (q.jacobianSOUT (1), dg::ExceptionAbstract);
+
+  /* The time derivative of the error is evaluated alone when it is first
+     read, then joins the shared result. */
+  dg::Vector xydot (2); xydot << .5, .7;
+  pdes.errordotSIN = xydot;
+  p.setReference (&pdes);
+  BOOST_CHECK (p.errorSOUT (4).isApprox (xy));
+  BOOST_CHECK (p.errordotSOUT (4).isApprox (xydot));
+  BOOST_CHECK (p.errorSOUT (5).isApprox (xy));
+  pdes.errordotSIN = dg::Vector::Zero (2);
+  BOOST_CHECK (p.errordotSOUT (5).isApprox (xydot));
+  p.errordotSOUT.setReady ();
+  BOOST_CHECK (p.errordotSOUT (6).isZero ());
+}
@@ -0,0 +1,161 @@
+// Copyright 2026, sot-core contributors.
+//
+// This file is part of sot-core.
+// sot-core is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// sot-core is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public License
+// along with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <string>
+
+#define BOOST_TEST_MODULE feature_segment_distances
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <Eigen/Geometry>
+
+#include <sot/core/feature-segment-distances.hh>
+
+using namespace dynamicgraph::sot;
+namespace dg = dynamicgraph;
+
+/* Distance between the segments of one row, by sampling the parameter
+   of segment A finely and projecting on segment B. */
+static double distance( const dg::Matrix& seg,const dg::Matrix::Index k )
+{
+  const Eigen::Vector3d A0 = seg.block<1,3> (k, 0).transpose ();
+  const Eigen::Vector3d A1 = seg.block<1,3> (k, 3).transpose ();
+  const Eigen::Vector3d B0 = seg.block<1,3> (k, 6).transpose ();
+  const Eigen::Vector3d B1 = seg.block<1,3> (k, 9).transpose ();
+  const Eigen::Vector3d d2 = B1 - B0;
+  double best = 1e9;
+  for( int i=0;i<=20000;++i )
+    {
+      const Eigen::Vector3d p = A0 + (A1 - A0)*(i/20000.);
+      double t = d2.dot (p - B0)/d2.squaredNorm ();
+      t = std::max (0., std::min (1., t));
+      best = std::min (best, (p - B0 - t*d2).norm ());
+    }
+  return best;
+}
+
+/* Segments of pair k after the bodies moved by eps times their twists,
+   expressed at the first endpoint of each segment. */
+static dg::Matrix move( const dg::Matrix& seg,const dg::Matrix& Jq,
+			const dg::Vector& dq,const double& eps )
+{
+  dg::Matrix res = seg;
+  for( dg::Matrix::Index k=0;k<seg.rows ();++k )
+    for( int body=0;body<2;++body )
+      {
+	const dg::Vector twist = Jq.middleRows (12*k+6*body, 6)*dq*eps;
+	const Eigen::Vector3d w = twist.tail<3> ();
+	const Eigen::Matrix3d R = (w.norm ()>0)
+	  ? Eigen::AngleAxisd (w.norm (), w.normalized ()).toRotationMatrix ()
+	  : Eigen::Matrix3d::Identity ();
+	const Eigen::Vector3d O = seg.block<1,3> (k, 6*body).transpose ();
+	for( int end=0;end<2;++end )
+	  {
+	    const Eigen::Vector3d p = seg.block<1,3> (k, 6*body+3*end).transpose ();
+	    res.block<1,3> (k, 6*body+3*end)
+	      = (O + twist.head<3> () + R*(p - O)).transpose ();
+	  }
+      }
+  return res;
+}
+
+struct Fixture
+{
+  FeatureSegmentDistances feature;
+  dg::Matrix seg,Jq;
+
+  Fixture (const std::string& name) : feature (name), seg (4, 12), Jq (48, 5)
+  {
+    /* 0: crossing segments, closest points inside both of them.
+       1: closest point at the end of A, inside B.
+       2: closest points at the ends of both segments.
+       3: far apart, beyond the activation distance. */
+    seg << -1., 0., 0.,  1., 0., 0.,    .2, -1., .05,  -.1, 1., .06,
+            0., 0., 0.,  1., 0., 0.,   1.04, -1., .02,  1.05, 1., .03,
+            0., 0., 0.,  1., .1, 0.,   1.03, .12, .01,  2., 1., .2,
+            0., 0., 0.,  0., 0., 1.,    1., 0., 0.,   1., 0., 1.;
+    for( dg::Matrix::Index i=0;i<Jq.rows ();++i )
+      for( dg::Matrix::Index j=0;j<Jq.cols ();++j )
+	Jq (i, j) = std::sin (1.3*i + 2.7*j + .5);
+    feature.segmentsSIN = seg;
+    feature.jacobiansSIN = Jq;
+    feature.activationDistanceSIN = .2;
+  }
+};
+
+BOOST_AUTO_TEST_CASE (distances)
+{
+  Fixture f ("distances");
+  const dg::Vector& d = f.feature.distancesSOUT (1);
+  BOOST_CHECK_EQUAL (d.size (), 4);
+  for( dg::Matrix::Index k=0;k<4;++k )
+    BOOST_CHECK_SMALL (d (k) - distance (f.seg, k), 1e-6);
+
+  const dg::Vector& active = f.feature.activeSOUT (1);
+  BOOST_CHECK_EQUAL (active.size (), 3);
+  BOOST_CHECK_EQUAL (f.feature.errorSOUT (1).size (), 3);
+  for( int i=0;i<3;++i )
+    {
+      BOOST_CHECK_EQUAL (active (i), i);
+      BOOST_CHECK_EQUAL (f.feature.errorSOUT (1) (i), d (i));
+    }
+
+  /* The radii are removed from the distances. */
+  dg::Vector radii (4); radii << .01, .02, 0., .5;
+  f.feature.radiiSIN = radii;
+  BOOST_CHECK ((f.feature.distancesSOUT (2) - (d - radii)).isZero (1e-12));
+}
+
+BOOST_AUTO_TEST_CASE (jacobian)
+{
+  Fixture f ("jacobian");
+  const dg::Matrix& J = f.feature.jacobianSOUT (1);
+  BOOST_CHECK_EQUAL (J.rows (), 3);
+  BOOST_CHECK_EQUAL (J.cols (), 5);
+
+  /* Central differences of the distance of each active pair, for a
+     motion along each joint. */
+  const double eps = 1e-6;
+  FeatureSegmentDistances fd ("jacobian_fd");
+  int t = 0;
+  for( dg::Matrix::Index j=0;j<J.cols ();++j )
+    {
+      const dg::Vector dq = dg::Vector::Unit (5, j);
+      const dg::Matrix plus = move (f.seg, f.Jq, dq, eps);
+      const dg::Matrix minus = move (f.seg, f.Jq, dq, -eps);
+      for( dg::Matrix::Index k=0;k<3;++k )
+	{
+	  fd.segmentsSIN = plus;
+	  const double dplus = fd.distancesSOUT (++t) (k);
+	  fd.segmentsSIN = minus;
+	  const double dminus = fd.distancesSOUT (++t) (k);
+	  BOOST_CHECK_SMALL (J (k, j) - (dplus - dminus)/(2*eps), 1e-5);
+	}
+    }
+}
+
+BOOST_AUTO_TEST_CASE (selection)
+{
+  Fixture f ("selection");
+  Flags fl (true); fl.unset (1);
+  f.feature.selectionSIN = fl;
+  const dg::Vector& active = f.feature.activeSOUT (1);
+  BOOST_CHECK_EQUAL (active.size (), 2);
+  BOOST_CHECK_EQUAL (active (0), 0);
+  BOOST_CHECK_EQUAL (active (1), 2);
+  BOOST_CHECK_EQUAL (f.feature.jacobianSOUT (1).rows (), 2);
+  BOOST_CHECK_EQUAL (f.feature.dimensionSOUT (1), 2u);
+}
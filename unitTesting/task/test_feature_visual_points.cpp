@@ -0,0 +1,131 @@
+// Copyright 2026, sot-core contributors.
+//
+// This file is part of sot-core.
+// sot-core is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// sot-core is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public License
+// along with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+
+#define BOOST_TEST_MODULE feature_visual_points
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <sot/core/feature-visual-points.hh>
+#include <sot/core/exception-feature.hh>
+
+using namespace dynamicgraph::sot;
+namespace dg = dynamicgraph;
+
+/* Image coordinates of the points P (one per row, in the camera frame)
+   after the camera moved by eps times the twist (v,w). */
+static dg::Matrix project( const dg::Matrix& P,const dg::Vector& twist,
+			   const double& eps )
+{
+  const Eigen::Vector3d v = twist.head<3> (),w = twist.tail<3> ();
+  dg::Matrix xy (P.rows (), 2);
+  for( dg::Matrix::Index i=0;i<P.rows ();++i )
+    {
+      const Eigen::Vector3d p = P.row (i).transpose ();
+      const Eigen::Vector3d q = p - eps*(v + w.cross (p));
+      xy (i, 0) = q (0)/q (2);
+      xy (i, 1) = q (1)/q (2);
+    }
+  return xy;
+}
+
+struct Fixture
+{
+  FeatureVisualPoints s,sdes;
+  dg::Matrix P,xy,Jq;
+  dg::Vector Z;
+
+  /* Features are registered in the pool, hence one name per test. */
+  Fixture (const std::string& name)
+    : s (name), sdes (name+"_des"), P (4, 3), Jq (6, 5)
+  {
+    P << .1, -.2, 1.,
+         -.3, .25, 1.5,
+         .4, .1, 2.,
+         0., -.5, .8;
+    Z = P.col (2);
+    xy = project (P, dg::Vector::Zero (6), 0.);
+    Jq << 1., 0., .2, 0., .1,
+          0., 1., 0., .3, 0.,
+          .2, 0., 1., 0., -.4,
+          0., .5, 0., 1., 0.,
+          -.1, 0., .3, 0., 1.,
+          0., .2, 0., -.6, .7;
+    s.xySIN = xy;
+    s.ZSIN = Z;
+    s.articularJacobianSIN = Jq;
+    s.selectionSIN = Flags (true);
+    sdes.xySIN = dg::Matrix::Zero (4, 2);
+    s.setReference (&sdes);
+  }
+
+  /* Central differences of the coordinates of the selected points, for
+     a motion of the camera along the column j of Jq. */
+  dg::Vector finiteDifference( const dg::Matrix::Index j,const Flags& fl )
+  {
+    const double eps = 1e-6;
+    const dg::Matrix d = (project (P, Jq.col (j), eps)
+			  - project (P, Jq.col (j), -eps))/(2*eps);
+    dg::Vector res (2*P.rows ());
+    dg::Matrix::Index cursor = 0;
+    for( dg::Matrix::Index i=0;i<P.rows ();++i )
+      if( fl (static_cast<int> (i)) )
+	{ res (cursor++) = d (i, 0); res (cursor++) = d (i, 1); }
+    return res.head (cursor);
+  }
+};
+
+BOOST_AUTO_TEST_CASE (jacobian)
+{
+  Fixture f ("jacobian");
+  const dg::Matrix& J = f.s.jacobianSOUT (1);
+  BOOST_CHECK_EQUAL (J.rows (), 8);
+  BOOST_CHECK_EQUAL (J.cols (), 5);
+  for( dg::Matrix::Index j=0;j<J.cols ();++j )
+    BOOST_CHECK_SMALL ((J.col (j) - f.finiteDifference (j, Flags (true))).norm (),
+		       1e-6);
+  BOOST_CHECK (f.s.errorSOUT (1).isApprox
+	       (Eigen::Map<const dg::Vector> (dg::Matrix (f.xy.transpose ()).data (), 8)));
+}
+
+BOOST_AUTO_TEST_CASE (selection)
+{
+  Fixture f ("selection");
+  Flags fl (true); fl.unset (1);
+  f.s.selectionSIN = fl;
+
+  const dg::Matrix& J = f.s.jacobianSOUT (1);
+  BOOST_CHECK_EQUAL (J.rows (), 6);
+  for( dg::Matrix::Index j=0;j<J.cols ();++j )
+    BOOST_CHECK_SMALL ((J.col (j) - f.finiteDifference (j, fl)).norm (), 1e-6);
+
+  const dg::Vector& e = f.s.errorSOUT (1);
+  BOOST_CHECK_EQUAL (e.size (), 6);
+  BOOST_CHECK_EQUAL (e (2), f.xy (2, 0));
+  BOOST_CHECK_EQUAL (e (3), f.xy (2, 1));
+}
+
+BOOST_AUTO_TEST_CASE (errors)
+{
+  Fixture f ("errors");
+  dg::Vector Z = f.Z; Z (2) = -1.;
+  f.s.ZSIN = Z;
+  BOOST_CHECK_THROW (f.s.jacobianSOUT (1), ExceptionFeature);
+  f.s.ZSIN = dg::Vector (f.Z.head (3));
+  BOOST_CHECK_THROW (f.s.jacobianSOUT (2), ExceptionFeature);
+  f.sdes.xySIN = dg::Matrix::Zero (3, 2);
+  BOOST_CHECK_THROW (f.s.errorSOUT (2), ExceptionFeature);
+}
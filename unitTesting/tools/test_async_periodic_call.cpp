@@ -0,0 +1,84 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <dynamic-graph/all-signals.h>
+#include <sot/core/async-periodic-call.hh>
+
+using namespace dynamicgraph::sot;
+namespace dg = dynamicgraph;
+
+/* Check that the snapshot read by the background thread is consistent. */
+struct Logger
+{
+  AsyncPeriodicCall::VectorSignal* snapshot;
+  int calls,errors;
+
+  Logger( void ) : snapshot(NULL),calls(0),errors(0) {}
+
+  double& fun( double& res,int t )
+  {
+    const dg::Vector& v = snapshot->accessCopy();
+    if( v.size()!=10 || v(0)!=t || v(9)!=t ) ++errors;
+    ++calls;
+    boost::this_thread::sleep( boost::posix_time::microseconds(100) );
+    return res = t;
+  }
+};
+
+BOOST_AUTO_TEST_CASE (snapshots)
+{
+  AsyncPeriodicCall async;
+  AsyncPeriodicCall::VectorSignal source( "source" );
+  Logger logger;
+
+  /* Nothing to do: the thread is not launched, and post returns. */
+  async.start();
+  BOOST_CHECK (! async.isRunning());
+  async.post( 0 );
+  BOOST_CHECK_EQUAL (async.getPostedCount(), 0u);
+
+  logger.snapshot = &async.addSnapshot( source,"snapshot" );
+  BOOST_CHECK (async.isRunning());
+  dg::SignalTimeDependent<double,int>
+    log( boost::bind(&Logger::fun,&logger,_1,_2),*logger.snapshot,"log" );
+  /* The thread is stopped while the periodic call changes. */
+  async.addSignal( "log",log );
+  BOOST_CHECK (async.isRunning());
+
+  /* Post faster than the logger: samples are dropped, never queued. */
+  for( int t=1;t<=1000;++t )
+    {
+      source.setConstant( dg::Vector::Constant( 10,t ) );
+      async.post( t );
+      if( 0==t%50 ) boost::this_thread::sleep( boost::posix_time::milliseconds(1) );
+    }
+  async.stop();
+
+  BOOST_CHECK_EQUAL (async.getPostedCount(), 1000u);
+  BOOST_CHECK_EQUAL (async.getProcessedCount()+async.getDroppedCount(), 1000u);
+  BOOST_CHECK (async.getProcessedCount() > 0);
+  BOOST_CHECK_EQUAL (logger.calls, (int)async.getProcessedCount());
+  BOOST_CHECK_EQUAL (logger.errors, 0);
+
+  /* Stopped, post returns at once. */
+  async.resetCounters();
+  async.post( 1001 );
+  BOOST_CHECK_EQUAL (async.getPostedCount(), 0u);
+}
@@ -0,0 +1,106 @@
+// Copyright 2026, sot-core contributors.
+//
+// This file is part of sot-core.
+// sot-core is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// sot-core is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public License
+// along with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cmath>
+#include <complex>
+
+#define BOOST_TEST_MODULE biquad_cascade
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <sot/core/biquad-cascade.hh>
+
+using dynamicgraph::Vector;
+using dynamicgraph::Matrix;
+using dynamicgraph::sot::BiquadCascade;
+
+/* Gain of the sections at the frequency f (Hz). */
+static double gain( const Matrix& sos,const double& f,const double& T )
+{
+  const std::complex<double> z1 = std::polar( 1.,-2.*M_PI*f*T );
+  const std::complex<double> z2 = z1*z1;
+  std::complex<double> H = 1.;
+  for( Matrix::Index s=0;s<sos.rows();++s )
+    H *= ( sos( s,0 )+sos( s,1 )*z1+sos( s,2 )*z2 )
+      /( sos( s,3 )+sos( s,4 )*z1+sos( s,5 )*z2 );
+  return std::abs( H );
+}
+
+BOOST_AUTO_TEST_CASE (butterworth)
+{
+  const double T = 1e-3,fc = 20.;
+  for( int order=1;order<=5;++order )
+    {
+      const Matrix lp = BiquadCascade::butterworthLowPass( order,fc,T );
+      BOOST_CHECK_EQUAL( lp.rows(),( order+1 )/2 );
+      BOOST_CHECK_CLOSE( gain( lp,0.,T ),1.,1e-9 );
+      BOOST_CHECK_CLOSE( gain( lp,fc,T ),std::sqrt( .5 ),1e-6 );
+      BOOST_CHECK_SMALL( gain( lp,.5/T,T ),1e-9 );
+
+      const Matrix hp = BiquadCascade::butterworthHighPass( order,fc,T );
+      BOOST_CHECK_SMALL( gain( hp,0.,T ),1e-9 );
+      BOOST_CHECK_CLOSE( gain( hp,fc,T ),std::sqrt( .5 ),1e-6 );
+      BOOST_CHECK_CLOSE( gain( hp,.5/T,T ),1.,1e-9 );
+    }
+
+  /* Maximally flat: the gain decreases monotonically. */
+  const Matrix lp = BiquadCascade::butterworthLowPass( 4,fc,T );
+  for( double f=1.;f<100.;f+=1. )
+    BOOST_CHECK( gain( lp,f,T )<gain( lp,f-1.,T ) );
+}
+
+BOOST_AUTO_TEST_CASE (filter)
+{
+  BiquadCascade filter( "filter" );
+  Matrix sos( 2,6 );
+  sos << 2.,.4,.2,2.,-.6,.1,
+    1.,-.5,.3,1.,.2,.05;
+  filter.setSos( sos );
+
+  /* Started on the steady state of the first input. */
+  Vector in( 2 ); in << 1.,-3.;
+  filter.SIN.setConstant( in );
+  filter.SOUT.recompute( 0 );
+  const double g0 = ( 2.+.4+.2 )/( 2.-.6+.1 ),g1 = ( 1.-.5+.3 )/( 1.+.2+.05 );
+  const double dcGain = g0*g1;
+  BOOST_CHECK_CLOSE( filter.SOUT.accessCopy()( 0 ),dcGain,1e-9 );
+  BOOST_CHECK_CLOSE( filter.SOUT.accessCopy()( 1 ),-3.*dcGain,1e-9 );
+
+  /* Same output as the difference equation of each section. */
+  double x[2][3],y[2][3]; // input and output of the sections, x[s][0] = now
+  for( int k=0;k<3;++k )
+    { x[0][k] = 1.; y[0][k] = x[1][k] = g0; y[1][k] = dcGain; }
+  const Matrix normalized = filter.getSos();
+  for( int t=1;t<100;++t )
+    {
+      in << std::sin( .1*t ),-3.;
+      filter.SIN.setConstant( in );
+      filter.SOUT.recompute( t );
+
+      double u = in( 0 );
+      for( int s=0;s<2;++s )
+	{
+	  x[s][2] = x[s][1]; x[s][1] = x[s][0]; x[s][0] = u;
+	  y[s][2] = y[s][1]; y[s][1] = y[s][0];
+	  y[s][0] = normalized( s,0 )*x[s][0]+normalized( s,1 )*x[s][1]
+	    +normalized( s,2 )*x[s][2]-normalized( s,4 )*y[s][1]
+	    -normalized( s,5 )*y[s][2];
+	  u = y[s][0];
+	}
+      BOOST_CHECK_CLOSE( filter.SOUT.accessCopy()( 0 ),u,1e-7 );
+      BOOST_CHECK_CLOSE( filter.SOUT.accessCopy()( 1 ),-3.*dcGain,1e-9 );
+    }
+}
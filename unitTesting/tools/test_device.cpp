@@ -0,0 +1,130 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <sot/core/device.hh>
+
+#include <iostream>
+#include <sstream>
+
+#ifndef WIN32
+#include <sys/time.h>
+#else /*WIN32*/
+#include <sot/core/utils-windows.hh>
+#endif /*WIN32*/
+
+using namespace dynamicgraph::sot;
+namespace dg = dynamicgraph;
+
+/* Cost of a tick of a device with 30 joints and a free flyer, in us. */
+static double tickCost( Device& device,const int nbIter )
+{
+  struct timeval t0,t1;
+  gettimeofday(&t0,NULL);
+  for( int iter=0;iter<nbIter;++iter ) device.increment( 1e-3 );
+  gettimeofday(&t1,NULL);
+  return ( (double)(t1.tv_sec-t0.tv_sec) * 1e6
+	   + (double)(t1.tv_usec-t0.tv_usec) ) / nbIter;
+}
+
+BOOST_AUTO_TEST_CASE (real_time)
+{
+  Device device( "device" );
+  device.setStateSize( 36 );
+  device.setPositionBounds( dg::Vector::Constant( 36,-1 ),
+			    dg::Vector::Constant( 36,1 ) );
+  device.setVelocityBounds( dg::Vector::Constant( 36,-2 ),
+			    dg::Vector::Constant( 36,2 ) );
+  device.setState( dg::Vector::Zero( 36 ) );
+  device.setSanityCheck( true );
+  device.setRealTime( true );
+
+  /* Joint velocities: the joint of DoF 16 goes out of its bounds. */
+  dg::Vector control = dg::Vector::Zero( 30 );
+  control(10) = 100;
+  device.controlSIN.setConstant( control );
+
+  const double rt = tickCost( device,10000 );
+  std::ostringstream os;
+  device.displayBoundViolations( os );
+  BOOST_CHECK (os.str().find( "position, DoF 16: " ) != std::string::npos);
+  BOOST_CHECK (os.str().find( "DoF 15" ) == std::string::npos);
+  BOOST_CHECK (os.str().find( "velocity" ) == std::string::npos);
+  BOOST_CHECK_CLOSE (device.stateSOUT.accessCopy()(16), 1., 1e-9);
+
+  device.resetBoundViolations();
+  os.str( "" );
+  device.displayBoundViolations( os );
+  BOOST_CHECK (os.str().find( "DoF" ) == std::string::npos);
+
+  device.setRealTime( false );
+  const double log = tickCost( device,10000 );
+  std::cout << "Device tick: " << rt << " us (real time), "
+	    << log << " us (logging violations)" << std::endl;
+}
+
+/* Free flyer and 6 joints under a constant acceleration during 1 s.
+ * Return the final state, and the cost of a tick in us. */
+static dg::Vector simulate( const std::string& integrator,const double& dt,
+			    double& cost )
+{
+  std::ostringstream name; name << "device_" << integrator << "_" << dt;
+  Device device( name.str() );
+  device.setStateSize( 12 );
+  device.setSanityCheck( false );
+  device.setSecondOrderIntegration();
+  device.setIntegrator( integrator );
+
+  dg::Vector velocity( 12 );
+  velocity << .1,0,.2, .3,-.2,1, 0,0,0,0,0,0;
+  device.setVelocity( velocity );
+  dg::Vector acceleration( 12 );
+  acceleration << .5,-.3,0, 2,1.5,-1, 1,1,1,1,1,1;
+  device.controlSIN.setConstant( acceleration );
+
+  const int nbIter = static_cast<int>( 1./dt+.5 );
+  struct timeval t0,t1;
+  gettimeofday(&t0,NULL);
+  for( int iter=0;iter<nbIter;++iter ) device.increment( dt );
+  gettimeofday(&t1,NULL);
+  cost = ( (double)(t1.tv_sec-t0.tv_sec) * 1e6
+	   + (double)(t1.tv_usec-t0.tv_usec) ) / nbIter;
+  return device.stateSOUT.accessCopy();
+}
+
+BOOST_AUTO_TEST_CASE (integrators)
+{
+  double cost;
+  const dg::Vector reference = simulate( "rk4",1e-4,cost );
+
+  const char* integrators[] = { "euler","semiImplicitEuler","rk2","rk4" };
+  const double dts[] = { 1e-3,5e-3 };
+  double errors[4][2];
+  for( int i=0;i<4;++i )
+    for( int j=0;j<2;++j )
+      {
+	const dg::Vector state = simulate( integrators[i],dts[j],cost );
+	errors[i][j] = ( state-reference ).norm();
+	std::cout << integrators[i] << ", dt " << dts[j] << ": error "
+		  << errors[i][j] << ", " << cost << " us per tick" << std::endl;
+      }
+
+  /* At 5 ms, rk4 is more accurate than the other schemes at 1 ms. */
+  for( int i=0;i<3;++i ) BOOST_CHECK (errors[3][1] < errors[i][0]);
+  /* The semi-implicit Euler scheme is of order 1 on the joints. */
+  BOOST_CHECK (errors[0][0] < errors[1][0]);
+}
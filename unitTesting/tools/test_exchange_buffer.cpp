@@ -0,0 +1,91 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <sot/core/abstract-sot-external-interface-v2.hh>
+
+using namespace dynamicgraph::sot;
+
+/* Controller copying the joint positions into the control. */
+class Controller: public AbstractSotExternalInterfaceV2
+{
+public:
+  ExchangeBuffer::Handle joints,imu,control;
+  int nbCycles;
+
+  Controller() : nbCycles(0) {}
+
+  void registerSensorsAndControls(ExchangeBuffer & sensors,
+                                  ExchangeBuffer & controls)
+  {
+    joints = sensors.add("joints",4);
+    imu = sensors.add("accelerometer_0",3);
+    control = controls.add("control",4);
+  }
+  void setupSetSensors(const ExchangeBuffer & sensors)
+  { nominalSetSensors(sensors); }
+  void nominalSetSensors(const ExchangeBuffer & sensors)
+  { q = sensors.get(joints); ++nbCycles; }
+  void cleanupSetSensors(const ExchangeBuffer &) {}
+  void getControl(ExchangeBuffer & controls)
+  { controls.get(control) = 2*q; }
+  void setSecondOrderIntegration(void) {}
+  void setNoIntegration(void) {}
+
+private:
+  Eigen::VectorXd q;
+};
+
+BOOST_AUTO_TEST_CASE (handles)
+{
+  ExchangeBuffer buffer;
+  const ExchangeBuffer::Handle a = buffer.add("a",2);
+  const ExchangeBuffer::Handle b = buffer.add("b",3);
+  BOOST_CHECK_EQUAL (buffer.add("a",2), a);
+  BOOST_CHECK_THROW (buffer.add("a",3), std::invalid_argument);
+  BOOST_CHECK_EQUAL (buffer.find("b"), b);
+  BOOST_CHECK_EQUAL (buffer.find("c"), -1);
+  BOOST_CHECK_EQUAL (buffer.size(), 5u);
+
+  /* The blocks are contiguous. */
+  buffer.get(b).setConstant(1.);
+  buffer.get(a) << 3., 4.;
+  BOOST_CHECK_EQUAL (buffer.data()[1], 4.);
+  BOOST_CHECK_EQUAL (buffer.data()[2], 1.);
+}
+
+BOOST_AUTO_TEST_CASE (map_adapter)
+{
+  Controller controller;
+  AbstractSotExternalInterface & robot = controller;
+
+  std::map<std::string,SensorValues> sensors;
+  std::vector<double> q(4);
+  for (std::size_t i = 0; i < q.size(); ++i) q[i] = (double)i;
+  sensors["joints"].setName("joints");
+  sensors["joints"].setValues(q);
+  sensors["unused"].setValues(q);
+
+  robot.setupSetSensors(sensors);
+  robot.nominalSetSensors(sensors);
+  BOOST_CHECK_EQUAL (controller.nbCycles, 2);
+
+  std::map<std::string,ControlValues> controls;
+  robot.getControl(controls);
+  BOOST_REQUIRE_EQUAL (controls["control"].getValues().size(), 4u);
+  BOOST_CHECK_EQUAL (controls["control"].getValues()[3], 6.);
+}
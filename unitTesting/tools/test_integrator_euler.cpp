@@ -0,0 +1,163 @@
+// Copyright 2026, sot-core contributors.
+//
+// This file is part of sot-core.
+// sot-core is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// sot-core is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public License
+// along with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cmath>
+#include <vector>
+
+#define BOOST_TEST_MODULE integrator_euler
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <sot/core/integrator-euler.hh>
+
+using dynamicgraph::Vector;
+using dynamicgraph::Matrix;
+using dynamicgraph::sot::IntegratorEuler;
+
+template<class sigT,class coefT>
+struct Integrator : public IntegratorEuler<sigT,coefT>
+{
+  Integrator( const std::vector<coefT>& num,const std::vector<coefT>& den )
+    : IntegratorEuler<sigT,coefT>( "integrator" )
+  {
+    for( std::size_t i=0;i<num.size();++i ) this->pushNumCoef( num[i] );
+    for( std::size_t i=0;i<den.size();++i ) this->pushDenomCoef( den[i] );
+    this->setSamplingPeriod( 1e-3 );
+  }
+  using IntegratorEuler<sigT,coefT>::derivativeSOUT;
+};
+
+/* The explicit scheme the realization reproduces: finite differences of
+   the input, then Euler integration of the highest output derivative. */
+template<class sigT,class coefT>
+struct Reference
+{
+  std::vector<coefT> num,den;
+  std::vector<sigT> in,out;
+  double dt;
+
+  Reference( const std::vector<coefT>& n,const std::vector<coefT>& d,
+             const sigT& x0 )
+    : num( n ),den( d ),in( n.size(),x0 ),out( d.size(),x0 ),dt( 1e-3 ) {}
+
+  const sigT& step( const sigT& x )
+  {
+    sigT previous = in[0];
+    in[0] = x;
+    sigT sum = num[0]*in[0];
+    for( std::size_t i=1;i<num.size();++i )
+      {
+        sigT d = ( in[i-1]-previous )/dt;
+        previous = in[i];
+        in[i] = d;
+        sum += num[i]*in[i];
+      }
+    const std::size_t n = den.size()-1;
+    for( std::size_t i=0;i<n;++i ) sum -= den[i]*out[i];
+    out[n] = sum;
+    for( std::size_t i=n;i-->0; ) out[i] += out[i+1]*dt;
+    return out[0];
+  }
+};
+
+static double distance( const double& a,const double& b ) { return std::fabs( a-b ); }
+static double distance( const Vector& a,const Vector& b ) { return ( a-b ).norm(); }
+
+template<class sigT,class coefT>
+static void compare( const std::vector<coefT>& num,const std::vector<coefT>& den,
+                     std::vector<sigT> inputs )
+{
+  Integrator<sigT,coefT> integrator( num,den );
+  integrator.SIN.setConstant( inputs[0] );
+  integrator.initialize();
+  Reference<sigT,coefT> reference( num,den,inputs[0] );
+
+  for( std::size_t t=0;t<inputs.size();++t )
+    {
+      integrator.SIN.setConstant( inputs[t] );
+      integrator.SOUT.recompute( (int)t );
+      const sigT& expected = reference.step( inputs[t] );
+      BOOST_CHECK_SMALL( distance( integrator.SOUT.accessCopy(),expected ),1e-8 );
+      if( den.size()>1 )
+        {
+          integrator.derivativeSOUT.recompute( (int)t );
+          BOOST_CHECK_SMALL( distance( integrator.derivativeSOUT.accessCopy(),
+                                       reference.out[1] ),1e-6 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE (scalar)
+{
+  std::vector<double> inputs;
+  for( int t=0;t<200;++t ) inputs.push_back( std::sin( .05*t ) );
+
+  /* Integrator, then a damped second order with a derivative input. */
+  compare( std::vector<double>( 1,1. ),std::vector<double>( 2,0. ),inputs );
+  std::vector<double> num,den;
+  num.push_back( 400. ); num.push_back( .5 );
+  den.push_back( 400. ); den.push_back( 28. ); den.push_back( 1. );
+  compare( num,den,inputs );
+}
+
+BOOST_AUTO_TEST_CASE (channels)
+{
+  std::vector<Vector> inputs;
+  for( int t=0;t<200;++t )
+    {
+      Vector x( 3 );
+      x << std::sin( .05*t ),std::cos( .02*t ),1.-.01*t;
+      inputs.push_back( x );
+    }
+  std::vector<double> num,den;
+  num.push_back( 900. ); num.push_back( 3. ); num.push_back( .01 );
+  den.push_back( 900. ); den.push_back( 42. ); den.push_back( 1. );
+  compare( num,den,inputs );
+}
+
+BOOST_AUTO_TEST_CASE (coupled)
+{
+  std::vector<Vector> inputs;
+  for( int t=0;t<200;++t )
+    {
+      Vector x( 2 );
+      x << std::sin( .05*t ),std::cos( .03*t );
+      inputs.push_back( x );
+    }
+  Matrix b0( 2,2 ),a0( 2,2 ),a1( 2,2 );
+  b0 << 100.,10.,0.,100.;
+  a0 << 100.,0.,5.,100.;
+  a1 << 20.,1.,0.,20.;
+  std::vector<Matrix> num( 1,b0 ),den;
+  den.push_back( a0 ); den.push_back( a1 ); den.push_back( Matrix::Identity( 2,2 ) );
+  compare( num,den,inputs );
+}
+
+BOOST_AUTO_TEST_CASE (errors)
+{
+  Integrator<Vector,double> integrator( std::vector<double>( 1,1. ),
+                                        std::vector<double>( 2,0. ) );
+  integrator.SIN.setConstant( Vector::Zero( 3 ) );
+  BOOST_CHECK_THROW( integrator.SOUT.recompute( 0 ),dynamicgraph::ExceptionSignal );
+  integrator.initialize();
+  integrator.SOUT.recompute( 0 );
+  integrator.SIN.setConstant( Vector::Zero( 4 ) );
+  BOOST_CHECK_THROW( integrator.SOUT.recompute( 1 ),dynamicgraph::ExceptionSignal );
+
+  Integrator<Vector,double> empty( std::vector<double>(),std::vector<double>( 2,0. ) );
+  empty.SIN.setConstant( Vector::Zero( 3 ) );
+  BOOST_CHECK_THROW( empty.initialize(),dynamicgraph::ExceptionSignal );
+}
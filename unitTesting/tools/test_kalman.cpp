@@ -0,0 +1,281 @@
+// Copyright 2026, sot-core contributors.
+//
+// This file is part of sot-core.
+// sot-core is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// sot-core is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public License
+// along with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <sys/time.h>
+
+#define BOOST_TEST_MODULE kalman
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <sot/core/kalman.hh>
+#include <sot/core/exception-tools.hh>
+
+using dynamicgraph::Vector;
+using dynamicgraph::Matrix;
+using dynamicgraph::sot::Kalman;
+
+/* The inputs of the model are set again at each update, as a graph
+   refreshes them at each tick: otherwise, the variance is not updated. */
+struct Filter : public Kalman
+{
+  Matrix F,Q,H,R;
+
+  Filter( const std::string& name ) : Kalman( name ) {}
+  using Kalman::setStateEstimation;
+  using Kalman::setStateVariance;
+  using Kalman::setSequentialUpdate;
+
+  void setModel( const Matrix& F_,const Matrix& Q_,const Matrix& H_,const Matrix& R_ )
+  {
+    F = F_; Q = Q_; H = H_; R = R_;
+    const int n = (int)F.rows();
+    setStateEstimation( Vector::Zero( n ) );
+    setStateVariance( Matrix::Identity( n,n ) );
+  }
+
+  const Vector& update( const Vector& x_pred,const Vector& y_pred,
+                        const Vector& y,const int& t )
+  {
+    modelTransitionSIN.setConstant( F );
+    noiseTransitionSIN.setConstant( Q );
+    modelMeasureSIN.setConstant( H );
+    noiseMeasureSIN.setConstant( R );
+    statePredictedSIN.setConstant( x_pred );
+    observationPredictedSIN.setConstant( y_pred );
+    measureSIN.setConstant( y );
+    stateUpdateSOUT.recompute( t );
+    return stateUpdateSOUT.accessCopy();
+  }
+};
+
+/* The former update: explicit inverse of the innovation covariance, and
+   P_{k|k} = P_{k|k-1} - K H P_{k|k-1}. */
+struct Reference
+{
+  Vector x;
+  Matrix P,K;
+
+  void update( const Matrix& F,const Matrix& Q,const Matrix& H,const Matrix& R,
+               const Vector& x_pred,const Vector& y_pred,const Vector& y )
+  {
+    const Matrix Pk_k_1 = F*P*F.transpose()+Q;
+    const Matrix S = H*Pk_k_1*H.transpose()+R;
+    K = Pk_k_1*H.transpose()*S.inverse();
+    P = Pk_k_1-K*H*Pk_k_1;
+    x = x_pred+K*( y-y_pred );
+  }
+};
+
+static double elapsed( const struct timeval& t0,const struct timeval& t1 )
+{
+  return (double)( t1.tv_sec-t0.tv_sec )*1e6 + (double)( t1.tv_usec-t0.tv_usec );
+}
+
+/* A slowly rotating, damped system, observed on its first m coordinates
+   plus a mix of all of them. */
+struct Model
+{
+  Matrix F,Q,H,R;
+  Vector x;
+
+  Model( const int& n,const int& m )
+    : F( Matrix::Identity( n,n ) ),Q( 1e-4*Matrix::Identity( n,n ) ),
+      H( Matrix::Zero( m,n ) ),R( 1e-2*Matrix::Identity( m,m ) ),x( n )
+  {
+    for( int i=0;i+1<n;i+=2 )
+      { F( i,i+1 ) = 1e-3; F( i+1,i ) = -1e-3; }
+    F *= .999;
+    for( int i=0;i<m;++i )
+      {
+        H( i,i%n ) = 1.;
+        H( i,( 3*i+1 )%n ) += .5;
+      }
+    for( int i=0;i<n;++i ) x( i ) = std::cos( (double)i );
+  }
+
+  Vector measure( const int& t ) const
+  {
+    Vector y = H*x;
+    for( int i=0;i<y.size();++i ) y( i ) += .05*std::sin( 12.9898*( t+i ) );
+    return y;
+  }
+};
+
+BOOST_AUTO_TEST_CASE (same_estimate)
+{
+  const int sizes[] = { 2,3,6,9,12 };
+  for( int is=0;is<5;++is )
+    {
+      const int n = sizes[is],m = n/2+1;
+      Model model( n,m );
+      Filter filter( "kalman" );
+      filter.setModel( model.F,model.Q,model.H,model.R );
+
+      Reference reference;
+      reference.x = Vector::Zero( n ); reference.P = Matrix::Identity( n,n );
+      for( int t=1;t<=200;++t )
+        {
+          const Vector x_pred = model.F*filter.stateUpdateSOUT.accessCopy();
+          const Vector y_pred = model.H*x_pred;
+          const Vector y = model.measure( t );
+          filter.update( x_pred,y_pred,y,t );
+          reference.update( model.F,model.Q,model.H,model.R,x_pred,y_pred,y );
+
+          BOOST_CHECK_SMALL( ( filter.stateUpdateSOUT.accessCopy()-reference.x ).norm(),1e-9 );
+          const Matrix& P = filter.varianceUpdateSOUT.accessCopy();
+          BOOST_CHECK_SMALL( ( P-reference.P ).norm(),1e-9 );
+          BOOST_CHECK_SMALL( ( P-P.transpose() ).norm(),1e-12 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE (sequential)
+{
+  const int sizes[] = { 3,5,12 };
+  for( int is=0;is<3;++is )
+    {
+      const int n = sizes[is],m = n+2;
+      Model model( n,m );
+      for( int i=0;i<m;++i ) model.R( i,i ) = 1e-2*( 1.+i );
+      Filter joint( "joint" ),sequential( "sequential" );
+      joint.setModel( model.F,model.Q,model.H,model.R );
+      sequential.setModel( model.F,model.Q,model.H,model.R );
+      sequential.setSequentialUpdate( true );
+
+      for( int t=1;t<=200;++t )
+        {
+          const Vector x_pred = model.F*joint.stateUpdateSOUT.accessCopy();
+          const Vector y_pred = model.H*x_pred;
+          const Vector y = model.measure( t );
+          const Vector& x = joint.update( x_pred,y_pred,y,t );
+          BOOST_CHECK_SMALL( ( sequential.update( x_pred,y_pred,y,t )-x ).norm(),1e-9 );
+          BOOST_CHECK_SMALL( ( sequential.varianceUpdateSOUT.accessCopy()
+                               -joint.varianceUpdateSOUT.accessCopy() ).norm(),1e-9 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE (validity)
+{
+  /* Measures 1 and 4 are missing every other tick: the filter behaves as
+     one without them. */
+  const int n = 6,m = 6;
+  Model model( n,m );
+  Model reduced( n,m-2 );
+  const int kept[] = { 0,2,3,5 };
+  for( int i=0;i<m-2;++i )
+    {
+      reduced.H.row( i ) = model.H.row( kept[i] );
+      reduced.R( i,i ) = model.R( kept[i],kept[i] );
+    }
+
+  for( int mode=0;mode<2;++mode )
+    {
+      Filter filter( "kalman" );
+      filter.setModel( model.F,model.Q,model.H,model.R );
+      filter.setSequentialUpdate( mode==1 );
+      Reference reference;
+      reference.x = Vector::Zero( n ); reference.P = Matrix::Identity( n,n );
+      Vector valid = Vector::Ones( m );
+
+      for( int t=1;t<=100;++t )
+        {
+          const bool missing = ( t%2==0 );
+          valid( 1 ) = valid( 4 ) = missing ? 0. : 1.;
+          filter.measureValiditySIN.setConstant( valid );
+
+          const Vector x_pred = model.F*filter.stateUpdateSOUT.accessCopy();
+          const Vector y_pred = model.H*x_pred;
+          Vector y = model.measure( t );
+          if( missing )
+            {
+              y( 1 ) = y( 4 ) = std::numeric_limits<double>::quiet_NaN();
+              Vector yr( m-2 ),yr_pred( m-2 );
+              for( int i=0;i<m-2;++i )
+                { yr( i ) = y( kept[i] ); yr_pred( i ) = y_pred( kept[i] ); }
+              reference.update( model.F,model.Q,reduced.H,reduced.R,x_pred,yr_pred,yr );
+            }
+          else
+            reference.update( model.F,model.Q,model.H,model.R,x_pred,y_pred,y );
+
+          BOOST_CHECK_SMALL( ( filter.update( x_pred,y_pred,y,t )-reference.x ).norm(),1e-9 );
+          BOOST_CHECK_SMALL( ( filter.varianceUpdateSOUT.accessCopy()-reference.P ).norm(),1e-9 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE (non_positive_noise)
+{
+  /* A negative measure noise makes the innovation covariance indefinite:
+     both updates refuse it. */
+  const int n = 4,m = 3;
+  Model model( n,m );
+  Matrix R = model.R; R( 1,1 ) = -10.;
+  for( int mode=0;mode<2;++mode )
+    {
+      Filter filter( "kalman" );
+      filter.setModel( model.F,model.Q,model.H,R );
+      filter.setSequentialUpdate( mode==1 );
+      const Vector x_pred = Vector::Zero( n ),y_pred = Vector::Zero( m );
+      BOOST_CHECK_THROW( filter.update( x_pred,y_pred,model.measure( 1 ),1 ),
+                         dynamicgraph::sot::ExceptionTools );
+    }
+}
+
+BOOST_AUTO_TEST_CASE (benchmark)
+{
+  /* One second of estimation at 1 kHz. */
+  const int sizes[] = { 3,6,9,12 };
+  const int nbTicks = 1000;
+  for( int is=0;is<4;++is )
+    {
+      const int n = sizes[is],m = n/2+1;
+      Model model( n,m );
+      const Vector x_pred = Vector::Zero( n ),y_pred = Vector::Zero( m );
+      const Vector y = model.measure( 0 );
+      Filter filter( "kalman" );
+      filter.setModel( model.F,model.Q,model.H,model.R );
+
+      Reference reference;
+      reference.x = Vector::Zero( n ); reference.P = Matrix::Identity( n,n );
+
+      Filter sequential( "sequential" );
+      sequential.setModel( model.F,model.Q,model.H,model.R );
+      sequential.setSequentialUpdate( true );
+
+      struct timeval t0,t1,t2,t3;
+      gettimeofday( &t0,NULL );
+      for( int t=1;t<=nbTicks;++t )
+        reference.update( model.F,model.Q,model.H,model.R,x_pred,y_pred,y );
+      gettimeofday( &t1,NULL );
+      for( int t=1;t<=nbTicks;++t ) filter.update( x_pred,y_pred,y,t );
+      gettimeofday( &t2,NULL );
+      for( int t=1;t<=nbTicks;++t ) sequential.update( x_pred,y_pred,y,t );
+      gettimeofday( &t3,NULL );
+
+      BOOST_CHECK_SMALL( ( filter.varianceUpdateSOUT.accessCopy()-reference.P ).norm(),1e-9 );
+      BOOST_CHECK_SMALL( ( sequential.varianceUpdateSOUT.accessCopy()-reference.P ).norm(),1e-9 );
+      BOOST_CHECK( elapsed( t1,t2 )/nbTicks<1e3 );
+      std::cout << "state " << n << ", measure " << m << ": "
+                << elapsed( t0,t1 )/nbTicks << " us per tick (inverse), "
+                << elapsed( t1,t2 )/nbTicks << " us (LDLT, Joseph form), "
+                << elapsed( t2,t3 )/nbTicks << " us (sequential)"
+                << std::endl;
+    }
+}
@@ -0,0 +1,219 @@
+// Copyright 2026, sot-core contributors.
+//
+// This file is part of sot-core.
+// sot-core is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// sot-core is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public License
+// along with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <vector>
+#include <sys/time.h>
+
+#define BOOST_TEST_MODULE kalman_bank
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <sot/core/kalman-bank.hh>
+#include <sot/core/kalman.hh>
+
+using dynamicgraph::Vector;
+using dynamicgraph::Matrix;
+using dynamicgraph::sot::KalmanBank;
+using dynamicgraph::sot::Kalman;
+
+/* One linear Kalman filter, keeping only the valid measures. */
+struct Reference
+{
+  Vector x;
+  Matrix P;
+
+  void update( const Matrix& F,const Matrix& Q,const Matrix& H,const Matrix& R,
+               const Vector& y,const Vector& valid )
+  {
+    x = F*x;
+    P = F*P*F.transpose()+Q;
+    std::vector<int> rows;
+    for( int i=0;i<y.size();++i ) if( 0.!=valid( i ) ) rows.push_back( i );
+    if( rows.empty() ) return;
+
+    const int m = (int)rows.size();
+    Matrix Hv( m,H.cols() ),Rv = Matrix::Zero( m,m );
+    Vector yv( m );
+    for( int i=0;i<m;++i )
+      {
+        Hv.row( i ) = H.row( rows[i] );
+        Rv( i,i ) = R( rows[i],rows[i] );
+        yv( i ) = y( rows[i] );
+      }
+    const Matrix S = Hv*P*Hv.transpose()+Rv;
+    const Matrix K = P*Hv.transpose()*S.inverse();
+    x += K*( yv-Hv*x );
+    P -= K*Hv*P;
+  }
+};
+
+struct Filter : public Kalman
+{
+  Filter( const std::string& name ) : Kalman( name ) {}
+  using Kalman::setStateEstimation;
+  using Kalman::setStateVariance;
+};
+
+static double elapsed( const struct timeval& t0,const struct timeval& t1 )
+{
+  return (double)( t1.tv_sec-t0.tv_sec )*1e6 + (double)( t1.tv_usec-t0.tv_usec );
+}
+
+/* Constant acceleration model, observing the position and the velocity. */
+static void model( const double& dt,Matrix& F,Matrix& Q,Matrix& H,Matrix& R )
+{
+  F = Matrix::Identity( 3,3 );
+  F( 0,1 ) = F( 1,2 ) = dt; F( 0,2 ) = .5*dt*dt;
+  Q = 1e-6*Matrix::Identity( 3,3 ); Q( 2,2 ) = 1e-2;
+  H = Matrix::Zero( 2,3 ); H( 0,0 ) = 1.; H( 1,1 ) = 1.; H( 1,0 ) = .1;
+  R = Matrix::Zero( 2,2 ); R( 0,0 ) = 1e-4; R( 1,1 ) = 1e-2;
+}
+
+BOOST_AUTO_TEST_CASE (same_estimate)
+{
+  const int nbFilters = 5,n = 3,m = 2;
+  Matrix F,Q,H,R;
+  model( 1e-3,F,Q,H,R );
+  Matrix P0 = Matrix::Identity( n,n ); P0( 0,1 ) = P0( 1,0 ) = .2;
+
+  KalmanBank bank( "bank" );
+  Vector x0( nbFilters*n );
+  for( int i=0;i<x0.size();++i ) x0( i ) = std::cos( (double)i );
+  bank.setInitialState( x0 );
+  bank.setInitialVariance( P0 );
+  bank.modelTransitionSIN.setConstant( F );
+  bank.modelMeasureSIN.setConstant( H );
+  bank.noiseTransitionSIN.setConstant( Q );
+  bank.noiseMeasureSIN.setConstant( R );
+
+  std::vector<Reference> references( nbFilters );
+  for( int f=0;f<nbFilters;++f )
+    { references[f].x = x0.segment( f*n,n ); references[f].P = P0; }
+
+  for( int t=1;t<=300;++t )
+    {
+      /* Filter f misses its measures every f+2 ticks, the velocity of
+         filter 0 is never measured. */
+      Vector y( nbFilters*m ),valid = Vector::Ones( nbFilters*m );
+      for( int f=0;f<nbFilters;++f )
+        {
+          y( f*m ) = std::sin( 1e-2*t*( f+1 ) );
+          y( f*m+1 ) = std::cos( 1e-2*t*( f+1 ) );
+          if( 0==t%( f+2 ) )
+            {
+              valid.segment( f*m,m ).setZero();
+              y.segment( f*m,m ).setConstant( std::numeric_limits<double>::quiet_NaN() );
+            }
+        }
+      valid( 1 ) = 0.;
+      bank.measureSIN.setConstant( y );
+      bank.measureValiditySIN.setConstant( valid );
+      bank.stateUpdateSOUT.recompute( t );
+      bank.varianceUpdateSOUT.recompute( t );
+
+      const Vector& x = bank.stateUpdateSOUT.accessCopy();
+      const Vector& variances = bank.varianceUpdateSOUT.accessCopy();
+      for( int f=0;f<nbFilters;++f )
+        {
+          references[f].update( F,Q,H,R,y.segment( f*m,m ),valid.segment( f*m,m ) );
+          BOOST_CHECK_SMALL( ( x.segment( f*n,n )-references[f].x ).norm(),1e-9 );
+          BOOST_CHECK_SMALL( ( variances.segment( f*n,n )
+                               -references[f].P.diagonal() ).norm(),1e-9 );
+        }
+    }
+  BOOST_CHECK_EQUAL( bank.getNbFilters(),(unsigned int)nbFilters );
+}
+
+BOOST_AUTO_TEST_CASE (benchmark)
+{
+  /* Position and velocity of 30 joints from their encoders, for one
+     second at 1 kHz. */
+  const int nbFilters = 30,n = 2,m = 1,nbTicks = 1000;
+  const double dt = 1e-3;
+  Matrix F = Matrix::Identity( n,n ); F( 0,1 ) = dt;
+  const Matrix Q = 1e-4*Matrix::Identity( n,n );
+  const Matrix H = Matrix::Identity( m,n );
+  const Matrix R = 1e-6*Matrix::Identity( m,m );
+
+  KalmanBank bank( "bank" );
+  bank.setInitialState( Vector::Zero( nbFilters*n ) );
+  bank.setInitialVariance( Matrix::Identity( n,n ) );
+  bank.modelTransitionSIN.setConstant( F );
+  bank.modelMeasureSIN.setConstant( H );
+  bank.noiseTransitionSIN.setConstant( Q );
+  bank.noiseMeasureSIN.setConstant( R );
+
+  /* The same filters, one entity per joint. */
+  std::vector<Filter*> filters;
+  for( int f=0;f<nbFilters;++f )
+    {
+      std::ostringstream name; name << "joint" << f;
+      Filter* filter = new Filter( name.str() );
+      filter->setStateEstimation( Vector::Zero( n ) );
+      filter->setStateVariance( Matrix::Identity( n,n ) );
+      filters.push_back( filter );
+    }
+
+  std::vector<Vector> measures;
+  for( int t=1;t<=nbTicks;++t )
+    {
+      Vector y( nbFilters );
+      for( int f=0;f<nbFilters;++f ) y( f ) = std::sin( 1e-3*t*( f+1 ) );
+      measures.push_back( y );
+    }
+
+  struct timeval t0,t1,t2;
+  gettimeofday( &t0,NULL );
+  Vector y( m ),x_pred( n ),y_pred( m );
+  for( int t=1;t<=nbTicks;++t )
+    for( int f=0;f<nbFilters;++f )
+      {
+        /* The model is set again at each tick, as a graph refreshes its
+           inputs: otherwise, the variance of the filter is not updated. */
+        Filter& filter = *filters[f];
+        filter.modelTransitionSIN.setConstant( F );
+        filter.modelMeasureSIN.setConstant( H );
+        filter.noiseTransitionSIN.setConstant( Q );
+        filter.noiseMeasureSIN.setConstant( R );
+        x_pred.noalias() = F*filter.stateUpdateSOUT.accessCopy();
+        y_pred.noalias() = H*x_pred;
+        y( 0 ) = measures[t-1]( f );
+        filter.statePredictedSIN.setConstant( x_pred );
+        filter.observationPredictedSIN.setConstant( y_pred );
+        filter.measureSIN.setConstant( y );
+        filter.stateUpdateSOUT.recompute( t );
+      }
+  gettimeofday( &t1,NULL );
+  for( int t=1;t<=nbTicks;++t )
+    {
+      bank.measureSIN.setConstant( measures[t-1] );
+      bank.stateUpdateSOUT.recompute( t );
+    }
+  gettimeofday( &t2,NULL );
+
+  const Vector& x = bank.stateUpdateSOUT.accessCopy();
+  for( int f=0;f<nbFilters;++f )
+    BOOST_CHECK_SMALL( ( x.segment( f*n,n )
+                         -filters[f]->stateUpdateSOUT.accessCopy() ).norm(),1e-9 );
+  std::cout << nbFilters << " filters, state " << n << ": "
+            << elapsed( t0,t1 )/nbTicks << " us per tick (one Kalman per joint), "
+            << elapsed( t1,t2 )/nbTicks << " us (KalmanBank)" << std::endl;
+  for( int f=0;f<nbFilters;++f ) delete filters[f];
+}
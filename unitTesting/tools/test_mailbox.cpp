@@ -32,7 +32,9 @@ using namespace std;
 #include <dynamic-graph/entity.h>
 #include <sot/core/feature-abstract.hh>
 #include <sot/core/mailbox-vector.hh>
+#include <sot/core/mailbox-matrix-homogeneous.hh>
 #include <sstream>
+#include <cmath>
 
 using namespace dynamicgraph;
 using namespace dynamicgraph::sot;
@@ -67,5 +69,58 @@ int main( int ,char** )
   boost::thread th( f );
   th.join();
 
+  /* Each post was read: nothing overwritten, no stale read. */
+  Vector vect(25); vect.setZero();
+  if( mailbox->getOverwrittenCount()!=0 || mailbox->getStaleReadCount()!=0 )
+    return 1;
+  mailbox->post( vect );
+  vect(0) = 1.;
+  mailbox->post( vect );
+  Vector res(25);
+  mailbox->getObject( res,2 );
+  mailbox->display( std::cout );
+  if( mailbox->getOverwrittenCount()!=1 || res(0)!=1. )
+    return 1;
+
+  /* History: interpolation at the requested time. */
+  sot::MailboxVector history("history");
+  history.setHistory( 4 );
+  for( int k=0;k<4;++k )
+    { vect.setConstant( 10.*k ); history.post( vect,(double)k ); }
+  history.timeSIN.setConstant( 2.25 );
+  history.interpolatedSOUT.recompute( 1 );
+  if( std::abs( history.interpolatedSOUT.accessCopy()(0)-22.5 )>1e-9 )
+    return 1;
+
+  /* The oldest samples are overwritten, late samples are dropped. */
+  for( int k=4;k<6;++k )
+    { vect.setConstant( 10.*k ); history.post( vect,(double)k ); }
+  history.post( vect,1. );
+  history.timeSIN.setConstant( .5 );
+  history.interpolatedSOUT.recompute( 2 );
+  if( history.interpolatedSOUT.accessCopy()(0)!=20.
+      || history.getHistoryDropCount()!=1 )
+    return 1;
+
+  /* Homogeneous matrices: aligned slots, slerp of the rotation. */
+  sot::MailboxMatrixHomogeneous* poses
+    = new sot::MailboxMatrixHomogeneous("poses");
+  poses->setHistory( 3 );
+  for( int k=0;k<3;++k )
+    {
+      sot::MatrixHomogeneous M( Eigen::AngleAxisd( .4*k,Eigen::Vector3d::UnitZ() ) );
+      M.translation() = Eigen::Vector3d::Constant( k );
+      poses->post( M,(double)k );
+    }
+  poses->timeSIN.setConstant( 1.5 );
+  poses->interpolatedSOUT.recompute( 1 );
+  const sot::MatrixHomogeneous& M = poses->interpolatedSOUT.accessCopy();
+  const sot::MatrixHomogeneous expected
+    ( Eigen::AngleAxisd( .6,Eigen::Vector3d::UnitZ() ) );
+  if(! M.linear().isApprox( expected.linear(),1e-9 )
+     || std::abs( M.translation()(2)-1.5 )>1e-9 )
+    return 1;
+  delete poses;
+
   return 0;
 }
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <boost/bind.hpp>
+
+#include <dynamic-graph/all-signals.h>
+#include <sot/core/periodic-call.hh>
+
+#include <sstream>
+#include <vector>
+#include <sys/time.h>
+
+using namespace dynamicgraph::sot;
+namespace dg = dynamicgraph;
+
+typedef dg::SignalTimeDependent<double,int> SignalDouble;
+
+/* Count the calls of each signal at each time. */
+struct Counter
+{
+  std::vector< std::vector<int> > calls;
+  /* Busy time of each call, in microseconds. */
+  std::vector<double> costs;
+
+  double& fun( const std::size_t id,double& res,int t )
+  {
+    calls[id].push_back( t );
+    if( id<costs.size() ) wait( costs[id] );
+    return res = t;
+  }
+
+  static void wait( const double& us )
+  {
+    struct timeval t0,t1;
+    gettimeofday( &t0,NULL );
+    do gettimeofday( &t1,NULL );
+    while( (double)(t1.tv_sec-t0.tv_sec)*1e6+(double)(t1.tv_usec-t0.tv_usec)<us );
+  }
+};
+
+/* Input of the graph, as the state of the device: a new value at each
+ * tick. */
+struct Clock : public dg::Signal<double,int>
+{
+  Clock( void ) : dg::Signal<double,int>( "clock" ) { setConstant( 0 ); }
+  void tick( const int& t ) { setConstant( t ); setTime( t ); }
+};
+
+BOOST_AUTO_TEST_CASE (phases)
+{
+  Counter counter;
+  counter.calls.resize( 4 );
+  Clock clock;
+  std::vector<SignalDouble*> signals;
+  PeriodicCall pc;
+  for( std::size_t k=0;k<4;++k )
+    {
+      std::ostringstream name; name << "sig" << k;
+      signals.push_back
+	( new SignalDouble( boost::bind(&Counter::fun,&counter,k,_1,_2),
+			    clock,name.str() ) );
+      pc.addDownsampledSignal( name.str(),*signals[k],4 );
+    }
+
+  /* By default, all the signals are called on the same ticks. */
+  for( int t=1;t<=8;++t ) { clock.tick( t ); pc.run( t ); }
+  for( std::size_t k=0;k<4;++k )
+    {
+      BOOST_REQUIRE_EQUAL (counter.calls[k].size(), 2u);
+      BOOST_CHECK_EQUAL (counter.calls[k][0], 4);
+      BOOST_CHECK_EQUAL (counter.calls[k][1], 8);
+    }
+
+  /* Staggered, one signal is called at each tick. */
+  pc.setAutoStagger( true );
+  for( std::size_t k=0;k<4;++k ) counter.calls[k].clear();
+  for( int t=9;t<=16;++t ) { clock.tick( t ); pc.run( t ); }
+  std::vector<int> perTick( 4,0 );
+  for( std::size_t k=0;k<4;++k )
+    {
+      BOOST_REQUIRE_EQUAL (counter.calls[k].size(), 2u);
+      BOOST_CHECK_EQUAL (counter.calls[k][1]-counter.calls[k][0], 4);
+      ++perTick[ counter.calls[k][0]%4 ];
+    }
+  for( std::size_t r=0;r<4;++r ) BOOST_CHECK_EQUAL (perTick[r], 1);
+
+  /* Explicit phase. */
+  pc.setAutoStagger( false );
+  pc.setPhase( "sig0",3 );
+  counter.calls[0].clear();
+  for( int t=17;t<=24;++t ) { clock.tick( t ); pc.run( t ); }
+  BOOST_REQUIRE_EQUAL (counter.calls[0].size(), 2u);
+  BOOST_CHECK_EQUAL (counter.calls[0][0], 19);
+
+  std::ostringstream os;
+  pc.displayStats( os );
+  BOOST_CHECK (os.str().find( "sig3: 6" ) != std::string::npos);
+
+  for( std::size_t k=0;k<4;++k ) delete signals[k];
+}
+
+BOOST_AUTO_TEST_CASE (measured_stagger)
+{
+  /* Three signals at half rate, the first one much heavier. With the
+   * default weights, the heavy one shares its ticks with c. Once measured,
+   * it gets its ticks alone. */
+  Counter counter;
+  counter.calls.resize( 3 );
+  counter.costs.resize( 3,0. );
+  counter.costs[0] = 300.;
+  Clock clock;
+  std::vector<SignalDouble*> signals;
+  PeriodicCall pc;
+  const char* names[] = { "a","b","c" };
+  for( std::size_t k=0;k<3;++k )
+    {
+      signals.push_back
+	( new SignalDouble( boost::bind(&Counter::fun,&counter,k,_1,_2),
+			    clock,names[k] ) );
+      pc.addDownsampledSignal( names[k],*signals[k],2 );
+    }
+  pc.setAutoStagger( true );
+
+  for( int t=1;t<=4;++t ) { clock.tick( t ); pc.run( t ); }
+  BOOST_CHECK_EQUAL (counter.calls[0].back()%2, counter.calls[2].back()%2);
+
+  for( int t=5;t<=20;++t ) { clock.tick( t ); pc.run( t ); }
+  BOOST_CHECK (counter.calls[0].back()%2 != counter.calls[2].back()%2);
+  BOOST_CHECK_EQUAL (counter.calls[1].back()%2, counter.calls[2].back()%2);
+  /* Each signal is still called every other tick after the change. */
+  const std::vector<int>& c = counter.calls[2];
+  BOOST_CHECK_EQUAL (c[c.size()-1]-c[c.size()-2], 2);
+
+  for( std::size_t k=0;k<3;++k ) delete signals[k];
+}
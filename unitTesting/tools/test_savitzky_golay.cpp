@@ -0,0 +1,76 @@
+// Copyright 2026, sot-core contributors.
+//
+// This file is part of sot-core.
+// sot-core is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// sot-core is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public License
+// along with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+
+#define BOOST_TEST_MODULE savitzky_golay
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <sot/core/savitzky-golay.hh>
+
+using dynamicgraph::Vector;
+using dynamicgraph::Matrix;
+using dynamicgraph::sot::SavitzkyGolay;
+
+BOOST_AUTO_TEST_CASE (coefficients)
+{
+  /* Classical centered 5-point quadratic filter. */
+  const Matrix coefs = SavitzkyGolay::coefficients( 5,2,2 );
+  const double smooth[] = { -3./35,12./35,17./35,12./35,-3./35 };
+  const double slope[] = { .2,.1,0.,-.1,-.2 }; // newest sample first
+  const double curvature[] = { 2./7,-1./7,-2./7,-1./7,2./7 };
+  for( int k=0;k<5;++k )
+    {
+      BOOST_CHECK_SMALL( coefs( k,0 )-smooth[k],1e-12 );
+      BOOST_CHECK_SMALL( coefs( k,1 )-slope[k],1e-12 );
+      BOOST_CHECK_SMALL( coefs( k,2 )-curvature[k],1e-12 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE (polynomial)
+{
+  const double dt = 1e-2;
+  SavitzkyGolay filter( "filter" );
+  filter.setWindow( 9,2,0 );
+  filter.timestepSIN = dt;
+
+  /* Quadratic inputs are followed exactly once the window is full. */
+  Vector in( 2 );
+  for( int t=0;t<30;++t )
+    {
+      const double x = t*dt;
+      in << 1.+2.*x+3.*x*x,-x*x;
+      filter.SIN.setConstant( in );
+      filter.valueSOUT.recompute( t );
+      filter.derivativeSOUT.recompute( t );
+      filter.secondDerivativeSOUT.recompute( t );
+      const Vector& value = filter.valueSOUT.accessCopy();
+      const Vector& derivative = filter.derivativeSOUT.accessCopy();
+      const Vector& second = filter.secondDerivativeSOUT.accessCopy();
+
+      if( 0==t )
+	{
+	  BOOST_CHECK_SMALL( value( 0 )-1.,1e-12 );
+	  BOOST_CHECK_SMALL( derivative( 0 ),1e-9 );
+	}
+      if( t<8 ) continue;
+      BOOST_CHECK_SMALL( value( 0 )-in( 0 ),1e-9 );
+      BOOST_CHECK_SMALL( value( 1 )-in( 1 ),1e-9 );
+      BOOST_CHECK_SMALL( derivative( 0 )-( 2.+6.*x ),1e-7 );
+      BOOST_CHECK_SMALL( derivative( 1 )+2.*x,1e-7 );
+      BOOST_CHECK_SMALL( second( 0 )-6.,1e-5 );
+      BOOST_CHECK_SMALL( second( 1 )+2.,1e-5 );
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <sot/core/shm-ring.hh>
+
+#include <sstream>
+#include <unistd.h>
+
+using namespace dynamicgraph::sot;
+
+BOOST_AUTO_TEST_CASE (ring)
+{
+  std::ostringstream name; name << "/sot-test-ring-" << getpid();
+
+  ExchangeBuffer produced;
+  const ExchangeBuffer::Handle joints = produced.add( "joints",3 );
+  produced.add( "imu",6 );
+
+  ShmRing producer,consumer;
+  BOOST_CHECK (! consumer.open( name.str() ));
+  producer.create( name.str(),produced,3 );
+  BOOST_CHECK_EQUAL (producer.getCapacity(), 4u);
+  BOOST_REQUIRE (consumer.open( name.str() ));
+
+  /* The consumer rebuilds the layout of the producer. */
+  ExchangeBuffer consumed;
+  consumer.readLayout( consumed );
+  BOOST_CHECK_EQUAL (consumed.find( "joints" ), joints);
+  BOOST_CHECK_EQUAL (consumed.size(), 9u);
+
+  uint64_t seq;
+  BOOST_CHECK (! consumer.pop( consumed,seq ));
+  for( uint64_t k=0;k<5;++k )
+    {
+      produced.get( joints ).setConstant( (double)k );
+      BOOST_CHECK_EQUAL (producer.push( produced,k ), k<4);
+    }
+  BOOST_CHECK_EQUAL (producer.getOverflowCount(), 1u);
+
+  BOOST_REQUIRE (consumer.pop( consumed,seq ));
+  BOOST_CHECK_EQUAL (seq, 0u);
+  BOOST_REQUIRE (consumer.popLatest( consumed,seq ));
+  BOOST_CHECK_EQUAL (seq, 3u);
+  BOOST_CHECK_EQUAL (consumed.get( joints )(2), 3.);
+  BOOST_CHECK_EQUAL (consumer.getSkippedCount(), 2u);
+  BOOST_CHECK (! consumer.pop( consumed,seq ));
+
+  /* Closing the creator removes the segment. */
+  consumer.close();
+  producer.close();
+  BOOST_CHECK (! consumer.open( name.str() ));
+}
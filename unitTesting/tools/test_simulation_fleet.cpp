@@ -0,0 +1,99 @@
+/*
+ * Copyright 2026, sot-core contributors
+ *
+ * This file is part of sot-core.
+ * sot-core is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ * sot-core is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.  You should
+ * have received a copy of the GNU Lesser General Public License along
+ * with sot-core.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <sot/core/device.hh>
+#include <sot/core/simulation-fleet.hh>
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+using namespace dynamicgraph::sot;
+namespace dg = dynamicgraph;
+
+/* Copies of a device with a free flyer and 3 joints at constant
+   velocities. The control of the copies listed in broken is not set:
+   their first tick throws. */
+struct Copies
+{
+  std::vector<Device*> devices;
+
+  Copies( const std::string& prefix,const int& nbCopies,
+          const std::vector<int>& broken )
+  {
+    for( int k=0;k<nbCopies;++k )
+      {
+        std::ostringstream name; name << prefix << k;
+        Device* device = new Device( name.str() );
+        device->setStateSize( 9 );
+        device->setSanityCheck( false );
+        if( std::find( broken.begin(),broken.end(),k )==broken.end() )
+          device->controlSIN.setConstant( dg::Vector::Constant( 3,k+1. ) );
+        devices.push_back( device );
+      }
+  }
+  ~Copies( void )
+  { for( std::size_t k=0;k<devices.size();++k ) delete devices[k]; }
+};
+
+BOOST_AUTO_TEST_CASE (states)
+{
+  Copies copies( "states",5,std::vector<int>() );
+  SimulationFleet fleet( copies.devices,100,1e-2,0 );
+  fleet.run( 3 );
+
+  BOOST_CHECK_EQUAL( fleet.failures,0u );
+  BOOST_CHECK_EQUAL( fleet.states.rows(),9 );
+  BOOST_CHECK_EQUAL( fleet.states.cols(),5 );
+  for( int k=0;k<5;++k )
+    BOOST_CHECK( fleet.states.col( k ).tail( 3 ).isApprox( dg::Vector::Constant( 3,k+1. ) ) );
+  BOOST_CHECK_EQUAL( fleet.sortedDurations().size(),500u );
+}
+
+BOOST_AUTO_TEST_CASE (failures)
+{
+  std::vector<int> broken; broken.push_back( 1 ); broken.push_back( 3 );
+  Copies copies( "failures",4,broken );
+  SimulationFleet fleet( copies.devices,50,1e-2,0 );
+  fleet.run( 2 );
+
+  BOOST_CHECK_EQUAL( fleet.failures,2u );
+  BOOST_CHECK( !fleet.failed[0] && fleet.failed[1] && !fleet.failed[2] && fleet.failed[3] );
+  BOOST_CHECK( fleet.states.col( 2 ).tail( 3 ).isApprox( dg::Vector::Constant( 3,1.5 ) ) );
+
+  /* Only the ticks of the two valid copies, none of the zero durations of
+     the failed ones. */
+  const std::vector<double> durations = fleet.sortedDurations();
+  BOOST_REQUIRE_EQUAL( durations.size(),100u );
+  BOOST_CHECK( durations.front()>0 );
+  BOOST_CHECK( durations.front()<=SimulationFleet::percentile( durations,.5 ) );
+  BOOST_CHECK( SimulationFleet::percentile( durations,.5 )
+               <=SimulationFleet::percentile( durations,.99 ) );
+  BOOST_CHECK_EQUAL( SimulationFleet::percentile( durations,1. ),durations.back() );
+  BOOST_CHECK_EQUAL( SimulationFleet::percentile( durations,0. ),durations.front() );
+}
+
+BOOST_AUTO_TEST_CASE (percentile)
+{
+  std::vector<double> sorted;
+  for( int i=0;i<=10;++i ) sorted.push_back( i );
+  BOOST_CHECK_EQUAL( SimulationFleet::percentile( sorted,.5 ),5. );
+  BOOST_CHECK_EQUAL( SimulationFleet::percentile( sorted,.9 ),9. );
+  BOOST_CHECK_EQUAL( SimulationFleet::percentile( sorted,.94 ),9. );
+  BOOST_CHECK_EQUAL( SimulationFleet::percentile( sorted,.96 ),10. );
+}